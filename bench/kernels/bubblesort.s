@@ -0,0 +1,32 @@
+; Bubble sort of 128 words, refilled in
+; descending order before every sort so each
+; sort is the worst case. Loops until the
+; instruction limit.
+.text
+    lui s0, 0x10
+    addi s1, zero, 128
+refill:
+    mv t0, s0
+    mv t1, s1
+fill_loop:
+    sw t1, 0(t0)
+    addi t0, t0, 4
+    addi t1, t1, -1
+    bnez t1, fill_loop
+    addi t1, s1, -1
+outer_loop:
+    mv t3, s0
+    addi t2, zero, 0
+inner_loop:
+    lw t4, 0(t3)
+    lw t5, 4(t3)
+    bge t5, t4, no_swap
+    sw t5, 0(t3)
+    sw t4, 4(t3)
+no_swap:
+    addi t3, t3, 4
+    addi t2, t2, 1
+    blt t2, t1, inner_loop
+    addi t1, t1, -1
+    bnez t1, outer_loop
+    j refill
@@ -0,0 +1,48 @@
+; Bitwise CRC-32 (reflected polynomial
+; 0xEDB88320) of a 1 KiB buffer of doublewords
+; 0, 1, 2, ..., read a doubleword at a time.
+; Each result is stored at 0x10400. Loops
+; until the instruction limit.
+.text
+    lui s0, 0x10
+    addi s1, zero, 1024
+    lui s2, 0x76dc4
+    slli s2, s2, 1
+    addi s2, s2, 800
+    lui s3, 0x10
+    slli s3, s3, 16
+    addi s3, s3, -1
+    mv t0, s0
+    add t6, s0, s1
+    addi t1, zero, 0
+fill_loop:
+    sd t1, 0(t0)
+    addi t0, t0, 8
+    addi t1, t1, 1
+    blt t0, t6, fill_loop
+crc_pass:
+    mv a0, s3
+    mv t0, s0
+dword_loop:
+    ld t4, 0(t0)
+    addi t5, zero, 8
+byte_loop:
+    andi t1, t4, 255
+    srli t4, t4, 8
+    xor a0, a0, t1
+    addi t2, zero, 8
+bit_loop:
+    andi t3, a0, 1
+    srli a0, a0, 1
+    beqz t3, bit_next
+    xor a0, a0, s2
+bit_next:
+    addi t2, t2, -1
+    bnez t2, bit_loop
+    addi t5, t5, -1
+    bnez t5, byte_loop
+    addi t0, t0, 8
+    blt t0, t6, dword_loop
+    xor a0, a0, s3
+    sd a0, 0(t6)
+    j crc_pass
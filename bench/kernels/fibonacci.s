@@ -0,0 +1,20 @@
+; Fibonacci numbers modulo 2^64 written to a
+; ring of 512 doublewords, restarted from 0, 1
+; when the ring is full. Loops until the
+; instruction limit.
+.text
+    lui s0, 0x10
+restart:
+    mv t0, s0
+    addi t1, zero, 512
+    addi t2, zero, 0
+    addi t3, zero, 1
+fib_loop:
+    add t4, t2, t3
+    sd t4, 0(t0)
+    mv t2, t3
+    mv t3, t4
+    addi t0, t0, 8
+    addi t1, t1, -1
+    bnez t1, fib_loop
+    j restart
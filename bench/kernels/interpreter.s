@@ -0,0 +1,58 @@
+; Bytecode interpreter with a compare-and-
+; branch dispatch chain. Each bytecode is an
+; {op, arg} doubleword pair.
+; 0 LOADC counter = arg
+; 1 ADD acc += arg
+; 2 XOR acc ^= arg
+; 3 SHR acc >>= arg
+; 4 LOOP if --counter, go to bytecode arg
+; 5 STORE acc to 0x11000, restart
+; The program runs a five-bytecode loop 100
+; times. Loops until the instruction limit.
+.data
+    .dword 0, 100
+    .dword 1, 7
+    .dword 2, 85
+    .dword 3, 1
+    .dword 1, 3
+    .dword 4, 1
+    .dword 5, 0
+.text
+    lui s0, 0x10
+    addi s2, zero, 1
+    addi s3, zero, 2
+    addi s4, zero, 3
+    addi s5, zero, 4
+    lui s7, 0x11
+restart:
+    mv s1, s0
+    addi a0, zero, 0
+dispatch:
+    ld t0, 0(s1)
+    ld t1, 8(s1)
+    addi s1, s1, 16
+    beqz t0, op_loadc
+    beq t0, s2, op_add
+    beq t0, s3, op_xor
+    beq t0, s4, op_shr
+    beq t0, s5, op_loop
+    sd a0, 0(s7)
+    j restart
+op_loadc:
+    mv a1, t1
+    j dispatch
+op_add:
+    add a0, a0, t1
+    j dispatch
+op_xor:
+    xor a0, a0, t1
+    j dispatch
+op_shr:
+    srl a0, a0, t1
+    j dispatch
+op_loop:
+    addi a1, a1, -1
+    beqz a1, dispatch
+    slli t1, t1, 4
+    add s1, s0, t1
+    j dispatch
@@ -0,0 +1,35 @@
+; Walks a circular list of 1024 16-byte nodes
+; {next, value} in which node i links to node
+; (i + 389) mod 1024, so consecutive nodes are
+; far apart in memory. Each walk stores the
+; sum of the values, 523776, at 0x14000. Loops
+; until the instruction limit.
+.text
+    lui s0, 0x10
+    addi s1, zero, 1023
+    addi s2, zero, 389
+    addi t0, zero, 0
+build_loop:
+    slli t1, t0, 4
+    add t1, s0, t1
+    add t2, t0, s2
+    and t2, t2, s1
+    slli t2, t2, 4
+    add t2, s0, t2
+    sd t2, 0(t1)
+    sd t0, 8(t1)
+    addi t0, t0, 1
+    bge s1, t0, build_loop
+    lui s3, 0x14
+walk:
+    mv t0, s0
+    addi t3, zero, 1024
+    addi a0, zero, 0
+walk_loop:
+    ld t1, 8(t0)
+    add a0, a0, t1
+    ld t0, 0(t0)
+    addi t3, t3, -1
+    bnez t3, walk_loop
+    sd a0, 0(s3)
+    j walk
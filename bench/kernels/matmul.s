@@ -0,0 +1,65 @@
+; 16x16 doubleword matrix multiply C = A * B
+; with A[i][j] = i + j and B[i][j] = i xor j;
+; C[0][0] is 1240. The in-tree assembler has
+; no M extension, so products are formed by
+; shift and add. Loops until the instruction
+; limit.
+.text
+    lui s0, 0x10
+    lui s1, 0x11
+    lui s2, 0x12
+    addi s3, zero, 16
+    mv t0, s0
+    mv t1, s1
+    addi t2, zero, 0
+init_row:
+    addi t3, zero, 0
+init_col:
+    add t4, t2, t3
+    sd t4, 0(t0)
+    xor t4, t2, t3
+    sd t4, 0(t1)
+    addi t0, t0, 8
+    addi t1, t1, 8
+    addi t3, t3, 1
+    blt t3, s3, init_col
+    addi t2, t2, 1
+    blt t2, s3, init_row
+multiply:
+    mv a0, s0
+    mv a2, s2
+    addi s4, zero, 0
+row_loop:
+    mv a1, s1
+    addi s5, zero, 0
+col_loop:
+    addi a3, zero, 0
+    mv a4, a0
+    mv a5, a1
+    addi s6, zero, 0
+dot_loop:
+    ld t0, 0(a4)
+    ld t1, 0(a5)
+mul_loop:
+    beqz t1, mul_done
+    andi t2, t1, 1
+    beqz t2, mul_skip
+    add a3, a3, t0
+mul_skip:
+    slli t0, t0, 1
+    srli t1, t1, 1
+    j mul_loop
+mul_done:
+    addi a4, a4, 8
+    addi a5, a5, 128
+    addi s6, s6, 1
+    blt s6, s3, dot_loop
+    sd a3, 0(a2)
+    addi a2, a2, 8
+    addi a1, a1, 8
+    addi s5, s5, 1
+    blt s5, s3, col_loop
+    addi a0, a0, 128
+    addi s4, s4, 1
+    blt s4, s3, row_loop
+    j multiply
@@ -0,0 +1,44 @@
+; Copies 4 KiB from 0x10000 to 0x20000 with
+; doubleword loads and stores unrolled four
+; times, then the first 512 bytes of the copy
+; to 0x30000 a word at a time. Loops until the
+; instruction limit.
+.text
+    lui s0, 0x10
+    lui s1, 0x20
+    lui s2, 0x30
+    lui s3, 0x1
+    mv t0, s0
+    add t2, s0, s3
+    addi t1, zero, 0
+fill_loop:
+    sd t1, 0(t0)
+    addi t0, t0, 8
+    addi t1, t1, 1
+    blt t0, t2, fill_loop
+copy:
+    mv t0, s0
+    mv t1, s1
+    add t2, s0, s3
+dword_loop:
+    ld t3, 0(t0)
+    ld t4, 8(t0)
+    ld t5, 16(t0)
+    ld t6, 24(t0)
+    sd t3, 0(t1)
+    sd t4, 8(t1)
+    sd t5, 16(t1)
+    sd t6, 24(t1)
+    addi t0, t0, 32
+    addi t1, t1, 32
+    blt t0, t2, dword_loop
+    mv t0, s1
+    mv t1, s2
+    addi t2, s1, 512
+word_loop:
+    lw t3, 0(t0)
+    sw t3, 0(t1)
+    addi t0, t0, 4
+    addi t1, t1, 4
+    blt t0, t2, word_loop
+    j copy
@@ -0,0 +1,85 @@
+// Instruction::decode over single classes and over a mix weighted like the
+// dynamic instruction counts of the bench kernels, and RVC expansion
+
+#include "microbench.h"
+#include "encoding.h"
+#include "instruction.h"
+#include "program.h"
+#include <vector>
+
+namespace {
+
+namespace enc = encoding;
+
+std::vector<uint32_t> repeat(std::initializer_list<uint32_t> encodings, size_t count) {
+    std::vector<uint32_t> stream;
+    while (stream.size() < count) {
+        stream.insert(stream.end(), encodings.begin(), encodings.end());
+    }
+    return stream;
+}
+
+// About half ALU, a fifth loads, a tenth stores, a sixth branches and
+// jumps, and a little M, F and A
+std::vector<uint32_t> realisticMix() {
+    return repeat({enc::ADDI, enc::ADD, enc::LD, enc::ADDI, enc::BNE_NOT_TAKEN, enc::SLLI, enc::LW,
+                   enc::SD, enc::ADD, enc::ADDI, enc::LD, enc::BEQ_TAKEN, enc::ADDI, enc::LUI,
+                   enc::SW, enc::ADD, enc::MUL, enc::LD, enc::JAL, enc::ADDI, enc::ADD,
+                   enc::FADD_D, enc::LD, enc::BNE_NOT_TAKEN, enc::ADDI, enc::SD, enc::JALR, enc::ADD,
+                   enc::AMOADD_D, enc::ADDI}, 1024);
+}
+
+void decodeStream(microbench::State& state, const std::vector<uint32_t>& stream) {
+    size_t i = 0;
+    for (auto _ : state) {
+        std::unique_ptr<Instruction> inst = Instruction::decode(stream[i], 4);
+        microbench::doNotOptimize(inst.get());
+        i = (i + 1) % stream.size();
+    }
+}
+
+void BM_DecodeMix(microbench::State& state) {
+    decodeStream(state, realisticMix());
+}
+MICROBENCH(BM_DecodeMix);
+
+void BM_DecodeAlu(microbench::State& state) {
+    decodeStream(state, repeat({enc::ADD, enc::ADDI, enc::SLLI, enc::LUI}, 1024));
+}
+MICROBENCH(BM_DecodeAlu);
+
+void BM_DecodeLoadStore(microbench::State& state) {
+    decodeStream(state, repeat({enc::LW, enc::LD, enc::SW, enc::SD}, 1024));
+}
+MICROBENCH(BM_DecodeLoadStore);
+
+void BM_DecodeBranchJump(microbench::State& state) {
+    decodeStream(state, repeat({enc::BEQ_TAKEN, enc::BNE_NOT_TAKEN, enc::JAL, enc::JALR}, 1024));
+}
+MICROBENCH(BM_DecodeBranchJump);
+
+void BM_DecodeFloat(microbench::State& state) {
+    decodeStream(state, repeat({enc::FADD_D, enc::FMUL_D}, 1024));
+}
+MICROBENCH(BM_DecodeFloat);
+
+void BM_DecodeVector(microbench::State& state) {
+    decodeStream(state, repeat({enc::VSETVLI, enc::VADD_VV}, 1024));
+}
+MICROBENCH(BM_DecodeVector);
+
+// c.addi, c.li, c.lw, c.sw, c.j, c.beqz, c.mv, c.add
+void BM_ExpandCompressed(microbench::State& state) {
+    std::vector<uint16_t> parcels;
+    for (uint32_t parcel : repeat({0x0285, 0x4295, 0x4104, 0xC104, 0xA801, 0xC111, 0x82AA, 0x92AA}, 1024)) {
+        parcels.push_back(static_cast<uint16_t>(parcel));
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        microbench::doNotOptimize(Program::expand(parcels[i]));
+        i = (i + 1) % parcels.size();
+    }
+}
+MICROBENCH(BM_ExpandCompressed);
+
+} // namespace
@@ -0,0 +1,50 @@
+// Instruction encodings for the microbenchmarks
+
+#pragma once
+
+#include <cstdint>
+
+namespace encoding {
+
+inline uint32_t rType(uint32_t funct7, int rs2, int rs1, uint32_t funct3, int rd, uint32_t opcode) {
+    return funct7 << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+inline uint32_t iType(int32_t imm, int rs1, uint32_t funct3, int rd, uint32_t opcode) {
+    return (static_cast<uint32_t>(imm) & 0xFFF) << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+inline uint32_t sType(int32_t imm, int rs2, int rs1, uint32_t funct3, uint32_t opcode) {
+    uint32_t u = static_cast<uint32_t>(imm);
+    return (u >> 5 & 0x7F) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | (u & 0x1F) << 7 | opcode;
+}
+inline uint32_t bType(int32_t offset, int rs2, int rs1, uint32_t funct3) {
+    uint32_t u = static_cast<uint32_t>(offset);
+    return (u >> 12 & 1) << 31 | (u >> 5 & 0x3F) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 |
+           (u >> 1 & 0xF) << 8 | (u >> 11 & 1) << 7 | 0x63;
+}
+inline uint32_t jType(int32_t offset, int rd) {
+    uint32_t u = static_cast<uint32_t>(offset);
+    return (u >> 20 & 1) << 31 | (u >> 1 & 0x3FF) << 21 | (u >> 11 & 1) << 20 | (u >> 12 & 0xFF) << 12 |
+           rd << 7 | 0x6F;
+}
+
+const uint32_t ADD = rType(0x00, 7, 6, 0, 5, 0x33);     // add t0, t1, t2
+const uint32_t ADDI = iType(12, 6, 0, 5, 0x13);         // addi t0, t1, 12
+const uint32_t SLLI = iType(3, 6, 1, 5, 0x13);          // slli t0, t1, 3
+const uint32_t LUI = 0x000102B7;                        // lui t0, 0x10
+const uint32_t MUL = rType(0x01, 7, 6, 0, 5, 0x33);     // mul t0, t1, t2
+const uint32_t DIV = rType(0x01, 7, 6, 4, 5, 0x33);     // div t0, t1, t2
+const uint32_t LW = iType(4, 10, 2, 5, 0x03);           // lw t0, 4(a0)
+const uint32_t LD = iType(8, 10, 3, 5, 0x03);           // ld t0, 8(a0)
+const uint32_t SW = sType(4, 5, 10, 2, 0x23);           // sw t0, 4(a0)
+const uint32_t SD = sType(16, 5, 10, 3, 0x23);          // sd t0, 16(a0)
+const uint32_t BEQ_TAKEN = bType(16, 0, 0, 0);          // beq zero, zero, +16
+const uint32_t BNE_NOT_TAKEN = bType(16, 0, 0, 1);      // bne zero, zero, +16
+const uint32_t JAL = jType(64, 1);                      // jal ra, +64
+const uint32_t JALR = iType(0, 1, 0, 0, 0x67);          // jalr zero, 0(ra)
+const uint32_t FADD_D = rType(0x01, 3, 2, 7, 1, 0x53);  // fadd.d f1, f2, f3
+const uint32_t FMUL_D = rType(0x09, 3, 2, 7, 1, 0x53);  // fmul.d f1, f2, f3
+const uint32_t AMOADD_D = rType(0x00, 7, 10, 3, 5, 0x2F); // amoadd.d t0, t2, (a0)
+const uint32_t VSETVLI = iType(0x18, 0, 7, 5, 0x57);    // vsetvli t0, zero, e64, m1
+const uint32_t VADD_VV = rType(0x01, 2, 3, 0, 1, 0x57); // vadd.vv v1, v2, v3
+
+} // namespace encoding
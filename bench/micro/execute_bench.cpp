@@ -0,0 +1,92 @@
+// Instruction::execute per instruction class on a pre-decoded instruction,
+// and decode plus execute over a mix, which is what the simulator does for
+// every instruction it runs
+
+#include "microbench.h"
+#include "encoding.h"
+#include "instruction.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+namespace enc = encoding;
+
+const uint64_t DATA = 0x10000;
+
+// Operands every benchmark instruction can use: a0 points at data, t1 and
+// t2 hold nonzero values, f2 and f3 hold doubles and ra a return address
+struct Machine {
+    RegisterFile rf;
+    Memory mem;
+
+    Machine() {
+        rf.write(10, DATA);
+        rf.write(6, 123456789);
+        rf.write(7, 987);
+        rf.write(1, 0x100);
+        double a = 1.5, b = 2.25;
+        uint64_t bits;
+        std::memcpy(&bits, &a, sizeof(bits));
+        rf.write(RegisterFile::F0 + 2, bits);
+        std::memcpy(&bits, &b, sizeof(bits));
+        rf.write(RegisterFile::F0 + 3, bits);
+        for (uint64_t offset = 0; offset < 64; offset += 8) {
+            mem.write64(DATA + offset, offset);
+        }
+    }
+};
+
+void executeBenchmark(microbench::State& state, uint32_t machineCode, uint32_t setup = 0) {
+    Machine m;
+    if (setup) {
+        Instruction::decode(setup, 4)->execute(m.rf, m.mem);
+    }
+    std::unique_ptr<Instruction> inst = Instruction::decode(machineCode, 4);
+    for (auto _ : state) {
+        inst->execute(m.rf, m.mem);
+    }
+    microbench::doNotOptimize(m.rf.read(5));
+}
+
+void BM_ExecuteAdd(microbench::State& state) { executeBenchmark(state, enc::ADD); }
+void BM_ExecuteAddi(microbench::State& state) { executeBenchmark(state, enc::ADDI); }
+void BM_ExecuteMul(microbench::State& state) { executeBenchmark(state, enc::MUL); }
+void BM_ExecuteDiv(microbench::State& state) { executeBenchmark(state, enc::DIV); }
+void BM_ExecuteLoad(microbench::State& state) { executeBenchmark(state, enc::LD); }
+void BM_ExecuteStore(microbench::State& state) { executeBenchmark(state, enc::SD); }
+void BM_ExecuteBranchTaken(microbench::State& state) { executeBenchmark(state, enc::BEQ_TAKEN); }
+void BM_ExecuteBranchNotTaken(microbench::State& state) { executeBenchmark(state, enc::BNE_NOT_TAKEN); }
+void BM_ExecuteJal(microbench::State& state) { executeBenchmark(state, enc::JAL); }
+void BM_ExecuteAmo(microbench::State& state) { executeBenchmark(state, enc::AMOADD_D); }
+void BM_ExecuteFloat(microbench::State& state) { executeBenchmark(state, enc::FADD_D); }
+void BM_ExecuteVector(microbench::State& state) { executeBenchmark(state, enc::VADD_VV, enc::VSETVLI); }
+MICROBENCH(BM_ExecuteAdd);
+MICROBENCH(BM_ExecuteAddi);
+MICROBENCH(BM_ExecuteMul);
+MICROBENCH(BM_ExecuteDiv);
+MICROBENCH(BM_ExecuteLoad);
+MICROBENCH(BM_ExecuteStore);
+MICROBENCH(BM_ExecuteBranchTaken);
+MICROBENCH(BM_ExecuteBranchNotTaken);
+MICROBENCH(BM_ExecuteJal);
+MICROBENCH(BM_ExecuteAmo);
+MICROBENCH(BM_ExecuteFloat);
+MICROBENCH(BM_ExecuteVector);
+
+void BM_DecodeExecuteMix(microbench::State& state) {
+    const std::vector<uint32_t> mix = {enc::ADDI, enc::ADD, enc::LD, enc::ADDI, enc::BNE_NOT_TAKEN, enc::SLLI, enc::LW,
+                                       enc::SD, enc::ADD, enc::ADDI, enc::LD, enc::BEQ_TAKEN, enc::ADDI, enc::LUI,
+                                       enc::SW, enc::ADD, enc::MUL, enc::LD, enc::JAL, enc::ADDI};
+    Machine m;
+    size_t i = 0;
+    for (auto _ : state) {
+        Instruction::decode(mix[i], 4)->execute(m.rf, m.mem);
+        m.rf.write(10, DATA); // The mix overwrites t0 only, but keep a0 valid regardless
+        i = i + 1 == mix.size() ? 0 : i + 1;
+    }
+    microbench::doNotOptimize(m.rf.read(5));
+}
+MICROBENCH(BM_DecodeExecuteMix);
+
+} // namespace
@@ -0,0 +1,94 @@
+// Memory reads and writes of each width. Addresses walk a 16 KiB window
+// so accesses cross pages as a program's would. The Watched variants put a
+// watchpoint of the other access type on every page of the window: each
+// access then takes the slow path through the watchpoint map without
+// ever hitting.
+
+#include "microbench.h"
+#include "memory.h"
+
+namespace {
+
+const uint64_t BASE = 0x10000;
+const uint64_t WINDOW = 16 * 1024;
+
+template <int Width>
+uint64_t readAt(const Memory& mem, uint64_t address) {
+    switch (Width) {
+        case 1: return mem.read8(address);
+        case 2: return mem.read16(address);
+        case 4: return mem.read32(address);
+        default: return mem.read64(address);
+    }
+}
+
+template <int Width>
+void writeAt(Memory& mem, uint64_t address, uint64_t value) {
+    switch (Width) {
+        case 1: mem.write8(address, static_cast<uint32_t>(value)); break;
+        case 2: mem.write16(address, static_cast<uint32_t>(value)); break;
+        case 4: mem.write32(address, static_cast<uint32_t>(value)); break;
+        default: mem.write64(address, value); break;
+    }
+}
+
+void watchWindow(Memory& mem, int type) {
+    for (uint64_t page = BASE; page < BASE + WINDOW; page += Memory::PAGE_SIZE) {
+        mem.addWatchpoint(page, 64, type);
+    }
+}
+
+template <int Width, bool Watched>
+void readBenchmark(microbench::State& state) {
+    Memory mem;
+    // Touch the window so reads see private pages, not the zero page
+    for (uint64_t a = BASE; a < BASE + WINDOW; a += 8) {
+        mem.write64(a, a);
+    }
+    if (Watched) {
+        watchWindow(mem, Memory::WATCH_WRITE);
+    }
+    uint64_t offset = 0;
+    for (auto _ : state) {
+        microbench::doNotOptimize(readAt<Width>(mem, BASE + offset));
+        offset = (offset + 8 * Width) & (WINDOW - 1);
+    }
+}
+
+template <int Width, bool Watched>
+void writeBenchmark(microbench::State& state) {
+    Memory mem;
+    if (Watched) {
+        watchWindow(mem, Memory::WATCH_READ);
+    }
+    uint64_t offset = 0;
+    uint64_t value = 0;
+    for (auto _ : state) {
+        writeAt<Width>(mem, BASE + offset, ++value);
+        offset = (offset + 8 * Width) & (WINDOW - 1);
+    }
+    microbench::doNotOptimize(readAt<Width>(mem, BASE));
+}
+
+void BM_MemoryRead8(microbench::State& state) { readBenchmark<1, false>(state); }
+void BM_MemoryRead16(microbench::State& state) { readBenchmark<2, false>(state); }
+void BM_MemoryRead32(microbench::State& state) { readBenchmark<4, false>(state); }
+void BM_MemoryRead64(microbench::State& state) { readBenchmark<8, false>(state); }
+void BM_MemoryWrite8(microbench::State& state) { writeBenchmark<1, false>(state); }
+void BM_MemoryWrite16(microbench::State& state) { writeBenchmark<2, false>(state); }
+void BM_MemoryWrite32(microbench::State& state) { writeBenchmark<4, false>(state); }
+void BM_MemoryWrite64(microbench::State& state) { writeBenchmark<8, false>(state); }
+void BM_MemoryRead64Watched(microbench::State& state) { readBenchmark<8, true>(state); }
+void BM_MemoryWrite64Watched(microbench::State& state) { writeBenchmark<8, true>(state); }
+MICROBENCH(BM_MemoryRead8);
+MICROBENCH(BM_MemoryRead16);
+MICROBENCH(BM_MemoryRead32);
+MICROBENCH(BM_MemoryRead64);
+MICROBENCH(BM_MemoryWrite8);
+MICROBENCH(BM_MemoryWrite16);
+MICROBENCH(BM_MemoryWrite32);
+MICROBENCH(BM_MemoryWrite64);
+MICROBENCH(BM_MemoryRead64Watched);
+MICROBENCH(BM_MemoryWrite64Watched);
+
+} // namespace
@@ -0,0 +1,109 @@
+#include "microbench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace microbench {
+
+namespace {
+
+struct Benchmark {
+    const char* name;
+    Function function;
+};
+
+// Function-local so registration from other translation units' static
+// initializers never sees it unconstructed
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+double timeIterations(Function function, uint64_t iterations) {
+    State state(iterations);
+    auto start = std::chrono::steady_clock::now();
+    function(state);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printUsage() {
+    std::cerr << "Usage: microbench [--filter <substring>] [--min-time <seconds>] [--repetitions <n>] [--list]"
+              << std::endl;
+}
+
+} // namespace
+
+int registerBenchmark(const char* name, Function function) {
+    registry().push_back({name, function});
+    return 0;
+}
+
+} // namespace microbench
+
+int main(int argc, char* argv[]) {
+    using namespace microbench;
+    std::string filter;
+    double minTime = 0.1;
+    int repetitions = 3;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::vector<Benchmark> selected;
+    for (const Benchmark& benchmark : registry()) {
+        if (filter.empty() || std::strstr(benchmark.name, filter.c_str())) {
+            selected.push_back(benchmark);
+        }
+    }
+    std::sort(selected.begin(), selected.end(), [](const Benchmark& a, const Benchmark& b) {
+        return std::strcmp(a.name, b.name) < 0;
+    });
+    if (list) {
+        for (const Benchmark& benchmark : selected) {
+            std::cout << benchmark.name << std::endl;
+        }
+        return 0;
+    }
+
+    std::cout << std::left << std::setw(36) << "benchmark" << std::right << std::setw(14) << "iterations"
+              << std::setw(12) << "ns/iter" << std::setw(10) << "spread" << std::endl;
+    std::cout << std::fixed;
+    for (const Benchmark& benchmark : selected) {
+        // Calibrate: double until one run is long enough to time reliably
+        uint64_t iterations = 1;
+        double seconds = timeIterations(benchmark.function, iterations);
+        while (seconds < minTime && iterations < (1ULL << 40)) {
+            double grow = seconds > 0 ? std::min(10.0, std::max(2.0, 1.2 * minTime / seconds)) : 10.0;
+            iterations = static_cast<uint64_t>(iterations * grow);
+            seconds = timeIterations(benchmark.function, iterations);
+        }
+        double best = seconds, worst = seconds;
+        for (int r = 1; r < repetitions; ++r) {
+            double s = timeIterations(benchmark.function, iterations);
+            best = std::min(best, s);
+            worst = std::max(worst, s);
+        }
+        std::cout << std::left << std::setw(36) << benchmark.name << std::right << std::setw(14) << iterations
+                  << std::setprecision(2) << std::setw(12) << best * 1e9 / iterations << std::setprecision(1)
+                  << std::setw(9) << (worst - best) / best * 100 << "%" << std::endl;
+    }
+    return 0;
+}
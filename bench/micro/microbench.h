@@ -0,0 +1,70 @@
+// Minimal built-in benchmark harness in the style of Google Benchmark:
+//
+//   static void BM_Something(microbench::State& state) {
+//       Setup setup;
+//       for (auto _ : state) {
+//           microbench::doNotOptimize(work(setup));
+//       }
+//   }
+//   MICROBENCH(BM_Something);
+//
+// The runner grows the iteration count until one repetition takes at
+// least the minimum time, then reports the fastest of several repetitions
+// in ns per iteration. Setup before the loop is not timed.
+//
+//   make microbench MICROBENCH_ARGS="--filter Memory --min-time 0.5"
+
+#pragma once
+
+#include <cstdint>
+
+namespace microbench {
+
+class State {
+public:
+    explicit State(uint64_t iterations) : remaining(iterations), total(iterations) {}
+
+    // Range-for support: "for (auto _ : state)" runs the body iterations() times
+    struct Value {};
+    class Iterator {
+    public:
+        explicit Iterator(uint64_t* left) : left(left) {}
+        bool operator!=(const Iterator&) const { return *left != 0; }
+        void operator++() { --*left; }
+        Value operator*() const { return Value(); }
+    private:
+        uint64_t* left;
+    };
+    Iterator begin() { return Iterator(&remaining); }
+    Iterator end() { return Iterator(&remaining); }
+
+    uint64_t iterations() const { return total; }
+
+private:
+    uint64_t remaining;
+    uint64_t total;
+};
+
+// Keeps the compiler from discarding a value or the work producing it
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Forces pending stores to memory before the next iteration reads it
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+typedef void (*Function)(State&);
+
+// Adds a benchmark to the registry; returns a dummy for static initializers
+int registerBenchmark(const char* name, Function function);
+
+} // namespace microbench
+
+#define MICROBENCH_CONCAT2(a, b) a##b
+#define MICROBENCH_CONCAT(a, b) MICROBENCH_CONCAT2(a, b)
+#define MICROBENCH(function) \
+    static int MICROBENCH_CONCAT(microbenchRegistered, __LINE__) = \
+        ::microbench::registerBenchmark(#function, function)
@@ -0,0 +1,53 @@
+// RegisterFile reads and writes of the integer registers, with and without
+// an undo log journaling the old values
+
+#include "microbench.h"
+#include "register_file.h"
+#include "undo_log.h"
+
+namespace {
+
+void BM_RegisterRead(microbench::State& state) {
+    RegisterFile rf;
+    for (int r = 1; r < 32; ++r) {
+        rf.write(r, r);
+    }
+    int reg = 0;
+    uint64_t sum = 0;
+    for (auto _ : state) {
+        sum += rf.read(reg);
+        reg = (reg + 7) & 31;
+    }
+    microbench::doNotOptimize(sum);
+}
+MICROBENCH(BM_RegisterRead);
+
+void BM_RegisterWrite(microbench::State& state) {
+    RegisterFile rf;
+    int reg = 1;
+    uint64_t value = 0;
+    for (auto _ : state) {
+        rf.write(reg, ++value);
+        reg = (reg + 7) & 31;
+    }
+    microbench::doNotOptimize(rf.read(1));
+}
+MICROBENCH(BM_RegisterWrite);
+
+// As the simulator writes with reverse debugging on. The log is a ring, so
+// it never grows past its capacity.
+void BM_RegisterWriteJournaled(microbench::State& state) {
+    RegisterFile rf;
+    UndoLog log(1 << 16);
+    rf.setJournal(&log);
+    int reg = 1;
+    uint64_t value = 0;
+    for (auto _ : state) {
+        rf.write(reg, ++value);
+        reg = (reg + 7) & 31;
+    }
+    microbench::doNotOptimize(rf.read(1));
+}
+MICROBENCH(BM_RegisterWriteJournaled);
+
+} // namespace
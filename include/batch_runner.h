@@ -0,0 +1,24 @@
+#pragma once
+
+// Runs a manifest of independent programs, each in its own Simulator, on a
+// work-stealing thread pool and prints one aggregated result/timing report.
+//
+// Usage: simulator --batch <manifest> [--threads <n>]
+//
+// Manifest: one program (.hex) per line, '#' starts a comment. Paths are
+// relative to the manifest; tests/manifest shows how assembly sources are
+// assembled for it by "make test". After the program come optional
+// key=value fields:
+//   data=<file.s>            data section to load
+//   limit=<instructions>     instruction limit (default 100000000)
+//   status=done|limit|error  expected outcome (default done)
+//   schedule=<harts>,<workers>,<quantum>  run the program on scheduled
+//                            harts instead; limit then applies per hart
+//   x<n>=<value>             expected final register value
+//   x<n>@<hart>=<value>      the same for one of the scheduled harts
+//   mem8|16|32|64@<addr>=<value>  expected final memory value
+// Example:
+//   fib.hex data=fib.s x10=0x37 mem32@0x10004=1
+//
+// Exits with status 1 if any program does not match its expectations.
+int batchMain(int argc, char* argv[]);
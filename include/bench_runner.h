@@ -0,0 +1,15 @@
+#pragma once
+
+// Measures simulator throughput on guest kernels. Each kernel runs in a
+// child process of its own: warm-up runs first, then timed runs, each on a
+// freshly loaded Simulator without reverse debugging and stopped after a
+// fixed number of instructions. Reports guest MIPS and host ns per guest
+// instruction (median of the timed runs, with the spread between the
+// fastest and slowest run) and the peak RSS of the child.
+//
+// Usage: simulator --bench [--instructions <n>] [--warmup <n>] [--repeat <n>] <kernel.hex>...
+//
+// A kernel's data section is read from the .s file of the same name next
+// to its .hex, if there is one. "make bench" assembles bench/kernels/*.s
+// and runs them all.
+int benchMain(int argc, char* argv[]);
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <map>
+#include <tuple>
+#include <vector>
+
+// Exact call-graph profile of a guest run: instruction counts per function,
+// exclusive and inclusive of callees, and per call edge. A function is
+// identified by the instruction index of its entry; ids are handed out on
+// the first call through a flat table indexed like the Program, so calls
+// resolve their callee without a symbol lookup. Costs are measured by the
+// profile's own instruction clock at call and return, so each instruction
+// costs one increment.
+class CallGraph {
+public:
+    // Forgets everything; the root function (entered at instruction 0) is
+    // on the stack with the given name and line
+    void reset(size_t instructions, const std::string& rootName, int rootLine);
+
+    void tick() { ++clock; }
+    // True once a function entered at the instruction index has been added
+    bool knows(size_t entry) const { return functionAt[entry] != 0; }
+    void addFunction(size_t entry, const std::string& name, int line);
+    // A call from the instruction at callSite to the known function entered
+    // at entry
+    void call(size_t callSite, int callSiteLine, size_t entry);
+    void ret();
+
+    uint64_t total() const { return clock; }
+    void report(std::ostream& out) const;
+    // Writes the profile in callgrind format, for KCachegrind and
+    // callgrind_annotate; source is the file that line numbers refer to
+    void writeCallgrind(std::ostream& out, const std::string& source) const;
+
+private:
+    struct Function {
+        std::string name;
+        int line;
+        uint64_t exclusive;
+        uint64_t inclusive;
+        uint64_t calls;
+        int active; // Activations on the stack; recursion counts inclusive once
+    };
+
+    struct Edge {
+        int caller;
+        int callee;
+        int callSiteLine;
+        uint64_t calls;
+        uint64_t inclusive;
+    };
+
+    struct Frame {
+        int function;
+        int edge;         // -1 for the root
+        uint64_t start;   // clock at entry
+        uint64_t children; // Inclusive cost of returned callees
+    };
+
+    // Totals as if every frame still on the stack returned now
+    void settle(std::vector<Function>& functionTotals, std::vector<Edge>& edgeTotals) const;
+
+    std::vector<Function> functions;
+    std::vector<int> functionAt; // Per instruction index: function id + 1, 0 if never called
+    std::vector<Edge> edges;
+    std::map<std::tuple<int, int, size_t>, int> edgeIds; // (caller, callee, call site) -> edge
+    std::vector<Frame> stack;
+    uint64_t clock = 0;
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One executed instruction, or one memory access of it. An instruction
+// with several accesses (vector loads and stores) produces one event per
+// access; only the first carries FLAG_RETIRED.
+struct StreamEvent {
+    enum Flags : uint8_t {
+        FLAG_RETIRED = 1, // First event of an instruction
+        FLAG_STORE = 2,   // The access is a write
+        FLAG_BRANCH = 4,  // Conditional branch
+        FLAG_TAKEN = 8    // Branch taken
+    };
+
+    uint64_t pc;
+    uint64_t address; // Accessed address when size != 0
+    uint64_t value;   // Value loaded or stored
+    uint32_t instruction;
+    uint8_t size;     // Access size in bytes, 0 for no access
+    uint8_t flags;
+};
+
+// An analysis fed from the event stream on its own thread
+class EventConsumer {
+public:
+    virtual ~EventConsumer() {}
+    virtual std::string name() const = 0;
+    virtual void consume(const StreamEvent* events, size_t count) = 0;
+    // Called on the simulator thread once the stream has drained
+    virtual void report(std::ostream& out) const = 0;
+};
+
+// Single-producer single-consumer ring of fixed-size slots. head and tail
+// sit on separate cache lines; each side reads the other's index with
+// acquire and publishes its own with release, so no locks are taken.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) : slots(capacity + 1) {}
+
+    // Producer side: the slot to fill, or nullptr when full
+    T* claim() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t next = t + 1 == slots.size() ? 0 : t + 1;
+        return next == head.load(std::memory_order_acquire) ? nullptr : &slots[t];
+    }
+    void publish() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        tail.store(t + 1 == slots.size() ? 0 : t + 1, std::memory_order_release);
+    }
+
+    // Consumer side: the oldest slot, or nullptr when empty
+    const T* front() const {
+        size_t h = head.load(std::memory_order_relaxed);
+        return h == tail.load(std::memory_order_acquire) ? nullptr : &slots[h];
+    }
+    void pop() {
+        size_t h = head.load(std::memory_order_relaxed);
+        head.store(h + 1 == slots.size() ? 0 : h + 1, std::memory_order_release);
+    }
+
+private:
+    std::vector<T> slots; // One slot stays empty to tell full from empty
+    std::atomic<size_t> head{0};
+    char headPadding[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail{0};
+    char tailPadding[64 - sizeof(std::atomic<size_t>)];
+};
+
+// Publishes batches of events to any number of consumers, each on its own
+// worker thread with its own ring, so they read the same stream in
+// parallel. A consumer whose ring is full either drops the batch or makes
+// the simulator wait, per its policy.
+class EventStream {
+public:
+    static const size_t BATCH_EVENTS = 256;
+    static const size_t DEFAULT_RING_BATCHES = 64;
+
+    enum Policy { DROP, BLOCK };
+
+    EventStream() = default;
+    ~EventStream();
+    EventStream(const EventStream&) = delete;
+    EventStream& operator=(const EventStream&) = delete;
+
+    // Starts a worker for the consumer; it sees events published from now on
+    void addConsumer(std::unique_ptr<EventConsumer> consumer, Policy policy,
+                     size_t ringBatches = DEFAULT_RING_BATCHES);
+    bool empty() const { return consumers.empty(); }
+
+    // Appends one event to the current batch, publishing it when full
+    void push(const StreamEvent& event) {
+        batch.events[batch.count++] = event;
+        if (batch.count == BATCH_EVENTS) {
+            flush();
+        }
+    }
+    // Publishes a partial batch
+    void flush();
+
+    // Per consumer: events published, consumed and dropped, current and
+    // highest lag in events
+    void printStats(std::ostream& out) const;
+    // Flushes, waits for every consumer to drain, prints their reports and
+    // removes them
+    void stop(std::ostream& out);
+
+private:
+    struct Batch {
+        size_t count = 0;
+        StreamEvent events[BATCH_EVENTS];
+    };
+
+    struct Consumer {
+        Consumer(std::unique_ptr<EventConsumer> c, Policy p, size_t ringBatches)
+            : analysis(std::move(c)), policy(p), ring(ringBatches) {}
+
+        std::unique_ptr<EventConsumer> analysis;
+        Policy policy;
+        SpscRing<Batch> ring;
+        std::thread worker;
+        std::atomic<bool> stopping{false};
+        // Written by the producer only
+        uint64_t published = 0;
+        uint64_t dropped = 0;
+        uint64_t maxLag = 0;
+        // Written by the worker only
+        std::atomic<uint64_t> consumed{0};
+    };
+
+    static void run(Consumer& consumer);
+
+    std::vector<std::unique_ptr<Consumer>> consumers;
+    Batch batch;
+};
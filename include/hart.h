@@ -0,0 +1,65 @@
+#pragma once
+
+#include "register_file.h"
+#include "memory.h"
+#include "instruction.h"
+#include "program.h"
+#include "undo_log.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// One hardware thread running the loaded program against shared memory.
+// Each hart has its own registers, pc and decoded-instruction cache, so
+// harts can run on separate host threads; only Memory is shared.
+class Hart {
+public:
+    // Stack space reserved below the common stack top for each hart
+    static const uint64_t STACK_SIZE = 0x200;
+
+    // At reset a0 holds the hart id (mhartid) so guest code can split
+    // work between harts, and sp points at the hart's own stack.
+    Hart(int id, const Program& program, Memory& mem, unsigned vlen = RegisterFile::DEFAULT_VLEN);
+
+    // Runs until the hart leaves the program, faults, has executed
+    // maxInstructions more or yields (WFI, failed SC), and returns the
+    // reason for a yield. Never throws; a fault is kept in error().
+    RegisterFile::Yield run(size_t maxInstructions);
+    void step();
+    // Continues from another executor's state, e.g. a lane leaving a SIMT group
+    void resume(const RegisterFile& regs, uint64_t resumePc, size_t executedSoFar);
+
+    // Deterministic rounds. An isolated hart loads and stores against a
+    // private copy of memory taken by beginRound(), and run() stops before
+    // an atomic with YIELD_ATOMIC. commitRound() publishes the round's
+    // stores to shared memory and then executes the pending atomic there,
+    // so committing harts in id order gives the same memory however the
+    // round was spread over host threads.
+    void setIsolated(bool isolated);
+    void beginRound();
+    void commitRound();
+
+    bool finished() const { return pc >= program.endAddress(); }
+    bool faulted() const { return !fault.empty(); }
+    const std::string& error() const { return fault; }
+    int id() const { return hartId; }
+    const RegisterFile& registers() const { return rf; }
+    size_t instructionCount() const { return executed; }
+
+private:
+    Instruction& fetch();
+    void execute(Memory& target);
+    bool atAtomic();
+
+    int hartId;
+    const Program& program;
+    Memory& mem;
+    RegisterFile rf;
+    std::vector<std::unique_ptr<Instruction>> decoded; // Filled on first execution
+    uint64_t pc; // Byte address, like Simulator::pc
+    size_t executed;
+    std::string fault;
+    std::unique_ptr<Memory> view; // Private memory while isolated
+    std::unique_ptr<UndoLog> viewStores; // Stores to the view since beginRound
+    bool atomicPending;
+};
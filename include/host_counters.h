@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Hardware counters of the host process, read with perf_event_open around
+// a stretch of simulation. Each counter is opened on its own so one the
+// host lacks (LLC misses in many VMs) does not cost the others; counts are
+// scaled up when the kernel had to multiplex them. Without perf support
+// every counter is reported as unavailable.
+class HostCounters {
+public:
+    enum Counter { CYCLES, INSTRUCTIONS, BRANCH_MISSES, LLC_MISSES, COUNTER_COUNT };
+
+    HostCounters();
+    ~HostCounters();
+    HostCounters(const HostCounters&) = delete;
+    HostCounters& operator=(const HostCounters&) = delete;
+
+    // Opens the counters on first use and zeroes them
+    void start();
+    void stop();
+
+    bool available(Counter counter) const { return values[counter] >= 0; }
+    // -1 if the counter could not be opened or did not run
+    int64_t value(Counter counter) const { return values[counter]; }
+    // Why the first counter failed to open, for the report
+    const std::string& error() const { return openError; }
+
+    // Host counts next to the guest instructions of the measured stretch:
+    // guest MIPS, host cycles and instructions per guest instruction
+    void report(std::ostream& out, uint64_t guestInstructions, double seconds) const;
+
+private:
+    void open();
+
+    int fds[COUNTER_COUNT];
+    int64_t values[COUNTER_COUNT];
+    bool opened = false;
+    std::string openError;
+};
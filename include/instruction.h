@@ -6,14 +6,17 @@
 #include <string>
 #include <unordered_map>
 
+// Sign-extends the low bits of value
+int64_t signExtend(uint64_t value, int bits);
+
 // Base class for all instructions
 class Instruction {
 protected:
-    RegisterFile rf;
     uint32_t machineCode;
+    unsigned encodedLength; // 4, or 2 for an instruction expanded from RVC
 
 public:
-    Instruction(uint32_t mc) : machineCode(mc) {}
+    Instruction(uint32_t mc) : machineCode(mc), encodedLength(4) {}
     virtual ~Instruction() = default;
     virtual void execute(RegisterFile& rf, Memory& mem) = 0;
     virtual std::string toString() const = 0;
@@ -22,7 +25,13 @@ public:
     virtual bool isJump() const { return false; } // Default implementation
     virtual uint64_t getJumpAddress(const std::unordered_map<std::string, uint64_t>& labels) const { return 0; }
 
+    // Bytes the instruction occupies: the distance to the next one and the
+    // offset of a link address
+    unsigned length() const { return encodedLength; }
+
     static std::unique_ptr<Instruction> decode(uint32_t machineCode);
+    // Decodes the 32-bit form of an instruction stored in length bytes
+    static std::unique_ptr<Instruction> decode(uint32_t machineCode, unsigned length);
 };
 
 #define DECLARE_INSTRUCTION(name) \
@@ -83,6 +92,121 @@ DECLARE_INSTRUCTION(SLLW)
 DECLARE_INSTRUCTION(SRLW)
 DECLARE_INSTRUCTION(SRAW)
 
+// M extension instructions
+DECLARE_INSTRUCTION(MUL)
+DECLARE_INSTRUCTION(MULH)
+DECLARE_INSTRUCTION(MULHSU)
+DECLARE_INSTRUCTION(MULHU)
+DECLARE_INSTRUCTION(DIV)
+DECLARE_INSTRUCTION(DIVU)
+DECLARE_INSTRUCTION(REM)
+DECLARE_INSTRUCTION(REMU)
+DECLARE_INSTRUCTION(MULW)
+DECLARE_INSTRUCTION(DIVW)
+DECLARE_INSTRUCTION(DIVUW)
+DECLARE_INSTRUCTION(REMW)
+DECLARE_INSTRUCTION(REMUW)
+
+// Zba extension instructions
+DECLARE_INSTRUCTION(ADD_UW)
+DECLARE_INSTRUCTION(SH1ADD)
+DECLARE_INSTRUCTION(SH2ADD)
+DECLARE_INSTRUCTION(SH3ADD)
+DECLARE_INSTRUCTION(SH1ADD_UW)
+DECLARE_INSTRUCTION(SH2ADD_UW)
+DECLARE_INSTRUCTION(SH3ADD_UW)
+DECLARE_INSTRUCTION(SLLI_UW)
+
+// Zbb extension instructions
+DECLARE_INSTRUCTION(ANDN)
+DECLARE_INSTRUCTION(ORN)
+DECLARE_INSTRUCTION(XNOR)
+DECLARE_INSTRUCTION(CLZ)
+DECLARE_INSTRUCTION(CLZW)
+DECLARE_INSTRUCTION(CTZ)
+DECLARE_INSTRUCTION(CTZW)
+DECLARE_INSTRUCTION(CPOP)
+DECLARE_INSTRUCTION(CPOPW)
+DECLARE_INSTRUCTION(MAX)
+DECLARE_INSTRUCTION(MAXU)
+DECLARE_INSTRUCTION(MIN)
+DECLARE_INSTRUCTION(MINU)
+DECLARE_INSTRUCTION(SEXT_B)
+DECLARE_INSTRUCTION(SEXT_H)
+DECLARE_INSTRUCTION(ZEXT_H)
+DECLARE_INSTRUCTION(ROL)
+DECLARE_INSTRUCTION(ROLW)
+DECLARE_INSTRUCTION(ROR)
+DECLARE_INSTRUCTION(RORI)
+DECLARE_INSTRUCTION(RORIW)
+DECLARE_INSTRUCTION(RORW)
+DECLARE_INSTRUCTION(ORC_B)
+DECLARE_INSTRUCTION(REV8)
+
+// F and D extension instructions
+DECLARE_INSTRUCTION(FLW)
+DECLARE_INSTRUCTION(FSW)
+DECLARE_INSTRUCTION(FLD)
+DECLARE_INSTRUCTION(FSD)
+DECLARE_INSTRUCTION(FMADD_S)
+DECLARE_INSTRUCTION(FMSUB_S)
+DECLARE_INSTRUCTION(FNMSUB_S)
+DECLARE_INSTRUCTION(FNMADD_S)
+DECLARE_INSTRUCTION(FADD_S)
+DECLARE_INSTRUCTION(FSUB_S)
+DECLARE_INSTRUCTION(FMUL_S)
+DECLARE_INSTRUCTION(FDIV_S)
+DECLARE_INSTRUCTION(FSQRT_S)
+DECLARE_INSTRUCTION(FSGNJ_S)
+DECLARE_INSTRUCTION(FSGNJN_S)
+DECLARE_INSTRUCTION(FSGNJX_S)
+DECLARE_INSTRUCTION(FMIN_S)
+DECLARE_INSTRUCTION(FMAX_S)
+DECLARE_INSTRUCTION(FEQ_S)
+DECLARE_INSTRUCTION(FLT_S)
+DECLARE_INSTRUCTION(FLE_S)
+DECLARE_INSTRUCTION(FCLASS_S)
+DECLARE_INSTRUCTION(FCVT_W_S)
+DECLARE_INSTRUCTION(FCVT_WU_S)
+DECLARE_INSTRUCTION(FCVT_L_S)
+DECLARE_INSTRUCTION(FCVT_LU_S)
+DECLARE_INSTRUCTION(FCVT_S_W)
+DECLARE_INSTRUCTION(FCVT_S_WU)
+DECLARE_INSTRUCTION(FCVT_S_L)
+DECLARE_INSTRUCTION(FCVT_S_LU)
+DECLARE_INSTRUCTION(FMADD_D)
+DECLARE_INSTRUCTION(FMSUB_D)
+DECLARE_INSTRUCTION(FNMSUB_D)
+DECLARE_INSTRUCTION(FNMADD_D)
+DECLARE_INSTRUCTION(FADD_D)
+DECLARE_INSTRUCTION(FSUB_D)
+DECLARE_INSTRUCTION(FMUL_D)
+DECLARE_INSTRUCTION(FDIV_D)
+DECLARE_INSTRUCTION(FSQRT_D)
+DECLARE_INSTRUCTION(FSGNJ_D)
+DECLARE_INSTRUCTION(FSGNJN_D)
+DECLARE_INSTRUCTION(FSGNJX_D)
+DECLARE_INSTRUCTION(FMIN_D)
+DECLARE_INSTRUCTION(FMAX_D)
+DECLARE_INSTRUCTION(FEQ_D)
+DECLARE_INSTRUCTION(FLT_D)
+DECLARE_INSTRUCTION(FLE_D)
+DECLARE_INSTRUCTION(FCLASS_D)
+DECLARE_INSTRUCTION(FCVT_W_D)
+DECLARE_INSTRUCTION(FCVT_WU_D)
+DECLARE_INSTRUCTION(FCVT_L_D)
+DECLARE_INSTRUCTION(FCVT_LU_D)
+DECLARE_INSTRUCTION(FCVT_D_W)
+DECLARE_INSTRUCTION(FCVT_D_WU)
+DECLARE_INSTRUCTION(FCVT_D_L)
+DECLARE_INSTRUCTION(FCVT_D_LU)
+DECLARE_INSTRUCTION(FCVT_S_D)
+DECLARE_INSTRUCTION(FCVT_D_S)
+DECLARE_INSTRUCTION(FMV_X_W)
+DECLARE_INSTRUCTION(FMV_W_X)
+DECLARE_INSTRUCTION(FMV_X_D)
+DECLARE_INSTRUCTION(FMV_D_X)
+
 // BRANCH instructions
 DECLARE_INSTRUCTION(BEQ)
 DECLARE_INSTRUCTION(BNE)
@@ -103,4 +227,39 @@ DECLARE_INSTRUCTION(LUI)
 // AUIPC instruction
 DECLARE_INSTRUCTION(AUIPC)
 
+// SYSTEM instructions
+DECLARE_INSTRUCTION(WFI)
+
+// Zicsr instructions
+DECLARE_INSTRUCTION(CSRRW)
+DECLARE_INSTRUCTION(CSRRS)
+DECLARE_INSTRUCTION(CSRRC)
+DECLARE_INSTRUCTION(CSRRWI)
+DECLARE_INSTRUCTION(CSRRSI)
+DECLARE_INSTRUCTION(CSRRCI)
+
+// AMO instructions (A extension)
+DECLARE_INSTRUCTION(LR_W)
+DECLARE_INSTRUCTION(SC_W)
+DECLARE_INSTRUCTION(AMOSWAP_W)
+DECLARE_INSTRUCTION(AMOADD_W)
+DECLARE_INSTRUCTION(AMOXOR_W)
+DECLARE_INSTRUCTION(AMOAND_W)
+DECLARE_INSTRUCTION(AMOOR_W)
+DECLARE_INSTRUCTION(AMOMIN_W)
+DECLARE_INSTRUCTION(AMOMAX_W)
+DECLARE_INSTRUCTION(AMOMINU_W)
+DECLARE_INSTRUCTION(AMOMAXU_W)
+DECLARE_INSTRUCTION(LR_D)
+DECLARE_INSTRUCTION(SC_D)
+DECLARE_INSTRUCTION(AMOSWAP_D)
+DECLARE_INSTRUCTION(AMOADD_D)
+DECLARE_INSTRUCTION(AMOXOR_D)
+DECLARE_INSTRUCTION(AMOAND_D)
+DECLARE_INSTRUCTION(AMOOR_D)
+DECLARE_INSTRUCTION(AMOMIN_D)
+DECLARE_INSTRUCTION(AMOMAX_D)
+DECLARE_INSTRUCTION(AMOMINU_D)
+DECLARE_INSTRUCTION(AMOMAXU_D)
+
 #undef DECLARE_INSTRUCTION
\ No newline at end of file
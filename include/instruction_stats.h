@@ -0,0 +1,31 @@
+#pragma once
+
+#include "program.h"
+#include "stats.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Workload statistics of a run: the instruction mix, branches taken and not
+// taken, and loads and stores by access width. Like the Profiler it keeps
+// flat per-instruction counters indexed like the Program, plus how often
+// each instruction left by a jump; everything else is derived from the
+// static instructions when the statistics are registered.
+class InstructionStats {
+public:
+    void reset(size_t instructions) {
+        counts.assign(instructions, 0);
+        jumps.assign(instructions, 0);
+    }
+    // jumped: execution did not fall through to the next instruction
+    void count(size_t index, bool jumped) {
+        ++counts[index];
+        jumps[index] += jumped;
+    }
+
+    void registerStats(StatsRegistry& stats, const Program& program) const;
+
+private:
+    std::vector<uint64_t> counts;
+    std::vector<uint64_t> jumps;
+};
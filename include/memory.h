@@ -1,13 +1,120 @@
 #pragma once
 
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <array>
+#include <memory>
 #include <stdexcept>
 #include <cstdint>
 
+class UndoLog;
+
 class Memory {
+public:
+    static const uint64_t PAGE_SHIFT = 12;
+    static const uint64_t PAGE_SIZE = 1ULL << PAGE_SHIFT;
+    // Aligned so that naturally aligned guest accesses are aligned on the host
+    struct alignas(8) Page : std::array<uint8_t, PAGE_SIZE> {};
+
+    // Saved contents of guest memory. Pages are shared with the live memory
+    // and copied only when one side writes to them, so checkpoints and
+    // snapshots cost one pointer per page until the guest diverges.
+    using Image = std::vector<std::shared_ptr<Page>>;
+
+    // Watchpoint access types, combinable as a bit mask
+    enum WatchType {
+        WATCH_READ = 1,
+        WATCH_WRITE = 2,
+        WATCH_RW = WATCH_READ | WATCH_WRITE
+    };
+
+    struct Watchpoint {
+        uint64_t start;
+        uint64_t length;
+        int type;
+    };
+
+    // A watched access recorded during an instruction, consumed by the simulator
+    struct WatchHit {
+        Watchpoint watchpoint;
+        uint64_t address;
+        int size;
+        bool isWrite;
+        uint64_t oldValue;
+        uint64_t newValue;
+    };
+
+    // A load or store logged for instrumentation plugins
+    struct Access {
+        uint64_t address;
+        int size;
+        bool isWrite;
+        uint64_t value; // Value loaded or stored, zero-extended
+    };
+
+    // Read-modify-write operations of the A extension
+    enum AtomicOp {
+        AMO_SWAP, AMO_ADD, AMO_XOR, AMO_AND, AMO_OR,
+        AMO_MIN, AMO_MAX, AMO_MINU, AMO_MAXU
+    };
+
 private:
-    std::vector<uint8_t> mem;
     static const uint64_t MEM_SIZE = 0x60000; // Adjust size to include stack
+    static const uint64_t PAGE_MASK = PAGE_SIZE - 1;
+
+    Image pages;
+    std::shared_ptr<Page> zeroPage; // Backs every page that was never written
+
+    // One bit per page that overlaps at least one watchpoint, so unwatched
+    // accesses only pay for a bit test. Exact range checks go through the
+    // interval map (keyed by start address) on watched pages only.
+    std::vector<uint64_t> watchedPages;
+    std::map<uint64_t, Watchpoint> watchpoints;
+    uint64_t maxWatchLength;
+    mutable std::vector<WatchHit> pendingHits;
+    // Access logging marks every page as watched, so it shares the
+    // watchpoint slow path and costs nothing while off
+    bool logAccesses;
+    mutable std::vector<Access> accessLog;
+
+    UndoLog* journal; // Receives old values of every write while set
+
+    // LR/SC reservations, keyed by 8-byte granule. Every store to a
+    // reserved granule moves its generation on, and SC stores only if the
+    // generation is still the one LR returned. Stores take the lock only
+    // while some hart holds a reservation.
+    struct Reservation {
+        uint64_t generation;
+        int holders;
+    };
+    static const uint64_t RESERVATION_GRANULE = 8;
+    std::unordered_map<uint64_t, Reservation> reservations;
+    uint64_t nextGeneration;
+    int reservationHolders; // Sum of holders, also read without the lock
+    int reservationLock;
+
+    bool isWatchedPage(uint64_t address, int size) const {
+        uint64_t first = address >> PAGE_SHIFT;
+        uint64_t last = (address + size - 1) >> PAGE_SHIFT;
+        return ((watchedPages[first >> 6] >> (first & 63)) |
+                (watchedPages[last >> 6] >> (last & 63))) & 1;
+    }
+    bool isWatchedRange(uint64_t address, uint64_t size) const;
+    Page& writablePage(uint64_t index);
+    uint64_t load(uint64_t address, int size) const;
+    void store(uint64_t address, int size, uint64_t value);
+    void storeBytes(uint64_t address, int size, uint64_t value);
+    bool hasReservations() const { return __atomic_load_n(&reservationHolders, __ATOMIC_SEQ_CST) != 0; }
+    void lockReservations();
+    void unlockReservations() { __atomic_store_n(&reservationLock, 0, __ATOMIC_RELEASE); }
+    // Called with the lock held
+    void invalidateReservations(uint64_t address, uint64_t size);
+    void dropReservation(uint64_t granule);
+    void checkWatch(uint64_t address, int size, bool isWrite, uint64_t oldValue, uint64_t newValue) const;
+    void rebuildWatchedPages();
+    void checkAtomicAddress(uint64_t address, int size) const;
+    void finishAtomic(uint64_t address, int size, uint64_t oldValue, bool isRead);
 
 public:
     Memory();
@@ -21,7 +128,60 @@ public:
     void write8(uint64_t address, uint32_t value);
     uint32_t read8(uint64_t address) const;
 
+    // count elements of elementSize bytes at consecutive addresses, for
+    // vector loads and stores. Blocks on unwatched pages are copied a page
+    // at a time (a store only while nothing is journaling); otherwise each
+    // element goes through the same checks as a scalar access. Elements
+    // are not single-copy atomic with respect to other harts.
+    void readBlock(uint64_t address, void* dst, uint64_t count, int elementSize) const;
+    void writeBlock(uint64_t address, const void* src, uint64_t count, int elementSize);
+
+    // Atomic accesses take a naturally aligned 4- or 8-byte location and map
+    // to one host atomic instruction (or a compare-and-swap loop for min and
+    // max), so they stay atomic between harts on different host threads.
+    // Values are returned zero-extended from size bytes.
+    uint64_t atomicOp(uint64_t address, int size, AtomicOp op, uint64_t operand);
+    // Loads and reserves the granule holding address; generation is what
+    // storeConditional must be given back
+    uint64_t loadReserved(uint64_t address, int size, uint64_t& generation);
+    // Stores value only if no store reached the granule since the matching
+    // loadReserved, which returned expected. Drops the reservation either way.
+    bool storeConditional(uint64_t address, int size, uint64_t generation, uint64_t expected, uint64_t value);
+    void releaseReservation(uint64_t address);
+
     uint64_t getStackPointer() const {
         return 0x50000; // STACK_START
     }
-};
\ No newline at end of file
+
+    void addWatchpoint(uint64_t address, uint64_t length, int type);
+    bool removeWatchpoint(uint64_t address);
+    const std::map<uint64_t, Watchpoint>& getWatchpoints() const { return watchpoints; }
+    bool takeWatchHit(WatchHit& hit);
+    bool hasWatchHits() const { return !pendingHits.empty(); }
+    void clearWatchHits() { pendingHits.clear(); }
+
+    // Records every access in order until cleared
+    void setAccessLogging(bool enabled);
+    const std::vector<Access>& loggedAccesses() const { return accessLog; }
+    void clearAccessLog() { accessLog.clear(); }
+
+    void setJournal(UndoLog* log) { journal = log; }
+    // Copies every location the journal recorded from this memory into
+    // target and empties the journal, so a private copy of memory can
+    // publish a batch of stores at once
+    void publishJournal(Memory& target);
+    // Writes without watchpoint checks or journaling, used to undo stores
+    void restore(uint64_t address, int size, uint64_t value);
+    Image saveImage() const { return pages; }
+    void restoreImage(const Image& image) { pages = image; }
+    // Shares every page of source; pages already shared are left alone,
+    // so only the pages either side wrote cost a reference count update
+    void shareImage(const Memory& source) { pages = source.pages; }
+    const std::shared_ptr<Page>& getZeroPage() const { return zeroPage; }
+    // Gives this memory its own copy of every shared page. Needed before
+    // harts on several host threads write to it, so no store has to copy.
+    void makePrivate();
+    static uint64_t size() { return MEM_SIZE; }
+    // Bytes in pages that hold any nonzero data
+    uint64_t footprint() const;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Interface for instrumentation plugins. A plugin is a shared object built
+// against this header alone that defines a Plugin subclass and exports it
+// with RVSIM_DECLARE_PLUGIN. When a program is loaded, or the plugin is,
+// the simulator asks it which events it wants for each instruction; an
+// instruction no plugin asked about runs with no callbacks, and memory
+// accesses are only logged while some instruction wants them.
+//
+// Callbacks come from step, run and runQuiet after the instruction has
+// executed; replays for reverse execution and multi-hart runs are not
+// reported.
+
+#define RVSIM_PLUGIN_API_VERSION 1
+
+class Plugin {
+public:
+    enum Event : unsigned {
+        EVENT_INSTRUCTION = 1, // onInstruction
+        EVENT_MEMORY = 2,      // onMemoryAccess for each load and store, in order
+        EVENT_BRANCH = 4,      // onBranch, for conditional branches
+        EVENT_CALL = 8         // onCall and onReturn, as tracked by the shadow call stack
+    };
+
+    struct InstructionInfo {
+        size_t index;      // Position in the program, passed back to the callbacks
+        uint64_t address;
+        uint32_t encoding; // As loaded; compressed parcels are 16 bits
+        uint32_t instruction; // 32-bit form, expanded from a compressed parcel
+        unsigned length;
+        int line;          // Line in the program file
+        std::string disassembly;
+    };
+
+    virtual ~Plugin() {}
+
+    // Returns the events wanted for this instruction, as a mask of Event
+    virtual unsigned instrument(const InstructionInfo& info) = 0;
+
+    virtual void onInstruction(size_t /* index */, uint64_t /* pc */) {}
+    virtual void onMemoryAccess(size_t /* index */, uint64_t /* address */, int /* size */, bool /* isWrite */,
+                                uint64_t /* value */) {}
+    virtual void onBranch(size_t /* index */, uint64_t /* pc */, uint64_t /* target */, bool /* taken */) {}
+    // A tail call is reported as a return followed by a call
+    virtual void onCall(size_t /* index */, uint64_t /* pc */, uint64_t /* target */) {}
+    virtual void onReturn(size_t /* index */, uint64_t /* pc */, uint64_t /* target */) {}
+
+    // Called once when the simulator exits, before the plugin is destroyed
+    virtual void finish() {}
+};
+
+// Defines the entry points the simulator looks up in a plugin. args is the
+// rest of the "plugin load" command line.
+#define RVSIM_DECLARE_PLUGIN(type)                                      \
+    extern "C" {                                                        \
+    int rvsim_plugin_api_version = RVSIM_PLUGIN_API_VERSION;            \
+    Plugin* rvsim_plugin_create(const char* args) { return new type(args); } \
+    }
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "plugin.h"
+#include "program.h"
+#include "memory.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Loads plugins with dlopen and dispatches events to them. translate()
+// asks every plugin which events it wants per instruction and keeps the
+// answers in flat tables indexed like the Program, so dispatching for an
+// uninstrumented instruction is one table read.
+class PluginHost {
+public:
+    PluginHost() = default;
+    ~PluginHost();
+    PluginHost(const PluginHost&) = delete;
+    PluginHost& operator=(const PluginHost&) = delete;
+
+    // Throws if the file cannot be loaded or is not a plugin for this API
+    void load(const std::string& path, const std::string& args, const Program& program);
+    // Calls finish on every plugin and unloads them
+    void unloadAll();
+
+    bool empty() const { return plugins.empty(); }
+    // True if any instruction wants memory events
+    bool wantsMemory() const { return memoryWanted; }
+    void list() const;
+
+    // Asks every plugin about every instruction of the program
+    void translate(const Program& program);
+    unsigned wanted(size_t index) const { return index < combined.size() ? combined[index] : 0; }
+
+    // One executed instruction; accesses are the memory accesses it made
+    struct Executed {
+        size_t index;
+        uint64_t pc;
+        uint64_t nextPc;
+        uint64_t fallThrough;
+        bool isBranch;
+        size_t framesPopped;
+        bool framePushed;
+    };
+    void dispatch(const Executed& executed, const std::vector<Memory::Access>& accesses);
+
+private:
+    struct Loaded {
+        std::string path;
+        void* handle;
+        std::unique_ptr<Plugin> plugin;
+        std::vector<uint8_t> wanted; // Per instruction index
+    };
+
+    void instrument(Loaded& loaded, const Program& program);
+    void combine();
+
+    std::vector<Loaded> plugins;
+    std::vector<uint8_t> combined; // OR of every plugin's wanted table
+    bool memoryWanted = false;
+};
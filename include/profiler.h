@@ -0,0 +1,36 @@
+#pragma once
+
+#include "program.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Execution counts for the instructions of a loaded program. The counters
+// form a flat array indexed like the Program, so counting an instruction is
+// a single increment; the opcode and instruction class histograms are
+// folded from it when a report is printed.
+class Profiler {
+public:
+    void reset(size_t instructions) { counts.assign(instructions, 0); }
+    void count(size_t index) { ++counts[index]; }
+
+    uint64_t total() const;
+    uint64_t countAt(size_t index) const { return counts[index]; }
+
+    // The topN hottest instructions with their line and disassembly,
+    // followed by the opcode and class histograms
+    void report(std::ostream& out, const Program& program, size_t topN) const;
+    // Copies the source file to the listing file with each line prefixed by
+    // the execution count of its instruction, "#####" for one that never
+    // ran and "-" for a line without an instruction
+    void writeListing(const Program& program, const std::string& source, const std::string& listing) const;
+
+    // Mnemonic and class (load, store, branch, ...) of an instruction
+    static std::string mnemonic(uint32_t instruction);
+    static const char* instructionClass(uint32_t instruction);
+
+private:
+    std::vector<uint64_t> counts;
+};
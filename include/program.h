@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The text section of a loaded program. 16-bit compressed (RVC) parcels are
+// expanded to their 32-bit equivalents once, when appended, so executors
+// only ever decode 32-bit instructions. Instructions are found by byte PC;
+// they start on any 2-byte boundary from address 0.
+class Program {
+public:
+    static const size_t NO_INSTRUCTION = SIZE_MAX;
+
+    void clear();
+    // Appends one instruction as written in the hex file. A value that fits
+    // in 16 bits and does not end in 0b11 is a compressed parcel.
+    void append(uint32_t encoding, int line);
+
+    size_t size() const { return code.size(); }
+    bool empty() const { return code.empty(); }
+    uint64_t endAddress() const { return end; }
+
+    uint32_t instruction(size_t index) const { return code[index]; } // Expanded to 32 bits
+    uint32_t encoding(size_t index) const { return encodings[index]; } // As loaded
+    unsigned length(size_t index) const { return lengths[index]; }
+    uint64_t address(size_t index) const { return addresses[index]; }
+    int line(size_t index) const { return lines[index]; }
+
+    // Index of the instruction starting at pc, or NO_INSTRUCTION once pc is
+    // past the end. Throws for a pc inside the program that does not start
+    // an instruction.
+    size_t indexAt(uint64_t pc) const;
+
+    static bool isCompressed(uint32_t encoding) { return encoding <= 0xFFFF && (encoding & 0x3) != 0x3; }
+    // 32-bit form of an RV64C parcel. Reserved and illegal parcels expand
+    // to 0, which the decoder rejects when the instruction is executed.
+    static uint32_t expand(uint16_t parcel);
+
+private:
+    std::vector<uint32_t> code;
+    std::vector<uint32_t> encodings;
+    std::vector<uint8_t> lengths;
+    std::vector<uint64_t> addresses;
+    std::vector<int> lines;
+    std::vector<uint32_t> starts; // Per halfword: instruction index + 1, or 0 inside an instruction
+    uint64_t end = 0;
+};
@@ -2,19 +2,139 @@
 #define REGISTER_FILE_H
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
+class UndoLog;
+
 class RegisterFile {
 public:
     static const int PC = 32;  // Program Counter is treated as the 33rd register
+    // F/D extension state follows, so undo and snapshots cover it too.
+    // Single-precision values are NaN-boxed in the 64-bit registers.
+    static const int F0 = 33;    // f0-f31 are registers F0 to F0 + 31
+    static const int FCSR = 65;  // frm in bits 7:5, fflags in bits 4:0
+    // V extension CSRs. Vector registers are stored after the counters
+    // and journaled as 64-bit words numbered from COUNT.
+    static const int VSTART = 66;
+    static const int VL = 67;
+    static const int VTYPE = 68;
+    // Counter CSRs. mcycle and minstret are kept as offsets from the
+    // retired-instruction count, so they cost nothing per instruction;
+    // the event counters only advance while an mhpmevent selects an event.
+    static const int CYCLE_OFFSET = 69;
+    static const int INSTRET_OFFSET = 70;
+    static const int HPM_COUNTERS = 4;
+    static const int HPMCOUNTER3 = 71;  // mhpmcounter3-6 are registers HPMCOUNTER3 to HPMCOUNTER3 + 3
+    static const int HPMEVENT3 = 75;    // mhpmevent3-6
+    static const int COUNT = 79;
+
+    static const uint64_t VTYPE_VILL = 1ULL << 63;
+    static const unsigned DEFAULT_VLEN = 256;
+    static const unsigned MIN_VLEN = 64;
+    static const unsigned MAX_VLEN = 4096;
+    // Bytes past v31 that host SIMD loads of a register group may touch
+    static const unsigned VECTOR_PADDING = 32;
+
+    // Events an mhpmevent CSR can select
+    enum Event {
+        EVENT_NONE,
+        EVENT_LOAD,         // Loads, including FP, vector and atomic ones
+        EVENT_STORE,        // Stores, including FP, vector and atomic ones
+        EVENT_BRANCH,       // Conditional branches
+        EVENT_BRANCH_TAKEN, // Conditional branches that were taken
+        EVENT_JUMP,         // jal and jalr
+        EVENT_COUNT
+    };
 
-    RegisterFile();
+    explicit RegisterFile(unsigned vlen = DEFAULT_VLEN);
     void write(int reg, uint64_t value);
     uint64_t read(int reg) const;
     void printRegs() const;
+    void printFloatRegs() const;
+    void printVectorRegs() const;
+
+    // VLEN in bits, a power of two from MIN_VLEN to MAX_VLEN. Changing it
+    // clears the vector registers and makes vtype illegal.
+    unsigned vlen() const { return vlenb * 8; }
+    unsigned vlenBytes() const { return vlenb; }
+    void setVectorLength(unsigned bits);
+    // Bytes of v and the registers after it. Reads may run VECTOR_PADDING
+    // bytes past the end of a register group.
+    const uint8_t* vector(int v) const {
+        return reinterpret_cast<const uint8_t*>(regs.data() + COUNT) + v * vlenb;
+    }
+    // Bytes of count registers from v, to be written in place; their old
+    // contents are journaled first
+    uint8_t* writeVector(int v, int count);
+    size_t memoryUsage() const { return regs.capacity() * sizeof(uint64_t); } // Register storage in bytes
+
+    // CSRs by their 12-bit address. Unknown CSRs and writes to read-only
+    // ones throw std::runtime_error. There is no timing model: every
+    // instruction takes one cycle and time counts cycles since reset.
+    uint64_t readCsr(unsigned csr) const;
+    void writeCsr(unsigned csr, uint64_t value);
+    static const char* csrName(unsigned csr); // nullptr for unknown CSRs
+
+    // Instructions retired before the current one, set by the executor
+    // before each instruction; cycle and instret derive from it
+    void setRetired(uint64_t count) { retired = count; }
+    // mhartid
+    void setHartId(int id) { hartId = id; }
+    // True while an mhpmevent selects an event; executors then report each
+    // instruction, with whether it left the sequential path
+    bool countsEvents() const {
+        return (regs[HPMEVENT3] | regs[HPMEVENT3 + 1] | regs[HPMEVENT3 + 2] | regs[HPMEVENT3 + 3]) != 0;
+    }
+    void recordEvents(uint32_t machineCode, bool jumped);
+
+    void setJournal(UndoLog* log) { journal = log; }
+    // Writes without journaling, used to undo register writes
+    void restore(int reg, uint64_t value) { regs[reg] = value; }
+
+    // LR/SC reservation: the address, the value LR read and the
+    // generation Memory::loadReserved handed out for the granule.
+    // takeReservation clears it and returns false if none was held.
+    void setReservation(uint64_t address, uint64_t value, uint64_t generation) {
+        reservationAddress = address;
+        reservationValue = value;
+        reservationGeneration = generation;
+        reservationValid = true;
+    }
+    bool takeReservation(uint64_t& address, uint64_t& value, uint64_t& generation) {
+        bool held = reservationValid;
+        reservationValid = false;
+        address = reservationAddress;
+        value = reservationValue;
+        generation = reservationGeneration;
+        return held;
+    }
+
+    // Set by instructions after which a scheduler should run other harts
+    enum Yield {
+        YIELD_NONE,
+        YIELD_SPIN, // SC lost its reservation; another hart holds the lock
+        YIELD_WFI,
+        YIELD_ATOMIC // An isolated hart stopped before an atomic (see Hart::setIsolated)
+    };
+    void requestYield(Yield reason) { yieldReason = reason; }
+    Yield takeYield() {
+        Yield reason = yieldReason;
+        yieldReason = YIELD_NONE;
+        return reason;
+    }
 
 private:
-    std::vector<uint64_t> regs;
+    std::vector<uint64_t> regs; // COUNT scalar registers, then v0-v31 and padding
+    unsigned vlenb;
+    uint64_t retired;
+    int hartId;
+    UndoLog* journal; // Receives old values of every write while set
+    uint64_t reservationAddress;
+    uint64_t reservationValue;
+    uint64_t reservationGeneration;
+    bool reservationValid;
+    Yield yieldReason;
 };
 
 #endif // REGISTER_FILE_H
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+// Fork-per-job execution server. The program is loaded (and optionally
+// warmed up) once; every job connecting on the Unix socket is served by a
+// forked child that shares the warm state copy-on-write, patches its input
+// data into memory, runs to completion and replies with the final state.
+//
+// Usage: simulator --server <socket> (<program.hex> [data.s] | --snapshot <file>) [--warm <instructions>]
+//
+// Request, one command per line, ended by "run":
+//   .byte|.half|.word|.dword <addr> <value>...   store values starting at addr
+//   limit <instructions>                        stop after this many instructions
+//   dump <addr> <count>                         include memory bytes in the reply
+//   run
+// Reply: "status done|limit|error <message>", "instructions <n>",
+// "setup_us <n>", "run_us <n>", "x<i> <hex>" for every register,
+// "mem <addr> <hex bytes>" per dump, then "end".
+int serverMain(int argc, char* argv[]);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "register_file.h"
+#include "memory.h"
+#include "instruction.h"
+#include "program.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Runs up to MAX_LANES copies of one program in lockstep, each against its
+// own Memory (its own data section). Registers are kept as structure of
+// arrays, so each instruction is decoded once and executed for all lanes
+// together; integer ALU instructions use AVX2 when the host supports it.
+// Loads and stores go to each lane's memory. Lanes that a branch sends
+// against the majority, or a JALR away from the first active lane, leave
+// the group and finish on the scalar Hart path.
+class SimtGroup {
+public:
+    static const int MAX_LANES = 16;
+
+    struct LaneResult {
+        RegisterFile registers;
+        size_t instructions;
+        bool finished;
+        bool splitOff; // Left lockstep and finished on the scalar path
+        std::string error;
+    };
+
+    SimtGroup(const Program& program, const std::vector<Memory*>& laneMemory);
+
+    // Runs every lane until it leaves the program, faults or has executed
+    // maxInstructions. Never throws; faults end up in the lane's result.
+    void run(size_t maxInstructions);
+
+    int lanes() const { return laneCount; }
+    const LaneResult& result(int lane) const { return results[lane]; }
+    size_t lockstepInstructions() const { return executed; }
+    static bool hasAvx2();
+
+private:
+    enum Kind { ALU, ALU_IMM, LUI, LOAD, STORE, BRANCH, JAL, JALR, OTHER };
+
+    struct Op {
+        Kind kind;
+        int function; // ALU operation, access size or branch condition
+        int rd, rs1, rs2;
+        int64_t imm;
+        unsigned length; // Bytes to the next instruction
+        std::unique_ptr<Instruction> scalar; // Executed lane by lane for OTHER
+    };
+
+    void executeAlu(int function, int rd, const uint64_t* a, const uint64_t* b);
+    void executeLoad(const Op& op);
+    void executeStore(const Op& op);
+    void executeBranch(const Op& op);
+    void executeJalr(const Op& op);
+    void executeScalar(const Op& op);
+    RegisterFile laneState(int lane) const;
+    void retire(int lane, const std::string& error);
+    void splitOff(int lane, uint64_t nextPc, size_t maxInstructions);
+
+    const Program& program;
+    std::vector<Memory*> memory;
+    int laneCount;
+    int vectorWidth; // laneCount rounded up to whole AVX2 registers
+    uint32_t active; // Bit per lane still running in lockstep
+    uint64_t regs[32][MAX_LANES];
+    std::vector<RegisterFile> laneRegisters; // Per lane state beyond x1-x31 and pc: F, D and V registers
+    uint64_t operand[MAX_LANES];
+    std::vector<Op> ops;
+    uint64_t pc; // Shared byte address
+    size_t executed;
+    size_t limit;
+    std::vector<LaneResult> results;
+};
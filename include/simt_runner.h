@@ -0,0 +1,9 @@
+#pragma once
+
+// Runs one program against many data sections, up to 16 at a time in
+// lockstep SIMT groups, and prints each run's outcome and a throughput
+// summary. --scalar runs every data section on its own Simulator instead,
+// as a baseline to compare results and speed against.
+//
+// Usage: simulator --simt <program.hex> [--lanes <n>] [--limit <instructions>] [--scalar] <data.s>...
+int simtMain(int argc, char* argv[]);
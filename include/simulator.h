@@ -3,6 +3,19 @@
 #include "register_file.h"
 #include "memory.h"
 #include "instruction.h"
+#include "undo_log.h"
+#include "hart.h"
+#include "program.h"
+#include "profiler.h"
+#include "call_graph.h"
+#include "stack_sampler.h"
+#include "symbol_table.h"
+#include "plugin_host.h"
+#include "event_stream.h"
+#include "host_counters.h"
+#include "instruction_stats.h"
+#include "stats.h"
+#include <memory>
 #include <vector>
 #include <map>
 #include <string>
@@ -10,41 +23,246 @@
 
 class Simulator {
 private:
-    std::vector<uint32_t> machineCode;
+    Program text;
     RegisterFile rf;
     Memory mem;
-    uint64_t pc;
+    uint64_t pc; // Byte address of the next instruction
     std::map<int, bool> breakpoints;
-    std::vector<int> lineNumbers;
     int currentLine;
     size_t executedInstructions;
+    bool watchTriggered;
     std::unordered_map<std::string, uint64_t> labels;
+    std::string programFile;
 
+    // Hotspot profile of the instructions run by step, run and runQuiet.
+    // Reverse execution and goto neither uncount nor recount instructions.
+    static const size_t DEFAULT_PROFILE_TOP = 10;
+    Profiler profile;
+    bool profiling;
+    size_t profileTop;
+    CallGraph callGraph;
+    bool callProfiling;
+    StackSampler sampler;
+    bool sampling;
+    InstructionStats instructionStats;
+    bool collectingStats;
+    std::string statsFile; // Written at exit
+    PluginHost plugins;
+    EventStream stream;
+    bool loggingAccesses;
+    bool anyProfiling; // Any of the above, a plugin or a stream consumer, so step and runQuiet test one flag
+    void updateInstrumentation();
+    // Counts the instruction just executed into the enabled profiles and
+    // reports it to the plugins that asked for it
+    void profileInstruction(size_t index);
+    void takeSample();
+    void publishEvents(size_t index);
+    void resetProfiles();
+    void translatePlugins();
+    // Host hardware counters read around run, when enabled
+    std::unique_ptr<HostCounters> hostCounters;
+    void runToStop();
+    // Wall time of run and runQuiet and the instructions they executed,
+    // for the MIPS statistic
+    double runSeconds;
+    size_t timedInstructions;
 
+    // Shadow call stack. Frames hold the entry address and its symbol, so
+    // calls and returns copy no strings; names are looked up for display.
+    static const uint64_t NO_RETURN = UINT64_MAX; // Return address of the root frame
     struct CallStackFrame {
-    std::string functionName;
-    int line;
-};
+        uint64_t entry;
+        uint64_t returnAddress; // Address after the call
+        int symbol;             // Symbol starting at entry, or SymbolTable::NONE
+        int line;               // Last line executed in the frame
+    };
 
     std::vector<CallStackFrame> callStack;
-    std::unordered_map<uint64_t, std::string> addressToLabel;
+    SymbolTable symbols;
+    // Frames popped and whether one was pushed by the last instruction
+    size_t framesPopped;
+    bool framePushed;
     void scanLabels(const std::string& filename);
+    CallStackFrame makeFrame(uint64_t entry, uint64_t returnAddress, int line) const;
+    std::string frameName(const CallStackFrame& frame) const;
+    void pushFrame(const CallStackFrame& frame);
+    void popFrame();
+
+    // Everything that changes while the guest runs. Memory pages are shared
+    // copy-on-write, so capturing a state costs one pointer per page.
+    struct MachineState {
+        RegisterFile rf;
+        Memory::Image memory;
+        uint64_t pc;
+        size_t executedInstructions;
+        std::vector<CallStackFrame> callStack;
+    };
+
+    MachineState captureState() const;
+    void restoreState(const MachineState& state);
+
+    // Named in-memory snapshots (snapshot take/restore)
+    std::map<std::string, MachineState> snapshots;
+
+    // Reverse execution: an undo log of overwritten values for cheap single
+    // steps back, plus full checkpoints keyed by executedInstructions to
+    // restore from and replay forward when the log does not reach far enough.
+
+    static const size_t DEFAULT_UNDO_ENTRIES = 1 << 16;
+    static const size_t DEFAULT_CHECKPOINT_INTERVAL = 10000;
+    static const size_t DEFAULT_MAX_CHECKPOINTS = 16;
+
+    bool reverseEnabled;
+    bool faulted;
+    UndoLog undoLog;
+    std::map<size_t, MachineState> checkpoints;
+    size_t checkpointInterval;
+    size_t maxCheckpoints;
+
+    // Harts of the last multi-hart run, kept for inspection
+    static const int MAX_HARTS = 256;
+    std::vector<std::unique_ptr<Hart>> harts;
+    bool prepareHarts(int hartCount);
+    void finishHarts(double seconds, bool report);
+
+    int lineAt(uint64_t address) const { return text.line(text.indexAt(address)); }
+    // Returns the index of the executed instruction
+    size_t executeCurrent(bool trace);
+    void takeCheckpoint();
+    void restoreCheckpoint(std::map<size_t, MachineState>::const_iterator it);
+    void undoInstruction(uint64_t instruction);
+    bool replayTo(size_t target);
+    void printPosition() const;
 
 public:
-    Simulator() : pc(0), currentLine(1), executedInstructions(0) {
+    Simulator() : pc(0), currentLine(1), executedInstructions(0), watchTriggered(false),
+                  profiling(false), profileTop(DEFAULT_PROFILE_TOP), callProfiling(false),
+                  sampling(false), collectingStats(false), loggingAccesses(false), anyProfiling(false),
+                  runSeconds(0), timedInstructions(0), framesPopped(0), framePushed(false),
+                  reverseEnabled(true), faulted(false), undoLog(DEFAULT_UNDO_ENTRIES),
+                  checkpointInterval(DEFAULT_CHECKPOINT_INTERVAL), maxCheckpoints(DEFAULT_MAX_CHECKPOINTS) {
         rf.write(RegisterFile::PC, 0);
+        rf.setJournal(&undoLog);
+        mem.setJournal(&undoLog);
     }
+    // Register file and memory hold pointers to this simulator's undo log
+    Simulator(const Simulator&) = delete;
+    Simulator& operator=(const Simulator&) = delete;
+
     void loadProgram(const std::string& filename);
     void loadDataSection(const std::string& filename);
     void run();
     void step();
+    // Runs without tracing or breakpoints until the program ends or
+    // maxInstructions more have executed. Returns true if the program ended.
+    bool runQuiet(size_t maxInstructions);
+
+    const Program& program() const { return text; }
+    const RegisterFile& registers() const { return rf; }
+    Memory& memory() { return mem; }
+    size_t instructionCount() const { return executedInstructions; }
     void printRegs();
+    void printFloatRegs() const;
+    void printVectorRegs() const;
+    // Changes VLEN for this simulator and the harts it starts; clears the
+    // vector registers
+    void setVectorLength(unsigned bits);
     void printMem(uint64_t addr, int count);
     void showStack() const;
     void setBreakpoint(int line);
     void deleteBreakpoint(int line);
-    void updateCallStack(uint32_t instruction);
+    // Tracks calls and returns after an instruction has executed and pc
+    // moved on; fallThrough is the address after the instruction.
+    // Following the RISC-V return-address hints, jal and jalr with rd = x1
+    // or x5 call. A jalr with rd = x0 returns to the frame whose return
+    // address it lands on, or pops one frame if it jumps through x1 or x5;
+    // any other jump to the entry of a function is a tail call, which
+    // replaces the current frame.
+    void updateCallStack(uint32_t instruction, uint64_t fallThrough);
     void listBreakpoints() const;
+    void setWatchpoint(uint64_t addr, uint64_t length, int type);
+    void deleteWatchpoint(uint64_t addr);
+    void listWatchpoints() const;
+    void reportWatchHits(const Instruction& inst, uint64_t instPc);
+
+    void reverseStep();
+    void reverseContinue();
+    void gotoInstruction(size_t target);
+    void setReverseDebugging(bool enabled);
+    void configureReverse(size_t logEntries, size_t interval, size_t checkpointLimit);
+    void printReverseStats() const;
+
+    // Runs the program on hartCount harts sharing this simulator's memory,
+    // one host thread per hart. Breakpoints, watchpoints and reverse
+    // execution do not apply to multi-hart runs.
+    void runHarts(int hartCount, size_t maxInstructions);
+    // Runs hartCount harts on a fixed pool of worker threads in rounds of
+    // quantum instructions per hart, for more harts than host cores.
+    // report = false skips the per-hart summary, e.g. in batch runs.
+    void scheduleHarts(int hartCount, size_t workers, size_t quantum, size_t maxInstructions, bool report = true);
+    void printHartRegs(int hartId) const;
+    size_t hartCount() const { return harts.size(); }
+    const Hart& hart(size_t id) const { return *harts[id]; }
+
+    // Starts or stops counting executed instructions; counts are kept until
+    // resetProfile or the next loadProgram. topN sets the length of the
+    // report printed by finishProfile.
+    void setProfiling(bool enabled, size_t topN = DEFAULT_PROFILE_TOP);
+    void resetProfile();
+    void printProfile(size_t topN) const;
+    void writeProfileListing(const std::string& filename) const;
+    // Call-graph profile with exclusive and inclusive counts per function
+    // and per call edge, kept until resetCallGraph or the next loadProgram
+    void setCallProfiling(bool enabled);
+    void resetCallGraph();
+    void printCallGraph() const;
+    void writeCallgrind(const std::string& filename) const;
+    // Samples the call stack about every sampleInterval instructions
+    void setSampling(bool enabled);
+    // Drops the samples taken so far
+    void setSampleInterval(uint64_t interval);
+    void resetSamples();
+    void writeFoldedStacks(const std::string& filename) const;
+    // Loads an instrumentation plugin (see plugin.h); args is passed to it
+    void loadPlugin(const std::string& path, const std::string& args);
+    void listPlugins() const;
+    // Lets every plugin finish and unloads them
+    void unloadPlugins();
+
+    // Streams executed instructions and memory accesses to an analysis on
+    // its own thread
+    void addStreamConsumer(std::unique_ptr<EventConsumer> consumer, EventStream::Policy policy);
+    void printStreamStats();
+    // Drains the stream, prints every consumer's report and removes them
+    void stopStream();
+
+    // Prints the enabled profiles and writes them next to the loaded
+    // program: the annotated listing to <program>.prof, the call graph to
+    // <program>.callgrind and the sampled stacks to <program>.folded
+    void finishProfile() const;
+    // Run statistics for dashboards. Instructions executed, wall time, MIPS
+    // and memory footprint are always available; the instruction mix,
+    // branch outcomes and loads and stores by width are counted while
+    // collection is on, until resetStats or the next loadProgram.
+    void setStatsCollection(bool enabled);
+    void resetStats();
+    void registerStats(StatsRegistry& stats) const;
+    // CSV for a .csv file, JSON otherwise
+    void writeStats(const std::string& filename) const;
+    void printStats(bool csv) const;
+    // Turns collection on and writes the statistics to filename at exit
+    void setStatsFile(const std::string& filename);
+    void finishStats() const;
+    // Reads host cycles, instructions, branch misses and LLC misses around
+    // every run and prints them per guest instruction
+    void setPerfStats(bool enabled);
+
+    void takeSnapshot(const std::string& name);
+    void restoreSnapshot(const std::string& name);
+    void deleteSnapshot(const std::string& name);
+    void listSnapshots() const;
+    void saveSnapshotFile(const std::string& filename) const;
+    void loadSnapshotFile(const std::string& filename);
 
     bool isBreakpoint() const;
 
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+// Sampling profile of guest call stacks for flame graphs. The simulator
+// counts instructions down to the next sample and hands over the call stack
+// folded into "main;f;g" form; identical stacks share one counter. Intervals
+// are drawn uniformly from [interval / 2, 3 * interval / 2] so samples do
+// not lock onto loops whose length divides the interval.
+class StackSampler {
+public:
+    static const uint64_t DEFAULT_INTERVAL = 10007;
+
+    StackSampler() { reset(DEFAULT_INTERVAL); }
+
+    // Drops all samples and restarts the interval sequence
+    void reset(uint64_t interval);
+    uint64_t interval() const { return meanInterval; }
+
+    // Counts one instruction; true when a sample is due
+    bool tick() { return --countdown == 0; }
+    void record(const std::string& foldedStack);
+
+    uint64_t samples() const { return sampleCount; }
+    // One "stack count" line per distinct stack, as read by flamegraph.pl
+    // and speedscope
+    void writeFolded(std::ostream& out) const;
+
+private:
+    uint64_t nextInterval();
+
+    std::unordered_map<std::string, uint64_t> stacks;
+    std::minstd_rand rng;
+    uint64_t meanInterval = DEFAULT_INTERVAL;
+    uint64_t countdown = DEFAULT_INTERVAL;
+    uint64_t sampleCount = 0;
+};
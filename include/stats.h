@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Named run statistics, written for dashboards as JSON or CSV. Subsystems
+// register counters (integers), gauges (measurements such as seconds) and
+// histograms (counts per bucket) when a dump is requested, so nothing here
+// is touched while the guest runs. Entries keep their registration order.
+class StatsRegistry {
+public:
+    void counter(const std::string& name, uint64_t value);
+    void gauge(const std::string& name, double value);
+    // Adds count to one bucket; the histogram and bucket are created on
+    // first use
+    void histogram(const std::string& name, const std::string& bucket, uint64_t count);
+
+    // One JSON object: counters and gauges as numbers, histograms as
+    // objects of buckets
+    void writeJson(std::ostream& out) const;
+    // "name,bucket,value" rows; the bucket is empty except in histograms
+    void writeCsv(std::ostream& out) const;
+
+private:
+    enum Kind { COUNTER, GAUGE, HISTOGRAM };
+    struct Entry {
+        std::string name;
+        Kind kind;
+        uint64_t count;
+        double measurement;
+        std::vector<std::pair<std::string, uint64_t>> buckets;
+    };
+    Entry& add(const std::string& name, Kind kind);
+
+    std::vector<Entry> entries;
+};
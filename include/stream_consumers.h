@@ -0,0 +1,41 @@
+#pragma once
+
+#include "event_stream.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Set-associative LRU data cache fed by the loads and stores in the stream
+class CacheModel : public EventConsumer {
+public:
+    // Throws unless sets and lineBytes are powers of two and ways > 0
+    CacheModel(size_t sets, size_t ways, size_t lineBytes);
+    std::string name() const override { return "cache"; }
+    void consume(const StreamEvent* events, size_t count) override;
+    void report(std::ostream& out) const override;
+
+private:
+    void access(uint64_t line, bool isWrite);
+
+    size_t sets, ways;
+    int lineShift;
+    std::vector<uint64_t> tags;     // sets * ways, most recently used first
+    std::vector<uint8_t> valid;
+    uint64_t hits[2] = {0, 0};      // Indexed by isWrite
+    uint64_t misses[2] = {0, 0};
+};
+
+// Retired instructions by class, and conditional branches taken
+class InstructionMix : public EventConsumer {
+public:
+    std::string name() const override { return "mix"; }
+    void consume(const StreamEvent* events, size_t count) override;
+    void report(std::ostream& out) const override;
+
+private:
+    std::map<const char*, uint64_t> classes; // Keyed by the class names of Profiler
+    uint64_t retired = 0;
+    uint64_t branches = 0;
+    uint64_t taken = 0;
+};
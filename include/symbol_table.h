@@ -0,0 +1,54 @@
+#pragma once
+
+#include "program.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Text labels of a loaded program, sorted by address. Range lookups find
+// the symbol containing an address by binary search; after index() the
+// symbol containing or starting at an instruction is one array read.
+// Symbols are marked as functions when something calls them, statically
+// for jal targets and at run time for jalr targets, so a jump to one can be
+// told apart from a jump to a loop label.
+class SymbolTable {
+public:
+    static const int NONE = -1;
+
+    void clear();
+    // Adds a label; the first name given to an address is kept
+    void add(uint64_t address, const std::string& name);
+    // Sorts the symbols and builds the per-instruction tables, marking the
+    // targets of jal calls in the program as functions
+    void index(const Program& program);
+
+    size_t size() const { return symbols.size(); }
+    const std::string& name(int id) const { return symbols[id].name; }
+    uint64_t address(int id) const { return symbols[id].address; }
+
+    // Symbol starting exactly at address, or NONE
+    int at(uint64_t address) const;
+    // Symbol with the highest address at or below address, or NONE
+    int containing(uint64_t address) const;
+    // The same lookups by instruction index, valid after index()
+    int startingAt(size_t instruction) const { return starting[instruction]; }
+    int containingInstruction(size_t instruction) const { return containingAt[instruction]; }
+
+    bool isFunction(int id) const { return symbols[id].function; }
+    void markFunction(int id) { symbols[id].function = true; }
+
+    // The label at address, else the address in hex
+    std::string nameAt(uint64_t address) const;
+
+private:
+    struct Symbol {
+        uint64_t address;
+        std::string name;
+        bool function;
+    };
+
+    std::vector<Symbol> symbols;
+    std::vector<int> starting;     // Per instruction index
+    std::vector<int> containingAt; // Per instruction index
+};
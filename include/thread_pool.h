@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool with one task queue per worker. Workers take from
+// the front of their own queue and steal from the back of the others when
+// it runs dry, so uneven task lengths still keep every core busy. A single
+// worker runs tasks in submission order.
+class WorkStealingPool {
+public:
+    // threads == 0 sizes the pool to the machine
+    explicit WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Tasks must not throw
+    void submit(std::function<void()> task);
+    // Blocks until every submitted task has finished
+    void wait();
+    size_t size() const { return workers.size(); }
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popTask(size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex stateLock;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::atomic<size_t> queued;
+    size_t pending;
+    size_t nextQueue;
+    bool stopping;
+};
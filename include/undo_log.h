@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Bounded ring buffer of the values overwritten by each executed instruction.
+// RegisterFile and Memory append to it while journaling is on; the simulator
+// pops entries back off to step backwards without replaying.
+class UndoLog {
+public:
+    enum Kind : uint8_t {
+        REGISTER,   // location = register number
+        MEMORY,     // location = address, size = access width
+        STEP,       // location = previous pc, oldValue = caller line
+        FRAME_PUSH, // A call pushed a frame onto the shadow call stack
+        FRAME_POP   // location = function entry, oldValue = return address, line = frame line
+    };
+
+    struct Entry {
+        uint64_t instruction;   // executedInstructions when the write happened
+        uint64_t location;
+        uint64_t oldValue;
+        uint8_t kind;
+        uint8_t size;
+        int32_t line;
+    };
+
+    explicit UndoLog(size_t capacity);
+
+    void setCapacity(size_t capacity);
+    void reset(uint64_t instruction);
+    void setInstruction(uint64_t instruction) { current = instruction; }
+
+    void recordRegister(int reg, uint64_t oldValue);
+    void recordMemory(uint64_t address, int size, uint64_t oldValue);
+    void recordStep(uint64_t previousPc, int callerLine);
+    void recordFramePush();
+    void recordFramePop(uint64_t entry, uint64_t returnAddress, int line);
+
+    // True if every entry written by the given instruction is still buffered
+    bool canUndo(uint64_t instruction) const {
+        return instruction >= firstComplete && count > 0;
+    }
+    bool empty() const { return count == 0; }
+    Entry& back() { return entries[(head + limit - 1) % limit]; }
+    void popBack();
+
+    size_t size() const { return count; }
+    size_t capacity() const { return limit; }
+    size_t memoryUsage() const;
+
+private:
+    Entry& push();
+
+    std::vector<Entry> entries; // Grows on demand up to limit, then wraps
+    size_t limit;
+    size_t head;    // next slot to write
+    size_t count;
+    uint64_t current;
+    uint64_t firstComplete;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "instruction.h"
+#include <cstddef>
+
+// V extension instructions (integer subset of RVV 1.0). There is one class
+// per instruction format rather than per mnemonic: the operation is
+// decoded once and execution hands whole register groups to the kernels
+// in vector_kernels.h. Instructions never stop partway, so vstart stays 0.
+class VectorInstruction : public Instruction {
+public:
+    // Decodes OP-V and the vector forms of LOAD-FP and STORE-FP. Returns
+    // nullptr for encodings outside the supported subset.
+    static std::unique_ptr<Instruction> decode(uint32_t machineCode);
+
+protected:
+    // The current vtype, read once per instruction
+    struct Config {
+        int sew;       // Element width in bytes
+        int lmulLog2;  // -3 (mf8) to 3 (m8)
+        size_t vl;
+        int group;     // Registers in a group of SEW-wide elements
+    };
+
+    explicit VectorInstruction(uint32_t machineCode);
+    // Throws if vtype is illegal
+    Config config(const RegisterFile& rf) const;
+    // Throws unless v starts a group of the given size
+    void checkGroup(int v, int group) const;
+    const uint8_t* maskOperand(const RegisterFile& rf) const { return masked ? rf.vector(0) : nullptr; }
+    std::string maskSuffix() const { return masked ? ", v0.t" : ""; }
+
+    int vd, vs1, vs2; // vs1 doubles as rs1 and the immediate; vd as rd and vs3
+    bool masked;      // vm = 0: only elements whose bit in v0 is set
+};
+
+// vsetvli, vsetivli and vsetvl
+class VectorConfig : public VectorInstruction {
+public:
+    enum Form { VSETVLI, VSETIVLI, VSETVL };
+    VectorConfig(uint32_t machineCode, Form form);
+    void execute(RegisterFile& rf, Memory& mem) override;
+    std::string toString() const override;
+
+private:
+    Form form;
+    uint64_t vtypeImm;
+};
+
+// Unit-stride, strided and mask loads and stores
+class VectorLoadStore : public VectorInstruction {
+public:
+    enum Mode { UNIT, STRIDED, MASK };
+    VectorLoadStore(uint32_t machineCode, bool isStore, Mode mode, int width);
+    void execute(RegisterFile& rf, Memory& mem) override;
+    std::string toString() const override;
+
+private:
+    bool isStore;
+    Mode mode;
+    int width; // EEW in bytes
+};
+
+// OPIVV, OPIVX, OPIVI, OPMVV and OPMVX integer instructions
+class VectorArith : public VectorInstruction {
+public:
+    enum Form { VV, VX, VI };
+    enum Kind {
+        ELEMENTWISE, COMPARE, REDUCTION,
+        MV_X_S, MV_S_X, VID, CPOP, FIRST,
+        MV_WHOLE // vmv<nr>r.v
+    };
+    VectorArith(uint32_t machineCode, Kind kind, int op, Form form, const char* name);
+    void execute(RegisterFile& rf, Memory& mem) override;
+    std::string toString() const override;
+
+private:
+    uint64_t scalarOperand(const RegisterFile& rf) const;
+
+    Kind kind;
+    int op; // VectorOp
+    Form form;
+    const char* name;
+};
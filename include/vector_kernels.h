@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Integer kernels of the V extension. Each call covers a whole instruction:
+// all vl elements of a register group, 32 bytes per step with AVX2 when
+// the host supports it, else element by element. sew is the element width
+// in bytes. Only elements below vl are written (tail undisturbed); with a
+// mask, elements whose mask bit is clear keep their old value (mask
+// undisturbed). Operands may run VECTOR_PADDING bytes past vl.
+enum VectorOp {
+    VOP_ADD, VOP_SUB, VOP_RSUB, VOP_AND, VOP_OR, VOP_XOR,
+    VOP_SLL, VOP_SRL, VOP_SRA,
+    VOP_MINU, VOP_MIN, VOP_MAXU, VOP_MAX,
+    VOP_MUL, VOP_MACC, // MACC: d += a * b
+    VOP_MV,            // d = b
+    VOP_MERGE,         // d = mask ? b : a, for every element below vl
+    // Compares
+    VOP_SEQ, VOP_SNE, VOP_SLTU, VOP_SLT, VOP_SLEU, VOP_SLE, VOP_SGTU, VOP_SGT
+};
+
+// d[i] = a[i] op b[i], or a[i] op x when b is null. d may alias a or b.
+void vectorArith(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+                 const uint8_t* mask);
+// Mask bit i of d = a[i] op b[i], or a[i] op x when b is null
+void vectorCompare(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+                   const uint8_t* mask);
+// init op a[0] op a[1] ... over the active elements; op is ADD, AND, OR,
+// XOR or a min/max. The result is zero-extended from sew bytes.
+uint64_t vectorReduce(int op, int sew, const uint8_t* a, uint64_t init, size_t vl, const uint8_t* mask);
+
+bool vectorKernelsUseAvx2();
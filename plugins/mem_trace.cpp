@@ -0,0 +1,64 @@
+// Example plugin: counts loads and stores by width and, given a file name
+// as its argument, writes one line per access:
+//   <pc> R|W <address> <size> <value>
+//
+//   make plugins
+//   > plugin load bin/plugins/mem_trace.so trace.txt
+
+#include "plugin.h"
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+class MemTrace : public Plugin {
+public:
+    explicit MemTrace(const char* args) : out(nullptr), loads(9, 0), stores(9, 0) {
+        if (args && *args) {
+            out = std::fopen(args, "w");
+        }
+    }
+
+    ~MemTrace() override {
+        if (out) {
+            std::fclose(out);
+        }
+    }
+
+    unsigned instrument(const InstructionInfo& info) override {
+        // Only instructions that can access memory: loads, stores and atomics,
+        // scalar and vector
+        switch (info.instruction & 0x7F) {
+            case 0x03: case 0x07: case 0x23: case 0x27: case 0x2F:
+                addresses.resize(info.index + 1, 0);
+                addresses[info.index] = info.address;
+                return EVENT_MEMORY;
+            default:
+                return 0;
+        }
+    }
+
+    void onMemoryAccess(size_t index, uint64_t address, int size, bool isWrite, uint64_t value) override {
+        (isWrite ? stores : loads)[size]++;
+        if (out) {
+            std::fprintf(out, "%llx %c %llx %d %llx\n", static_cast<unsigned long long>(addresses[index]),
+                         isWrite ? 'W' : 'R', static_cast<unsigned long long>(address), size,
+                         static_cast<unsigned long long>(value));
+        }
+    }
+
+    void finish() override {
+        std::cout << std::dec << "mem_trace:";
+        for (int size = 1; size <= 8; size *= 2) {
+            std::cout << " " << size << "B " << loads[size] << "R/" << stores[size] << "W";
+        }
+        std::cout << std::endl;
+    }
+
+private:
+    std::FILE* out;
+    std::vector<uint64_t> loads;
+    std::vector<uint64_t> stores;
+    std::vector<uint64_t> addresses; // pc by instruction index
+};
+
+RVSIM_DECLARE_PLUGIN(MemTrace)
@@ -0,0 +1,266 @@
+#include "../include/batch_runner.h"
+#include "../include/simulator.h"
+#include "../include/thread_pool.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t DEFAULT_BATCH_LIMIT = 100000000;
+
+// hart is 0 unless the job runs scheduled harts
+struct RegisterExpectation {
+    int hart;
+    int reg;
+    uint64_t value;
+};
+
+struct MemoryExpectation {
+    uint64_t address;
+    int size;
+    uint64_t value;
+};
+
+struct BatchJob {
+    int manifestLine;
+    std::string program;
+    std::string data;
+    size_t limit;
+    std::string expectedStatus;
+    int harts; // 0 runs the program on the Simulator itself
+    size_t workers;
+    size_t quantum;
+    std::vector<RegisterExpectation> registers;
+    std::vector<MemoryExpectation> memory;
+};
+
+struct BatchResult {
+    std::string status;
+    std::string error;
+    std::vector<std::string> failures;
+    size_t instructions;
+    double seconds;
+};
+
+std::string resolvePath(const std::string& base, const std::string& path) {
+    if (path.empty() || path[0] == '/' || base.empty()) {
+        return path;
+    }
+    return base + "/" + path;
+}
+
+std::string hexString(uint64_t value) {
+    std::ostringstream ss;
+    ss << "0x" << std::hex << value;
+    return ss.str();
+}
+
+std::vector<BatchJob> parseManifest(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    size_t slash = filename.find_last_of('/');
+    std::string base = slash == std::string::npos ? "" : filename.substr(0, slash);
+
+    std::vector<BatchJob> jobs;
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line)) {
+        lineNum++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream iss(line);
+        std::string program;
+        if (!(iss >> program)) {
+            continue;
+        }
+        BatchJob job{lineNum, resolvePath(base, program), "", DEFAULT_BATCH_LIMIT, "done", 0, 0, 0, {}, {}};
+        std::string field;
+        while (iss >> field) {
+            size_t eq = field.find('=');
+            if (eq == std::string::npos) {
+                throw std::runtime_error("Manifest line " + std::to_string(lineNum) + ": expected key=value, got " + field);
+            }
+            std::string key = field.substr(0, eq);
+            std::string value = field.substr(eq + 1);
+            if (key == "data") {
+                job.data = resolvePath(base, value);
+            } else if (key == "limit") {
+                job.limit = std::stoull(value);
+            } else if (key == "status") {
+                job.expectedStatus = value;
+            } else if (key == "schedule") {
+                char comma1 = 0, comma2 = 0;
+                std::istringstream fields(value);
+                if (!(fields >> job.harts >> comma1 >> job.workers >> comma2 >> job.quantum) || comma1 != ',' ||
+                    comma2 != ',' || job.harts < 1 || job.quantum == 0) {
+                    throw std::runtime_error("Manifest line " + std::to_string(lineNum) +
+                                             ": expected schedule=<harts>,<workers>,<quantum>, got " + value);
+                }
+            } else if (key.size() > 1 && key[0] == 'x') {
+                size_t at = key.find('@');
+                int hart = at == std::string::npos ? 0 : std::stoi(key.substr(at + 1));
+                job.registers.push_back({hart, std::stoi(key.substr(1, at - 1)), std::stoull(value, nullptr, 0)});
+            } else if (key.compare(0, 3, "mem") == 0 && key.find('@') != std::string::npos) {
+                size_t at = key.find('@');
+                int bits = std::stoi(key.substr(3, at - 3));
+                job.memory.push_back({std::stoull(key.substr(at + 1), nullptr, 0), bits / 8, std::stoull(value, nullptr, 0)});
+            } else {
+                throw std::runtime_error("Manifest line " + std::to_string(lineNum) + ": unknown field " + key);
+            }
+        }
+        for (const auto& reg : job.registers) {
+            if (reg.hart != 0 && reg.hart >= job.harts) {
+                throw std::runtime_error("Manifest line " + std::to_string(lineNum) + ": no hart " +
+                                         std::to_string(reg.hart) + " in this job");
+            }
+        }
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+uint64_t readValue(Memory& mem, uint64_t address, int size) {
+    switch (size) {
+        case 1: return mem.read8(address);
+        case 2: return mem.read16(address);
+        case 4: return mem.read32(address);
+        default: return mem.read64(address);
+    }
+}
+
+// Each job owns its Simulator; nothing is shared between jobs
+BatchResult runJob(const BatchJob& job) {
+    BatchResult result{"", "", {}, 0, 0.0};
+    auto start = std::chrono::steady_clock::now();
+    Simulator sim;
+    sim.setReverseDebugging(false);
+    try {
+        sim.loadProgram(job.program);
+        if (!job.data.empty()) {
+            sim.loadDataSection(job.data);
+        }
+        if (job.harts > 0) {
+            sim.scheduleHarts(job.harts, job.workers, job.quantum, job.limit, false);
+            if (sim.hartCount() != static_cast<size_t>(job.harts)) {
+                throw std::runtime_error("Could not start " + std::to_string(job.harts) + " harts");
+            }
+            result.status = "done";
+            for (size_t i = 0; i < sim.hartCount(); ++i) {
+                if (sim.hart(i).faulted()) {
+                    throw std::runtime_error("Hart " + std::to_string(i) + ": " + sim.hart(i).error());
+                }
+                if (!sim.hart(i).finished()) {
+                    result.status = "limit";
+                }
+            }
+        } else {
+            result.status = sim.runQuiet(job.limit) ? "done" : "limit";
+        }
+    } catch (const std::exception& e) {
+        result.status = "error";
+        result.error = e.what();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.instructions = sim.instructionCount();
+    for (size_t i = 0; i < sim.hartCount(); ++i) {
+        result.instructions += sim.hart(i).instructionCount();
+    }
+
+    if (result.status != job.expectedStatus) {
+        result.failures.push_back("status " + result.status + " (expected " + job.expectedStatus + ")" +
+                                  (result.error.empty() ? "" : ": " + result.error));
+    }
+    for (const auto& reg : job.registers) {
+        std::string name = "x" + std::to_string(reg.reg);
+        if (job.harts > 0) {
+            name += "@" + std::to_string(reg.hart);
+            if (static_cast<size_t>(reg.hart) >= sim.hartCount()) {
+                result.failures.push_back(name + ": hart did not run");
+                continue;
+            }
+        }
+        const RegisterFile& regs = job.harts > 0 ? sim.hart(reg.hart).registers() : sim.registers();
+        uint64_t actual = regs.read(reg.reg);
+        if (actual != reg.value) {
+            result.failures.push_back(name + " = " + hexString(actual) + " (expected " + hexString(reg.value) + ")");
+        }
+    }
+    for (const auto& check : job.memory) {
+        try {
+            uint64_t actual = readValue(sim.memory(), check.address, check.size);
+            if (actual != check.value) {
+                result.failures.push_back("mem[" + hexString(check.address) + "] = " + hexString(actual) +
+                                          " (expected " + hexString(check.value) + ")");
+            }
+        } catch (const std::exception& e) {
+            result.failures.push_back("mem[" + hexString(check.address) + "]: " + e.what());
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int batchMain(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: simulator --batch <manifest> [--threads <n>]" << std::endl;
+        return 1;
+    }
+    size_t threads = 0;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (std::string(argv[i]) == "--threads") {
+            threads = std::stoul(argv[i + 1]);
+        }
+    }
+
+    std::vector<BatchJob> jobs;
+    try {
+        jobs = parseManifest(argv[2]);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<BatchResult> results(jobs.size());
+    auto start = std::chrono::steady_clock::now();
+    size_t poolSize;
+    {
+        WorkStealingPool pool(threads);
+        poolSize = pool.size();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            pool.submit([&jobs, &results, i] { results[i] = runJob(jobs[i]); });
+        }
+        pool.wait();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t passed = 0;
+    size_t totalInstructions = 0;
+    double cpuSeconds = 0.0;
+    std::cout << "Batch: " << jobs.size() << " programs on " << poolSize << " threads" << std::endl;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const BatchResult& r = results[i];
+        bool ok = r.failures.empty();
+        passed += ok;
+        totalInstructions += r.instructions;
+        cpuSeconds += r.seconds;
+        std::cout << (ok ? "PASS  " : "FAIL  ") << std::left << std::setw(40) << jobs[i].program << std::right
+                  << std::setw(7) << r.status << std::setw(12) << r.instructions << " instr"
+                  << std::fixed << std::setprecision(3) << std::setw(10) << r.seconds * 1e3 << " ms"
+                  << std::setw(10) << (r.seconds > 0 ? r.instructions / r.seconds / 1e6 : 0.0) << " MIPS" << std::endl;
+        for (const std::string& failure : r.failures) {
+            std::cout << "      line " << jobs[i].manifestLine << ": " << failure << std::endl;
+        }
+    }
+    std::cout << "Summary: " << passed << " passed, " << jobs.size() - passed << " failed; "
+              << totalInstructions << " instructions; wall " << wallSeconds * 1e3 << " ms, cpu "
+              << cpuSeconds * 1e3 << " ms; aggregate "
+              << (wallSeconds > 0 ? totalInstructions / wallSeconds / 1e6 : 0.0) << " MIPS" << std::endl;
+    return passed == jobs.size() ? 0 : 1;
+}
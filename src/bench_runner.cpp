@@ -0,0 +1,210 @@
+#include "../include/bench_runner.h"
+#include "../include/simulator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t DEFAULT_BENCH_INSTRUCTIONS = 5000000;
+const int DEFAULT_BENCH_WARMUP = 1;
+const int DEFAULT_BENCH_REPEAT = 5;
+
+struct KernelResult {
+    std::string error;
+    size_t instructions; // Per run; less than asked if the kernel ended
+    std::vector<double> seconds;
+    long peakRssKiB;
+};
+
+std::string dataFileFor(const std::string& program) {
+    size_t dot = program.find_last_of('.');
+    std::string data = (dot == std::string::npos ? program : program.substr(0, dot)) + ".s";
+    return std::ifstream(data).good() ? data : "";
+}
+
+// One load and run; returns seconds spent running, not loading
+double runOnce(const std::string& program, const std::string& data, size_t limit, size_t& instructions) {
+    Simulator sim;
+    sim.setReverseDebugging(false);
+    sim.loadProgram(program);
+    if (!data.empty()) {
+        sim.loadDataSection(data);
+    }
+    auto start = std::chrono::steady_clock::now();
+    sim.runQuiet(limit);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    instructions = sim.instructionCount();
+    return seconds;
+}
+
+// Runs in the child; the result goes back to the parent as one line of
+// text: "ok <instructions> <peak RSS KiB> <seconds>..." or "error <message>"
+std::string measureKernel(const std::string& program, size_t limit, int warmup, int repeat) {
+    std::ostringstream out;
+    try {
+        std::string data = dataFileFor(program);
+        size_t instructions = 0;
+        for (int i = 0; i < warmup; ++i) {
+            runOnce(program, data, limit, instructions);
+        }
+        std::vector<double> seconds;
+        for (int i = 0; i < repeat; ++i) {
+            seconds.push_back(runOnce(program, data, limit, instructions));
+        }
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        out << "ok " << instructions << " " << usage.ru_maxrss; // KiB on Linux
+        out << std::setprecision(9);
+        for (double s : seconds) {
+            out << " " << s;
+        }
+    } catch (const std::exception& e) {
+        out << "error " << e.what();
+    }
+    return out.str();
+}
+
+// A child per kernel, so each reports its own peak RSS and no kernel
+// inherits another's heap
+KernelResult runKernel(const std::string& program, size_t limit, int warmup, int repeat) {
+    KernelResult result{"", 0, {}, 0};
+    int fds[2];
+    if (pipe(fds) != 0) {
+        result.error = "pipe failed";
+        return result;
+    }
+    std::cout.flush();
+    pid_t child = fork();
+    if (child < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        result.error = "fork failed";
+        return result;
+    }
+    if (child == 0) {
+        close(fds[0]);
+        std::string line = measureKernel(program, limit, warmup, repeat);
+        ssize_t written = write(fds[1], line.data(), line.size());
+        _exit(written == static_cast<ssize_t>(line.size()) ? 0 : 1);
+    }
+    close(fds[1]);
+    std::string line;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+        line.append(buffer, n);
+    }
+    close(fds[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+
+    std::istringstream in(line);
+    std::string word;
+    in >> word;
+    if (word == "ok") {
+        in >> result.instructions >> result.peakRssKiB;
+        double s;
+        while (in >> s) {
+            result.seconds.push_back(s);
+        }
+    } else if (word == "error") {
+        std::getline(in >> std::ws, result.error);
+    } else {
+        result.error = "benchmark process failed";
+    }
+    return result;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+void printBenchUsage() {
+    std::cerr << "Usage: simulator --bench [--instructions <n>] [--warmup <n>] [--repeat <n>] <kernel.hex>..." << std::endl;
+}
+
+std::string kernelName(const std::string& program) {
+    size_t slash = program.find_last_of('/');
+    std::string name = slash == std::string::npos ? program : program.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+} // namespace
+
+int benchMain(int argc, char* argv[]) {
+    size_t limit = DEFAULT_BENCH_INSTRUCTIONS;
+    int warmup = DEFAULT_BENCH_WARMUP;
+    int repeat = DEFAULT_BENCH_REPEAT;
+    std::vector<std::string> kernels;
+    try {
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--instructions" && i + 1 < argc) {
+                limit = std::stoull(argv[++i]);
+            } else if (arg == "--warmup" && i + 1 < argc) {
+                warmup = std::stoi(argv[++i]);
+            } else if (arg == "--repeat" && i + 1 < argc) {
+                repeat = std::stoi(argv[++i]);
+            } else {
+                kernels.push_back(arg);
+            }
+        }
+    } catch (const std::exception&) {
+        printBenchUsage();
+        return 1;
+    }
+    if (kernels.empty() || limit == 0 || warmup < 0 || repeat < 1) {
+        printBenchUsage();
+        return 1;
+    }
+
+    std::cout << "Bench: " << kernels.size() << " kernels, " << limit << " instructions per run, " << warmup
+              << " warm-up and " << repeat << " timed runs each" << std::endl;
+    std::cout << std::left << std::setw(16) << "kernel" << std::right << std::setw(14) << "instructions"
+              << std::setw(10) << "MIPS" << std::setw(12) << "ns/instr" << std::setw(9) << "spread"
+              << std::setw(14) << "peak RSS" << std::endl;
+    bool failed = false;
+    double logMipsSum = 0;
+    size_t measured = 0;
+    for (const std::string& kernel : kernels) {
+        KernelResult r = runKernel(kernel, limit, warmup, repeat);
+        std::cout << std::left << std::setw(16) << kernelName(kernel) << std::right;
+        if (!r.error.empty() || r.seconds.empty() || r.instructions == 0) {
+            failed = true;
+            std::cout << "  error: " << (r.error.empty() ? "no instructions executed" : r.error) << std::endl;
+            continue;
+        }
+        double mid = median(r.seconds);
+        auto range = std::minmax_element(r.seconds.begin(), r.seconds.end());
+        double mips = mid > 0 ? r.instructions / mid / 1e6 : 0.0;
+        std::cout << std::setw(14) << r.instructions << std::fixed << std::setprecision(2) << std::setw(10) << mips
+                  << std::setw(12) << mid * 1e9 / r.instructions << std::setprecision(1) << std::setw(8)
+                  << (mid > 0 ? (*range.second - *range.first) / mid * 100 : 0.0) << "%" << std::setw(10)
+                  << r.peakRssKiB << " KiB" << (r.instructions < limit ? "  (ended early)" : "") << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        if (mips > 0) {
+            logMipsSum += std::log(mips);
+            ++measured;
+        }
+    }
+    if (measured > 0) {
+        std::cout << "Geometric mean: " << std::fixed << std::setprecision(2) << std::exp(logMipsSum / measured)
+                  << " MIPS" << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,784 @@
+#include "../include/instruction.h"
+#include <algorithm>
+#include <sstream>
+
+// Zba and Zbb bit-manipulation extensions, mapped onto host operations:
+// the bit counts use the compiler builtins and the rotates are written in
+// the form compilers turn into a single rol.
+
+namespace {
+
+uint64_t rotateLeft(uint64_t value, uint64_t amount) {
+    return (value << amount) | (value >> (-amount & 0x3F));
+}
+
+uint32_t rotateLeft32(uint32_t value, uint64_t amount) {
+    return (value << amount) | (value >> (-amount & 0x1F));
+}
+
+} // namespace
+
+ADD_UW::ADD_UW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void ADD_UW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs2) + (rf.read(rs1) & 0xFFFFFFFF));
+}
+
+std::string ADD_UW::toString() const {
+    std::stringstream ss;
+    ss << "add.uw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool ADD_UW::isJump() const {
+    return false; // ADD_UW is not a jump instruction
+}
+
+uint64_t ADD_UW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SH1ADD::SH1ADD(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void SH1ADD::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs2) + (rf.read(rs1) << 1));
+}
+
+std::string SH1ADD::toString() const {
+    std::stringstream ss;
+    ss << "sh1add x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool SH1ADD::isJump() const {
+    return false; // SH1ADD is not a jump instruction
+}
+
+uint64_t SH1ADD::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SH2ADD::SH2ADD(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void SH2ADD::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs2) + (rf.read(rs1) << 2));
+}
+
+std::string SH2ADD::toString() const {
+    std::stringstream ss;
+    ss << "sh2add x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool SH2ADD::isJump() const {
+    return false; // SH2ADD is not a jump instruction
+}
+
+uint64_t SH2ADD::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SH3ADD::SH3ADD(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void SH3ADD::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs2) + (rf.read(rs1) << 3));
+}
+
+std::string SH3ADD::toString() const {
+    std::stringstream ss;
+    ss << "sh3add x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool SH3ADD::isJump() const {
+    return false; // SH3ADD is not a jump instruction
+}
+
+uint64_t SH3ADD::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SH1ADD_UW::SH1ADD_UW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void SH1ADD_UW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs2) + ((rf.read(rs1) & 0xFFFFFFFF) << 1));
+}
+
+std::string SH1ADD_UW::toString() const {
+    std::stringstream ss;
+    ss << "sh1add.uw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool SH1ADD_UW::isJump() const {
+    return false; // SH1ADD_UW is not a jump instruction
+}
+
+uint64_t SH1ADD_UW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SH2ADD_UW::SH2ADD_UW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void SH2ADD_UW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs2) + ((rf.read(rs1) & 0xFFFFFFFF) << 2));
+}
+
+std::string SH2ADD_UW::toString() const {
+    std::stringstream ss;
+    ss << "sh2add.uw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool SH2ADD_UW::isJump() const {
+    return false; // SH2ADD_UW is not a jump instruction
+}
+
+uint64_t SH2ADD_UW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SH3ADD_UW::SH3ADD_UW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void SH3ADD_UW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs2) + ((rf.read(rs1) & 0xFFFFFFFF) << 3));
+}
+
+std::string SH3ADD_UW::toString() const {
+    std::stringstream ss;
+    ss << "sh3add.uw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool SH3ADD_UW::isJump() const {
+    return false; // SH3ADD_UW is not a jump instruction
+}
+
+uint64_t SH3ADD_UW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SLLI_UW::SLLI_UW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = (machineCode >> 20) & 0x3F;
+}
+
+void SLLI_UW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, (rf.read(rs1) & 0xFFFFFFFF) << imm);
+}
+
+std::string SLLI_UW::toString() const {
+    std::stringstream ss;
+    ss << "slli.uw x" << rd << ", x" << rs1 << ", " << imm;
+    return ss.str();
+}
+
+bool SLLI_UW::isJump() const {
+    return false; // SLLI_UW is not a jump instruction
+}
+
+uint64_t SLLI_UW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+ANDN::ANDN(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void ANDN::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs1) & ~rf.read(rs2));
+}
+
+std::string ANDN::toString() const {
+    std::stringstream ss;
+    ss << "andn x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool ANDN::isJump() const {
+    return false; // ANDN is not a jump instruction
+}
+
+uint64_t ANDN::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+ORN::ORN(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void ORN::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs1) | ~rf.read(rs2));
+}
+
+std::string ORN::toString() const {
+    std::stringstream ss;
+    ss << "orn x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool ORN::isJump() const {
+    return false; // ORN is not a jump instruction
+}
+
+uint64_t ORN::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+XNOR::XNOR(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void XNOR::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, ~(rf.read(rs1) ^ rf.read(rs2)));
+}
+
+std::string XNOR::toString() const {
+    std::stringstream ss;
+    ss << "xnor x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool XNOR::isJump() const {
+    return false; // XNOR is not a jump instruction
+}
+
+uint64_t XNOR::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CLZ::CLZ(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void CLZ::execute(RegisterFile& rf, Memory& /* mem */) {
+    // __builtin_clzll is undefined for zero
+    uint64_t value = rf.read(rs1);
+    rf.write(rd, value == 0 ? 64 : __builtin_clzll(value));
+}
+
+std::string CLZ::toString() const {
+    std::stringstream ss;
+    ss << "clz x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool CLZ::isJump() const {
+    return false; // CLZ is not a jump instruction
+}
+
+uint64_t CLZ::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CLZW::CLZW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void CLZW::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint32_t value = static_cast<uint32_t>(rf.read(rs1));
+    rf.write(rd, value == 0 ? 32 : __builtin_clz(value));
+}
+
+std::string CLZW::toString() const {
+    std::stringstream ss;
+    ss << "clzw x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool CLZW::isJump() const {
+    return false; // CLZW is not a jump instruction
+}
+
+uint64_t CLZW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CTZ::CTZ(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void CTZ::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t value = rf.read(rs1);
+    rf.write(rd, value == 0 ? 64 : __builtin_ctzll(value));
+}
+
+std::string CTZ::toString() const {
+    std::stringstream ss;
+    ss << "ctz x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool CTZ::isJump() const {
+    return false; // CTZ is not a jump instruction
+}
+
+uint64_t CTZ::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CTZW::CTZW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void CTZW::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint32_t value = static_cast<uint32_t>(rf.read(rs1));
+    rf.write(rd, value == 0 ? 32 : __builtin_ctz(value));
+}
+
+std::string CTZW::toString() const {
+    std::stringstream ss;
+    ss << "ctzw x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool CTZW::isJump() const {
+    return false; // CTZW is not a jump instruction
+}
+
+uint64_t CTZW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CPOP::CPOP(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void CPOP::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, __builtin_popcountll(rf.read(rs1)));
+}
+
+std::string CPOP::toString() const {
+    std::stringstream ss;
+    ss << "cpop x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool CPOP::isJump() const {
+    return false; // CPOP is not a jump instruction
+}
+
+uint64_t CPOP::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CPOPW::CPOPW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void CPOPW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, __builtin_popcount(static_cast<uint32_t>(rf.read(rs1))));
+}
+
+std::string CPOPW::toString() const {
+    std::stringstream ss;
+    ss << "cpopw x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool CPOPW::isJump() const {
+    return false; // CPOPW is not a jump instruction
+}
+
+uint64_t CPOPW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+MAX::MAX(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void MAX::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, std::max(static_cast<int64_t>(rf.read(rs1)), static_cast<int64_t>(rf.read(rs2))));
+}
+
+std::string MAX::toString() const {
+    std::stringstream ss;
+    ss << "max x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool MAX::isJump() const {
+    return false; // MAX is not a jump instruction
+}
+
+uint64_t MAX::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+MAXU::MAXU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void MAXU::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, std::max(rf.read(rs1), rf.read(rs2)));
+}
+
+std::string MAXU::toString() const {
+    std::stringstream ss;
+    ss << "maxu x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool MAXU::isJump() const {
+    return false; // MAXU is not a jump instruction
+}
+
+uint64_t MAXU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+MIN::MIN(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void MIN::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, std::min(static_cast<int64_t>(rf.read(rs1)), static_cast<int64_t>(rf.read(rs2))));
+}
+
+std::string MIN::toString() const {
+    std::stringstream ss;
+    ss << "min x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool MIN::isJump() const {
+    return false; // MIN is not a jump instruction
+}
+
+uint64_t MIN::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+MINU::MINU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void MINU::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, std::min(rf.read(rs1), rf.read(rs2)));
+}
+
+std::string MINU::toString() const {
+    std::stringstream ss;
+    ss << "minu x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool MINU::isJump() const {
+    return false; // MINU is not a jump instruction
+}
+
+uint64_t MINU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SEXT_B::SEXT_B(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void SEXT_B::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<int64_t>(static_cast<int8_t>(rf.read(rs1))));
+}
+
+std::string SEXT_B::toString() const {
+    std::stringstream ss;
+    ss << "sext.b x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool SEXT_B::isJump() const {
+    return false; // SEXT_B is not a jump instruction
+}
+
+uint64_t SEXT_B::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+SEXT_H::SEXT_H(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void SEXT_H::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<int64_t>(static_cast<int16_t>(rf.read(rs1))));
+}
+
+std::string SEXT_H::toString() const {
+    std::stringstream ss;
+    ss << "sext.h x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool SEXT_H::isJump() const {
+    return false; // SEXT_H is not a jump instruction
+}
+
+uint64_t SEXT_H::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+ZEXT_H::ZEXT_H(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void ZEXT_H::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs1) & 0xFFFF);
+}
+
+std::string ZEXT_H::toString() const {
+    std::stringstream ss;
+    ss << "zext.h x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool ZEXT_H::isJump() const {
+    return false; // ZEXT_H is not a jump instruction
+}
+
+uint64_t ZEXT_H::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+ROL::ROL(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void ROL::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rotateLeft(rf.read(rs1), rf.read(rs2) & 0x3F));
+}
+
+std::string ROL::toString() const {
+    std::stringstream ss;
+    ss << "rol x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool ROL::isJump() const {
+    return false; // ROL is not a jump instruction
+}
+
+uint64_t ROL::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+ROLW::ROLW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void ROLW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, signExtend(rotateLeft32(static_cast<uint32_t>(rf.read(rs1)), rf.read(rs2) & 0x1F), 32));
+}
+
+std::string ROLW::toString() const {
+    std::stringstream ss;
+    ss << "rolw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool ROLW::isJump() const {
+    return false; // ROLW is not a jump instruction
+}
+
+uint64_t ROLW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+ROR::ROR(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void ROR::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rotateLeft(rf.read(rs1), -rf.read(rs2) & 0x3F));
+}
+
+std::string ROR::toString() const {
+    std::stringstream ss;
+    ss << "ror x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool ROR::isJump() const {
+    return false; // ROR is not a jump instruction
+}
+
+uint64_t ROR::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+RORI::RORI(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = (machineCode >> 20) & 0x3F;
+}
+
+void RORI::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rotateLeft(rf.read(rs1), -imm & 0x3F));
+}
+
+std::string RORI::toString() const {
+    std::stringstream ss;
+    ss << "rori x" << rd << ", x" << rs1 << ", " << imm;
+    return ss.str();
+}
+
+bool RORI::isJump() const {
+    return false; // RORI is not a jump instruction
+}
+
+uint64_t RORI::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+RORIW::RORIW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = (machineCode >> 20) & 0x1F;
+}
+
+void RORIW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, signExtend(rotateLeft32(static_cast<uint32_t>(rf.read(rs1)), -imm & 0x1F), 32));
+}
+
+std::string RORIW::toString() const {
+    std::stringstream ss;
+    ss << "roriw x" << rd << ", x" << rs1 << ", " << imm;
+    return ss.str();
+}
+
+bool RORIW::isJump() const {
+    return false; // RORIW is not a jump instruction
+}
+
+uint64_t RORIW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+RORW::RORW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void RORW::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, signExtend(rotateLeft32(static_cast<uint32_t>(rf.read(rs1)), -rf.read(rs2) & 0x1F), 32));
+}
+
+std::string RORW::toString() const {
+    std::stringstream ss;
+    ss << "rorw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool RORW::isJump() const {
+    return false; // RORW is not a jump instruction
+}
+
+uint64_t RORW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+ORC_B::ORC_B(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void ORC_B::execute(RegisterFile& rf, Memory& /* mem */) {
+    // The high bit of each byte of nonzero is set iff the byte is nonzero
+    uint64_t value = rf.read(rs1);
+    uint64_t nonzero = ((value & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | value;
+    rf.write(rd, ((nonzero >> 7) & 0x0101010101010101ULL) * 0xFF);
+}
+
+std::string ORC_B::toString() const {
+    std::stringstream ss;
+    ss << "orc.b x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool ORC_B::isJump() const {
+    return false; // ORC_B is not a jump instruction
+}
+
+uint64_t ORC_B::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+REV8::REV8(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+}
+
+void REV8::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, __builtin_bswap64(rf.read(rs1)));
+}
+
+std::string REV8::toString() const {
+    std::stringstream ss;
+    ss << "rev8 x" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool REV8::isJump() const {
+    return false; // REV8 is not a jump instruction
+}
+
+uint64_t REV8::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
@@ -0,0 +1,144 @@
+#include "../include/call_graph.h"
+#include <algorithm>
+#include <iomanip>
+
+void CallGraph::reset(size_t instructions, const std::string& rootName, int rootLine) {
+    functions.clear();
+    functionAt.assign(instructions, 0);
+    edges.clear();
+    edgeIds.clear();
+    stack.clear();
+    clock = 0;
+
+    functions.push_back({rootName, rootLine, 0, 0, 1, 1});
+    if (!functionAt.empty()) {
+        functionAt[0] = 1;
+    }
+    stack.push_back({0, -1, 0, 0});
+}
+
+void CallGraph::addFunction(size_t entry, const std::string& name, int line) {
+    functions.push_back({name, line, 0, 0, 0, 0});
+    functionAt[entry] = static_cast<int>(functions.size());
+}
+
+void CallGraph::call(size_t callSite, int callSiteLine, size_t entry) {
+    int callee = functionAt[entry] - 1;
+    int caller = stack.back().function;
+
+    auto key = std::make_tuple(caller, callee, callSite);
+    auto it = edgeIds.find(key);
+    int edge;
+    if (it == edgeIds.end()) {
+        edge = static_cast<int>(edges.size());
+        edges.push_back({caller, callee, callSiteLine, 0, 0});
+        edgeIds[key] = edge;
+    } else {
+        edge = it->second;
+    }
+
+    edges[edge].calls++;
+    functions[callee].calls++;
+    functions[callee].active++;
+    stack.push_back({callee, edge, clock, 0});
+}
+
+void CallGraph::ret() {
+    // A return from the root frame ends nothing
+    if (stack.size() <= 1) {
+        return;
+    }
+    Frame frame = stack.back();
+    stack.pop_back();
+
+    uint64_t inclusive = clock - frame.start;
+    Function& f = functions[frame.function];
+    f.exclusive += inclusive - frame.children;
+    if (--f.active == 0) {
+        f.inclusive += inclusive;
+    }
+    edges[frame.edge].inclusive += inclusive;
+    stack.back().children += inclusive;
+}
+
+void CallGraph::settle(std::vector<Function>& functionTotals, std::vector<Edge>& edgeTotals) const {
+    functionTotals = functions;
+    edgeTotals = edges;
+    uint64_t children = 0;
+    for (size_t i = stack.size(); i-- > 0;) {
+        const Frame& frame = stack[i];
+        uint64_t inclusive = clock - frame.start;
+        Function& f = functionTotals[frame.function];
+        f.exclusive += inclusive - frame.children - children;
+        if (--f.active == 0) {
+            f.inclusive += inclusive;
+        }
+        if (frame.edge >= 0) {
+            edgeTotals[frame.edge].inclusive += inclusive;
+        }
+        // The frame below has this one as an unreturned child
+        children = inclusive;
+    }
+}
+
+void CallGraph::report(std::ostream& out) const {
+    std::vector<Function> totals;
+    std::vector<Edge> edgeTotals;
+    settle(totals, edgeTotals);
+
+    std::vector<size_t> order(totals.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&totals](size_t a, size_t b) {
+        return totals[a].inclusive > totals[b].inclusive;
+    });
+
+    char fill = out.fill(' ');
+    std::ios::fmtflags flags = out.flags();
+    out << std::dec << "Call graph: " << clock << " instructions" << std::endl;
+    out << std::setw(14) << "inclusive" << std::setw(14) << "exclusive" << std::setw(10) << "calls"
+        << "  function" << std::endl;
+    for (size_t i : order) {
+        const Function& f = totals[i];
+        out << std::setw(14) << f.inclusive << std::setw(14) << f.exclusive << std::setw(10) << f.calls
+            << "  " << f.name << std::endl;
+        for (const Edge& e : edgeTotals) {
+            if (e.caller == static_cast<int>(i)) {
+                out << std::setw(38) << e.calls << "    -> " << totals[e.callee].name << " (line "
+                    << e.callSiteLine << ", " << e.inclusive << " inclusive)" << std::endl;
+            }
+        }
+    }
+    out.flags(flags);
+    out.fill(fill);
+}
+
+void CallGraph::writeCallgrind(std::ostream& out, const std::string& source) const {
+    std::vector<Function> totals;
+    std::vector<Edge> edgeTotals;
+    settle(totals, edgeTotals);
+
+    // Exclusive cost sits on the entry line of each function, since
+    // costs are measured per activation rather than per instruction
+    out << std::dec << "# callgrind format" << std::endl;
+    out << "version: 1" << std::endl;
+    out << "creator: riscv-simulator" << std::endl;
+    out << "positions: line" << std::endl;
+    out << "events: Instructions" << std::endl;
+    out << "summary: " << clock << std::endl;
+    out << std::endl;
+    out << "fl=" << source << std::endl;
+    for (size_t i = 0; i < totals.size(); ++i) {
+        const Function& f = totals[i];
+        out << std::endl << "fn=" << f.name << std::endl;
+        out << f.line << " " << f.exclusive << std::endl;
+        for (const Edge& e : edgeTotals) {
+            if (e.caller == static_cast<int>(i)) {
+                out << "cfn=" << totals[e.callee].name << std::endl;
+                out << "calls=" << e.calls << " " << totals[e.callee].line << std::endl;
+                out << e.callSiteLine << " " << e.inclusive << std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include "../include/event_stream.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+const size_t EventStream::BATCH_EVENTS;
+const size_t EventStream::DEFAULT_RING_BATCHES;
+
+EventStream::~EventStream() {
+    for (auto& consumer : consumers) {
+        consumer->stopping.store(true, std::memory_order_release);
+        consumer->worker.join();
+    }
+}
+
+void EventStream::addConsumer(std::unique_ptr<EventConsumer> analysis, Policy policy, size_t ringBatches) {
+    // Events batched so far belong to the consumers already running
+    flush();
+    consumers.emplace_back(new Consumer(std::move(analysis), policy, std::max<size_t>(ringBatches, 1)));
+    Consumer& consumer = *consumers.back();
+    consumer.worker = std::thread(run, std::ref(consumer));
+}
+
+void EventStream::run(Consumer& consumer) {
+    unsigned idle = 0;
+    while (true) {
+        const Batch* next = consumer.ring.front();
+        if (next) {
+            consumer.analysis->consume(next->events, next->count);
+            consumer.consumed.fetch_add(next->count, std::memory_order_relaxed);
+            consumer.ring.pop();
+            idle = 0;
+        } else if (consumer.stopping.load(std::memory_order_acquire)) {
+            // stopping is set after the last publish, so an empty ring now stays empty
+            if (!consumer.ring.front()) {
+                return;
+            }
+        } else if (++idle < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+void EventStream::flush() {
+    if (batch.count == 0) {
+        return;
+    }
+    for (auto& c : consumers) {
+        Consumer& consumer = *c;
+        Batch* slot = consumer.ring.claim();
+        if (!slot && consumer.policy == DROP) {
+            consumer.dropped += batch.count;
+            continue;
+        }
+        while (!slot) {
+            std::this_thread::yield();
+            slot = consumer.ring.claim();
+        }
+        slot->count = batch.count;
+        std::copy(batch.events, batch.events + batch.count, slot->events);
+        consumer.ring.publish();
+        consumer.published += batch.count;
+        uint64_t lag = consumer.published - consumer.consumed.load(std::memory_order_relaxed);
+        consumer.maxLag = std::max(consumer.maxLag, lag);
+    }
+    batch.count = 0;
+}
+
+void EventStream::printStats(std::ostream& out) const {
+    if (consumers.empty()) {
+        out << "No stream consumers." << std::endl;
+        return;
+    }
+    char fill = out.fill(' ');
+    out << std::dec << std::left << std::setw(16) << "consumer" << std::right << std::setw(7) << "policy"
+        << std::setw(14) << "published" << std::setw(14) << "consumed" << std::setw(12) << "dropped"
+        << std::setw(10) << "lag" << std::setw(10) << "max lag" << std::endl;
+    for (const auto& c : consumers) {
+        uint64_t consumed = c->consumed.load(std::memory_order_relaxed);
+        out << std::left << std::setw(16) << c->analysis->name() << std::right << std::setw(7)
+            << (c->policy == DROP ? "drop" : "block") << std::setw(14) << c->published << std::setw(14) << consumed
+            << std::setw(12) << c->dropped << std::setw(10) << c->published - consumed << std::setw(10)
+            << c->maxLag << std::endl;
+    }
+    out.fill(fill);
+}
+
+void EventStream::stop(std::ostream& out) {
+    flush();
+    for (auto& consumer : consumers) {
+        consumer->stopping.store(true, std::memory_order_release);
+    }
+    for (auto& consumer : consumers) {
+        consumer->worker.join();
+    }
+    printStats(out);
+    for (const auto& consumer : consumers) {
+        consumer->analysis->report(out);
+    }
+    consumers.clear();
+}
@@ -0,0 +1,1901 @@
+#include "../include/instruction.h"
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+// F and D extensions. Arithmetic runs on the host FPU. In round-to-nearest-
+// even, the host's own mode and what compilers use, an instruction is one
+// host operation and its exception flags come from the host status word.
+// The other rounding modes evaluate in a wider host format with
+// round-to-odd and round to the target format in software, so the host
+// rounding mode is only ever touched for those rare instructions.
+
+namespace {
+
+enum RoundingMode { RNE, RTZ, RDN, RUP, RMM, DYN = 7 };
+
+// fflags bits of fcsr
+const uint64_t FLAG_NX = 0x01;
+const uint64_t FLAG_UF = 0x02;
+const uint64_t FLAG_OF = 0x04;
+const uint64_t FLAG_DZ = 0x08;
+const uint64_t FLAG_NV = 0x10;
+
+const char* const ROUNDING_NAMES[8] = {"rne", "rtz", "rdn", "rup", "rmm", "", "", "dyn"};
+
+template <typename T> struct FloatFormat;
+
+template <> struct FloatFormat<float> {
+    typedef uint32_t Bits;
+    typedef double Wide; // Exact for every float operand, with room for round-to-odd
+    static const Bits CANONICAL_NAN = 0x7FC00000;
+    static const Bits SIGNALING_BIT = 0x00400000;
+};
+
+template <> struct FloatFormat<double> {
+    typedef uint64_t Bits;
+    typedef long double Wide;
+    static const Bits CANONICAL_NAN = 0x7FF8000000000000ULL;
+    static const Bits SIGNALING_BIT = 0x0008000000000000ULL;
+};
+
+static_assert(std::numeric_limits<long double>::digits >= std::numeric_limits<double>::digits + 2,
+              "Directed rounding of doubles needs a wider long double");
+
+template <typename T>
+typename FloatFormat<T>::Bits toBits(T value) {
+    typename FloatFormat<T>::Bits bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+T fromBits(typename FloatFormat<T>::Bits bits) {
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Raw register contents; a single that is not NaN-boxed reads as the canonical NaN
+template <typename T>
+typename FloatFormat<T>::Bits readBits(const RegisterFile& rf, int reg);
+
+template <>
+uint32_t readBits<float>(const RegisterFile& rf, int reg) {
+    uint64_t bits = rf.read(RegisterFile::F0 + reg);
+    return (bits >> 32) == 0xFFFFFFFF ? static_cast<uint32_t>(bits) : FloatFormat<float>::CANONICAL_NAN;
+}
+
+template <>
+uint64_t readBits<double>(const RegisterFile& rf, int reg) {
+    return rf.read(RegisterFile::F0 + reg);
+}
+
+void writeBits(RegisterFile& rf, int reg, uint32_t bits) {
+    rf.write(RegisterFile::F0 + reg, 0xFFFFFFFF00000000ULL | bits);
+}
+
+void writeBits(RegisterFile& rf, int reg, uint64_t bits) {
+    rf.write(RegisterFile::F0 + reg, bits);
+}
+
+template <typename T>
+T readFloat(const RegisterFile& rf, int reg) {
+    return fromBits<T>(readBits<T>(rf, reg));
+}
+
+// Arithmetic results: every NaN becomes the canonical NaN
+template <typename T>
+void writeFloat(RegisterFile& rf, int reg, T value) {
+    writeBits(rf, reg, std::isnan(value) ? FloatFormat<T>::CANONICAL_NAN : toBits(value));
+}
+
+template <typename T>
+bool isSignaling(T value) {
+    return std::isnan(value) && !(toBits(value) & FloatFormat<T>::SIGNALING_BIT);
+}
+
+bool signalingOperand(float value) {
+    return isSignaling(value);
+}
+
+bool signalingOperand(double value) {
+    return isSignaling(value);
+}
+
+// Integer operands of conversions
+template <typename I>
+bool signalingOperand(I) {
+    return false;
+}
+
+bool anySignaling() {
+    return false;
+}
+
+template <typename T, typename... Rest>
+bool anySignaling(T first, Rest... rest) {
+    return signalingOperand(first) || anySignaling(rest...);
+}
+
+void raiseFlags(RegisterFile& rf, uint64_t flags) {
+    uint64_t fcsr = rf.read(RegisterFile::FCSR);
+    if ((fcsr | flags) != fcsr) {
+        rf.write(RegisterFile::FCSR, fcsr | flags);
+    }
+}
+
+uint64_t hostFlags(int raised) {
+    return (raised & FE_INEXACT ? FLAG_NX : 0) | (raised & FE_UNDERFLOW ? FLAG_UF : 0) |
+           (raised & FE_OVERFLOW ? FLAG_OF : 0) | (raised & FE_DIVBYZERO ? FLAG_DZ : 0) |
+           (raised & FE_INVALID ? FLAG_NV : 0);
+}
+
+// Keeps the compiler from moving arithmetic across the fenv calls around it
+template <typename T>
+void fenvBarrier(T& value) {
+    asm volatile("" : "+m"(value));
+}
+
+int roundingMode(const RegisterFile& rf, uint32_t machineCode) {
+    int rm = (machineCode >> 12) & 0x7;
+    if (rm == DYN) {
+        rm = (rf.read(RegisterFile::FCSR) >> 5) & 0x7;
+    }
+    if (rm > RMM) {
+        throw std::runtime_error("Invalid rounding mode");
+    }
+    return rm;
+}
+
+// Rounds a finite wide value, already rounded to odd, to T in mode rm.
+// Tininess is detected after rounding, as RISC-V requires.
+template <typename T, typename W>
+T roundTo(W value, int rm, uint64_t& flags) {
+    if (std::isnan(value)) {
+        return std::numeric_limits<T>::quiet_NaN();
+    }
+    if (std::isinf(value) || value == 0) {
+        return static_cast<T>(value);
+    }
+    const int digits = std::numeric_limits<T>::digits;
+    const int minExponent = std::numeric_limits<T>::min_exponent - 1;
+    bool negative = std::signbit(value);
+    W magnitude = std::fabs(value);
+    int exponent = std::ilogb(magnitude);
+
+    // Rounds magnitude to a multiple of 2^quantum
+    bool inexact = false;
+    auto roundAt = [&](int quantum) {
+        W scaled = std::ldexp(magnitude, -quantum);
+        W whole = std::trunc(scaled);
+        W fraction = scaled - whole;
+        inexact = fraction != 0;
+        bool up = false;
+        switch (rm) {
+            case RNE: up = fraction > 0.5 || (fraction == 0.5 && std::fmod(whole, 2) != 0); break;
+            case RTZ: break;
+            case RDN: up = inexact && negative; break;
+            case RUP: up = inexact && !negative; break;
+            case RMM: up = fraction >= 0.5; break;
+        }
+        return std::ldexp(whole + (up ? 1 : 0), quantum);
+    };
+
+    bool tiny = false;
+    if (exponent < minExponent) {
+        tiny = roundAt(exponent - (digits - 1)) < std::numeric_limits<T>::min();
+    }
+    W rounded = roundAt(std::max(exponent, minExponent) - (digits - 1));
+    if (inexact) {
+        flags |= FLAG_NX | (tiny ? FLAG_UF : 0);
+    }
+    if (rounded > std::numeric_limits<T>::max()) {
+        flags |= FLAG_OF | FLAG_NX;
+        bool toInfinity = rm == RNE || rm == RMM || (rm == RDN && negative) || (rm == RUP && !negative);
+        rounded = toInfinity ? std::numeric_limits<W>::infinity() : std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(negative ? -rounded : rounded);
+}
+
+// Evaluates op on the operands, rounded to T in the instruction's rounding
+// mode, and accrues the exception flags it raises in fcsr. op is generic
+// so it can run in T or in the wide format.
+template <typename T, typename Op, typename... Args>
+T evaluate(RegisterFile& rf, int rm, Op op, Args... args) {
+    uint64_t flags = anySignaling(args...) ? FLAG_NV : 0;
+    if (rm == RNE) {
+        std::feclearexcept(FE_ALL_EXCEPT);
+        int order[] = {0, (fenvBarrier(args), 0)...};
+        (void)order;
+        T result = op(static_cast<T>(args)...);
+        fenvBarrier(result);
+        raiseFlags(rf, flags | hostFlags(std::fetestexcept(FE_ALL_EXCEPT)));
+        return result;
+    }
+
+    // Truncate in the wide format and keep a sticky last bit when inexact:
+    // the result is then rounded to odd, which a second rounding to T in
+    // any mode turns into the correctly rounded result
+    typedef typename FloatFormat<T>::Wide W;
+    int hostMode = std::fegetround();
+    std::fesetround(FE_TOWARDZERO);
+    std::feclearexcept(FE_ALL_EXCEPT);
+    int order[] = {0, (fenvBarrier(args), 0)...};
+    (void)order;
+    W wide = op(static_cast<W>(args)...);
+    fenvBarrier(wide);
+    int raised = std::fetestexcept(FE_ALL_EXCEPT);
+    std::fesetround(hostMode);
+
+    flags |= hostFlags(raised & (FE_INVALID | FE_DIVBYZERO));
+    if ((raised & FE_INEXACT) && std::isfinite(wide) && wide != 0) {
+        int exponent;
+        W units = std::ldexp(std::frexp(wide, &exponent), std::numeric_limits<W>::digits);
+        if (std::fmod(units, 2) == 0) {
+            wide = std::nextafter(wide, std::signbit(wide) ? -std::numeric_limits<W>::infinity()
+                                                           : std::numeric_limits<W>::infinity());
+        }
+    }
+    T result = roundTo<T>(wide, rm, flags);
+    raiseFlags(rf, flags);
+    return result;
+}
+
+// Float to integer conversion, saturating out-of-range values and NaNs
+template <typename I, typename T>
+I convertToInteger(RegisterFile& rf, T value, int rm) {
+    const T limit = std::ldexp(static_cast<T>(1), std::numeric_limits<I>::digits); // Smallest value too large
+    T rounded;
+    switch (rm) {
+        case RTZ: rounded = std::trunc(value); break;
+        case RDN: rounded = std::floor(value); break;
+        case RUP: rounded = std::ceil(value); break;
+        case RMM: rounded = std::round(value); break;
+        default: rounded = std::nearbyint(value); break;
+    }
+    if (std::isnan(value) || rounded >= limit) {
+        raiseFlags(rf, FLAG_NV);
+        return std::numeric_limits<I>::max();
+    }
+    if (rounded < static_cast<T>(std::numeric_limits<I>::min())) {
+        raiseFlags(rf, FLAG_NV);
+        return std::numeric_limits<I>::min();
+    }
+    if (rounded != value) {
+        raiseFlags(rf, FLAG_NX);
+    }
+    return static_cast<I>(rounded);
+}
+
+template <typename T>
+T minimum(RegisterFile& rf, T a, T b, bool maximum) {
+    if (isSignaling(a) || isSignaling(b)) {
+        raiseFlags(rf, FLAG_NV);
+    }
+    if (std::isnan(a) && std::isnan(b)) {
+        return fromBits<T>(FloatFormat<T>::CANONICAL_NAN);
+    }
+    if (std::isnan(a)) return b;
+    if (std::isnan(b)) return a;
+    if (a == b) {
+        // -0.0 orders below +0.0
+        return std::signbit(a) != maximum ? a : b;
+    }
+    return (a < b) != maximum ? a : b;
+}
+
+// Ordered comparisons (flt, fle) signal on any NaN, feq only on signaling ones
+template <typename T>
+bool unordered(RegisterFile& rf, T a, T b, bool quiet) {
+    if (std::isnan(a) || std::isnan(b)) {
+        if (!quiet || isSignaling(a) || isSignaling(b)) {
+            raiseFlags(rf, FLAG_NV);
+        }
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+uint64_t classify(T value) {
+    bool negative = std::signbit(value);
+    switch (std::fpclassify(value)) {
+        case FP_INFINITE: return negative ? 1 << 0 : 1 << 7;
+        case FP_NORMAL: return negative ? 1 << 1 : 1 << 6;
+        case FP_SUBNORMAL: return negative ? 1 << 2 : 1 << 5;
+        case FP_ZERO: return negative ? 1 << 3 : 1 << 4;
+        default: return isSignaling(value) ? 1 << 8 : 1 << 9;
+    }
+}
+
+template <typename Bits>
+Bits injectSign(Bits a, Bits b, int funct3) {
+    const Bits sign = static_cast<Bits>(1) << (sizeof(Bits) * 8 - 1);
+    switch (funct3) {
+        case 0x0: return (a & ~sign) | (b & sign);  // fsgnj
+        case 0x1: return (a & ~sign) | (~b & sign); // fsgnjn
+        default: return a ^ (b & sign);             // fsgnjx
+    }
+}
+
+std::string roundingSuffix(uint32_t machineCode) {
+    int rm = (machineCode >> 12) & 0x7;
+    return rm == DYN ? "" : std::string(", ") + ROUNDING_NAMES[rm];
+}
+
+} // namespace
+
+FLW::FLW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = signExtend(machineCode >> 20, 12);
+}
+
+void FLW::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1) + imm;
+    writeBits(rf, rd, mem.read32(addr));
+}
+
+std::string FLW::toString() const {
+    std::stringstream ss;
+    ss << "flw f" << rd << ", " << imm << "(x" << rs1 << ")";
+    return ss.str();
+}
+
+bool FLW::isJump() const {
+    return false; // FLW is not a jump instruction
+}
+
+uint64_t FLW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSW::FSW(uint32_t machineCode) : Instruction(machineCode) {
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(((machineCode >> 7) & 0x1F) | ((machineCode >> 25) << 5), 12);
+}
+
+void FSW::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1) + imm;
+    mem.write32(addr, static_cast<uint32_t>(rf.read(RegisterFile::F0 + rs2)));
+}
+
+std::string FSW::toString() const {
+    std::stringstream ss;
+    ss << "fsw f" << rs2 << ", " << imm << "(x" << rs1 << ")";
+    return ss.str();
+}
+
+bool FSW::isJump() const {
+    return false; // FSW is not a jump instruction
+}
+
+uint64_t FSW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FLD::FLD(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = signExtend(machineCode >> 20, 12);
+}
+
+void FLD::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1) + imm;
+    writeBits(rf, rd, mem.read64(addr));
+}
+
+std::string FLD::toString() const {
+    std::stringstream ss;
+    ss << "fld f" << rd << ", " << imm << "(x" << rs1 << ")";
+    return ss.str();
+}
+
+bool FLD::isJump() const {
+    return false; // FLD is not a jump instruction
+}
+
+uint64_t FLD::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSD::FSD(uint32_t machineCode) : Instruction(machineCode) {
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(((machineCode >> 7) & 0x1F) | ((machineCode >> 25) << 5), 12);
+}
+
+void FSD::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1) + imm;
+    mem.write64(addr, rf.read(RegisterFile::F0 + rs2));
+}
+
+std::string FSD::toString() const {
+    std::stringstream ss;
+    ss << "fsd f" << rs2 << ", " << imm << "(x" << rs1 << ")";
+    return ss.str();
+}
+
+bool FSD::isJump() const {
+    return false; // FSD is not a jump instruction
+}
+
+uint64_t FSD::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMADD_S::FMADD_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMADD_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    float c = readFloat<float>(rf, rs3);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, a, b, c));
+}
+
+std::string FMADD_S::toString() const {
+    std::stringstream ss;
+    ss << "fmadd.s f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FMADD_S::isJump() const {
+    return false; // FMADD_S is not a jump instruction
+}
+
+uint64_t FMADD_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMSUB_S::FMSUB_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMSUB_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    float c = readFloat<float>(rf, rs3);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, a, b, -c));
+}
+
+std::string FMSUB_S::toString() const {
+    std::stringstream ss;
+    ss << "fmsub.s f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FMSUB_S::isJump() const {
+    return false; // FMSUB_S is not a jump instruction
+}
+
+uint64_t FMSUB_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FNMSUB_S::FNMSUB_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FNMSUB_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    float c = readFloat<float>(rf, rs3);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, -a, b, c));
+}
+
+std::string FNMSUB_S::toString() const {
+    std::stringstream ss;
+    ss << "fnmsub.s f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FNMSUB_S::isJump() const {
+    return false; // FNMSUB_S is not a jump instruction
+}
+
+uint64_t FNMSUB_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FNMADD_S::FNMADD_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FNMADD_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    float c = readFloat<float>(rf, rs3);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, -a, b, -c));
+}
+
+std::string FNMADD_S::toString() const {
+    std::stringstream ss;
+    ss << "fnmadd.s f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FNMADD_S::isJump() const {
+    return false; // FNMADD_S is not a jump instruction
+}
+
+uint64_t FNMADD_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FADD_S::FADD_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FADD_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x + y; }, a, b));
+}
+
+std::string FADD_S::toString() const {
+    std::stringstream ss;
+    ss << "fadd.s f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FADD_S::isJump() const {
+    return false; // FADD_S is not a jump instruction
+}
+
+uint64_t FADD_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSUB_S::FSUB_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSUB_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x - y; }, a, b));
+}
+
+std::string FSUB_S::toString() const {
+    std::stringstream ss;
+    ss << "fsub.s f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FSUB_S::isJump() const {
+    return false; // FSUB_S is not a jump instruction
+}
+
+uint64_t FSUB_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMUL_S::FMUL_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMUL_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x * y; }, a, b));
+}
+
+std::string FMUL_S::toString() const {
+    std::stringstream ss;
+    ss << "fmul.s f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FMUL_S::isJump() const {
+    return false; // FMUL_S is not a jump instruction
+}
+
+uint64_t FMUL_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FDIV_S::FDIV_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FDIV_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x / y; }, a, b));
+}
+
+std::string FDIV_S::toString() const {
+    std::stringstream ss;
+    ss << "fdiv.s f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FDIV_S::isJump() const {
+    return false; // FDIV_S is not a jump instruction
+}
+
+uint64_t FDIV_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSQRT_S::FSQRT_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSQRT_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x) { return std::sqrt(x); }, a));
+}
+
+std::string FSQRT_S::toString() const {
+    std::stringstream ss;
+    ss << "fsqrt.s f" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FSQRT_S::isJump() const {
+    return false; // FSQRT_S is not a jump instruction
+}
+
+uint64_t FSQRT_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSGNJ_S::FSGNJ_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSGNJ_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, injectSign(readBits<float>(rf, rs1), readBits<float>(rf, rs2), (machineCode >> 12) & 0x7));
+}
+
+std::string FSGNJ_S::toString() const {
+    std::stringstream ss;
+    ss << "fsgnj.s f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FSGNJ_S::isJump() const {
+    return false; // FSGNJ_S is not a jump instruction
+}
+
+uint64_t FSGNJ_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSGNJN_S::FSGNJN_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSGNJN_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, injectSign(readBits<float>(rf, rs1), readBits<float>(rf, rs2), (machineCode >> 12) & 0x7));
+}
+
+std::string FSGNJN_S::toString() const {
+    std::stringstream ss;
+    ss << "fsgnjn.s f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FSGNJN_S::isJump() const {
+    return false; // FSGNJN_S is not a jump instruction
+}
+
+uint64_t FSGNJN_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSGNJX_S::FSGNJX_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSGNJX_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, injectSign(readBits<float>(rf, rs1), readBits<float>(rf, rs2), (machineCode >> 12) & 0x7));
+}
+
+std::string FSGNJX_S::toString() const {
+    std::stringstream ss;
+    ss << "fsgnjx.s f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FSGNJX_S::isJump() const {
+    return false; // FSGNJX_S is not a jump instruction
+}
+
+uint64_t FSGNJX_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMIN_S::FMIN_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMIN_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, minimum(rf, readFloat<float>(rf, rs1), readFloat<float>(rf, rs2), false));
+}
+
+std::string FMIN_S::toString() const {
+    std::stringstream ss;
+    ss << "fmin.s f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FMIN_S::isJump() const {
+    return false; // FMIN_S is not a jump instruction
+}
+
+uint64_t FMIN_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMAX_S::FMAX_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMAX_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, minimum(rf, readFloat<float>(rf, rs1), readFloat<float>(rf, rs2), true));
+}
+
+std::string FMAX_S::toString() const {
+    std::stringstream ss;
+    ss << "fmax.s f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FMAX_S::isJump() const {
+    return false; // FMAX_S is not a jump instruction
+}
+
+uint64_t FMAX_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FEQ_S::FEQ_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FEQ_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    rf.write(rd, !unordered(rf, a, b, true) && a == b);
+}
+
+std::string FEQ_S::toString() const {
+    std::stringstream ss;
+    ss << "feq.s x" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FEQ_S::isJump() const {
+    return false; // FEQ_S is not a jump instruction
+}
+
+uint64_t FEQ_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FLT_S::FLT_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FLT_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    rf.write(rd, !unordered(rf, a, b, false) && a < b);
+}
+
+std::string FLT_S::toString() const {
+    std::stringstream ss;
+    ss << "flt.s x" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FLT_S::isJump() const {
+    return false; // FLT_S is not a jump instruction
+}
+
+uint64_t FLT_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FLE_S::FLE_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FLE_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    float a = readFloat<float>(rf, rs1);
+    float b = readFloat<float>(rf, rs2);
+    rf.write(rd, !unordered(rf, a, b, false) && a <= b);
+}
+
+std::string FLE_S::toString() const {
+    std::stringstream ss;
+    ss << "fle.s x" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FLE_S::isJump() const {
+    return false; // FLE_S is not a jump instruction
+}
+
+uint64_t FLE_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCLASS_S::FCLASS_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCLASS_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, classify(readFloat<float>(rf, rs1)));
+}
+
+std::string FCLASS_S::toString() const {
+    std::stringstream ss;
+    ss << "fclass.s x" << rd << ", f" << rs1;
+    return ss.str();
+}
+
+bool FCLASS_S::isJump() const {
+    return false; // FCLASS_S is not a jump instruction
+}
+
+uint64_t FCLASS_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_W_S::FCVT_W_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_W_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<int64_t>(convertToInteger<int32_t>(rf, readFloat<float>(rf, rs1), roundingMode(rf, machineCode))));
+}
+
+std::string FCVT_W_S::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.w.s x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_W_S::isJump() const {
+    return false; // FCVT_W_S is not a jump instruction
+}
+
+uint64_t FCVT_W_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_WU_S::FCVT_WU_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_WU_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<int64_t>(static_cast<int32_t>(convertToInteger<uint32_t>(rf, readFloat<float>(rf, rs1), roundingMode(rf, machineCode)))));
+}
+
+std::string FCVT_WU_S::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.wu.s x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_WU_S::isJump() const {
+    return false; // FCVT_WU_S is not a jump instruction
+}
+
+uint64_t FCVT_WU_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_L_S::FCVT_L_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_L_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<uint64_t>(convertToInteger<int64_t>(rf, readFloat<float>(rf, rs1), roundingMode(rf, machineCode))));
+}
+
+std::string FCVT_L_S::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.l.s x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_L_S::isJump() const {
+    return false; // FCVT_L_S is not a jump instruction
+}
+
+uint64_t FCVT_L_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_LU_S::FCVT_LU_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_LU_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, convertToInteger<uint64_t>(rf, readFloat<float>(rf, rs1), roundingMode(rf, machineCode)));
+}
+
+std::string FCVT_LU_S::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.lu.s x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_LU_S::isJump() const {
+    return false; // FCVT_LU_S is not a jump instruction
+}
+
+uint64_t FCVT_LU_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_S_W::FCVT_S_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_S_W::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, static_cast<int32_t>(rf.read(rs1))));
+}
+
+std::string FCVT_S_W::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.s.w f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_S_W::isJump() const {
+    return false; // FCVT_S_W is not a jump instruction
+}
+
+uint64_t FCVT_S_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_S_WU::FCVT_S_WU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_S_WU::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, static_cast<uint32_t>(rf.read(rs1))));
+}
+
+std::string FCVT_S_WU::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.s.wu f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_S_WU::isJump() const {
+    return false; // FCVT_S_WU is not a jump instruction
+}
+
+uint64_t FCVT_S_WU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_S_L::FCVT_S_L(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_S_L::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, static_cast<int64_t>(rf.read(rs1))));
+}
+
+std::string FCVT_S_L::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.s.l f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_S_L::isJump() const {
+    return false; // FCVT_S_L is not a jump instruction
+}
+
+uint64_t FCVT_S_L::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_S_LU::FCVT_S_LU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_S_LU::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, rf.read(rs1)));
+}
+
+std::string FCVT_S_LU::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.s.lu f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_S_LU::isJump() const {
+    return false; // FCVT_S_LU is not a jump instruction
+}
+
+uint64_t FCVT_S_LU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMADD_D::FMADD_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMADD_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    double c = readFloat<double>(rf, rs3);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, a, b, c));
+}
+
+std::string FMADD_D::toString() const {
+    std::stringstream ss;
+    ss << "fmadd.d f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FMADD_D::isJump() const {
+    return false; // FMADD_D is not a jump instruction
+}
+
+uint64_t FMADD_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMSUB_D::FMSUB_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMSUB_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    double c = readFloat<double>(rf, rs3);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, a, b, -c));
+}
+
+std::string FMSUB_D::toString() const {
+    std::stringstream ss;
+    ss << "fmsub.d f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FMSUB_D::isJump() const {
+    return false; // FMSUB_D is not a jump instruction
+}
+
+uint64_t FMSUB_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FNMSUB_D::FNMSUB_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FNMSUB_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    double c = readFloat<double>(rf, rs3);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, -a, b, c));
+}
+
+std::string FNMSUB_D::toString() const {
+    std::stringstream ss;
+    ss << "fnmsub.d f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FNMSUB_D::isJump() const {
+    return false; // FNMSUB_D is not a jump instruction
+}
+
+uint64_t FNMSUB_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FNMADD_D::FNMADD_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FNMADD_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    int rs3 = (machineCode >> 27) & 0x1F;
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    double c = readFloat<double>(rf, rs3);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode),
+                                     [](auto x, auto y, auto z) { return std::fma(x, y, z); }, -a, b, -c));
+}
+
+std::string FNMADD_D::toString() const {
+    std::stringstream ss;
+    ss << "fnmadd.d f" << rd << ", f" << rs1 << ", f" << rs2 << ", f" << ((machineCode >> 27) & 0x1F)
+       << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FNMADD_D::isJump() const {
+    return false; // FNMADD_D is not a jump instruction
+}
+
+uint64_t FNMADD_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FADD_D::FADD_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FADD_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x + y; }, a, b));
+}
+
+std::string FADD_D::toString() const {
+    std::stringstream ss;
+    ss << "fadd.d f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FADD_D::isJump() const {
+    return false; // FADD_D is not a jump instruction
+}
+
+uint64_t FADD_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSUB_D::FSUB_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSUB_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x - y; }, a, b));
+}
+
+std::string FSUB_D::toString() const {
+    std::stringstream ss;
+    ss << "fsub.d f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FSUB_D::isJump() const {
+    return false; // FSUB_D is not a jump instruction
+}
+
+uint64_t FSUB_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMUL_D::FMUL_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMUL_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x * y; }, a, b));
+}
+
+std::string FMUL_D::toString() const {
+    std::stringstream ss;
+    ss << "fmul.d f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FMUL_D::isJump() const {
+    return false; // FMUL_D is not a jump instruction
+}
+
+uint64_t FMUL_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FDIV_D::FDIV_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FDIV_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x, auto y) { return x / y; }, a, b));
+}
+
+std::string FDIV_D::toString() const {
+    std::stringstream ss;
+    ss << "fdiv.d f" << rd << ", f" << rs1 << ", f" << rs2 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FDIV_D::isJump() const {
+    return false; // FDIV_D is not a jump instruction
+}
+
+uint64_t FDIV_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSQRT_D::FSQRT_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSQRT_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x) { return std::sqrt(x); }, a));
+}
+
+std::string FSQRT_D::toString() const {
+    std::stringstream ss;
+    ss << "fsqrt.d f" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FSQRT_D::isJump() const {
+    return false; // FSQRT_D is not a jump instruction
+}
+
+uint64_t FSQRT_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSGNJ_D::FSGNJ_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSGNJ_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, injectSign(readBits<double>(rf, rs1), readBits<double>(rf, rs2), (machineCode >> 12) & 0x7));
+}
+
+std::string FSGNJ_D::toString() const {
+    std::stringstream ss;
+    ss << "fsgnj.d f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FSGNJ_D::isJump() const {
+    return false; // FSGNJ_D is not a jump instruction
+}
+
+uint64_t FSGNJ_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSGNJN_D::FSGNJN_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSGNJN_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, injectSign(readBits<double>(rf, rs1), readBits<double>(rf, rs2), (machineCode >> 12) & 0x7));
+}
+
+std::string FSGNJN_D::toString() const {
+    std::stringstream ss;
+    ss << "fsgnjn.d f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FSGNJN_D::isJump() const {
+    return false; // FSGNJN_D is not a jump instruction
+}
+
+uint64_t FSGNJN_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FSGNJX_D::FSGNJX_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FSGNJX_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, injectSign(readBits<double>(rf, rs1), readBits<double>(rf, rs2), (machineCode >> 12) & 0x7));
+}
+
+std::string FSGNJX_D::toString() const {
+    std::stringstream ss;
+    ss << "fsgnjx.d f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FSGNJX_D::isJump() const {
+    return false; // FSGNJX_D is not a jump instruction
+}
+
+uint64_t FSGNJX_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMIN_D::FMIN_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMIN_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, minimum(rf, readFloat<double>(rf, rs1), readFloat<double>(rf, rs2), false));
+}
+
+std::string FMIN_D::toString() const {
+    std::stringstream ss;
+    ss << "fmin.d f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FMIN_D::isJump() const {
+    return false; // FMIN_D is not a jump instruction
+}
+
+uint64_t FMIN_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMAX_D::FMAX_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMAX_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, minimum(rf, readFloat<double>(rf, rs1), readFloat<double>(rf, rs2), true));
+}
+
+std::string FMAX_D::toString() const {
+    std::stringstream ss;
+    ss << "fmax.d f" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FMAX_D::isJump() const {
+    return false; // FMAX_D is not a jump instruction
+}
+
+uint64_t FMAX_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FEQ_D::FEQ_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FEQ_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    rf.write(rd, !unordered(rf, a, b, true) && a == b);
+}
+
+std::string FEQ_D::toString() const {
+    std::stringstream ss;
+    ss << "feq.d x" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FEQ_D::isJump() const {
+    return false; // FEQ_D is not a jump instruction
+}
+
+uint64_t FEQ_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FLT_D::FLT_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FLT_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    rf.write(rd, !unordered(rf, a, b, false) && a < b);
+}
+
+std::string FLT_D::toString() const {
+    std::stringstream ss;
+    ss << "flt.d x" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FLT_D::isJump() const {
+    return false; // FLT_D is not a jump instruction
+}
+
+uint64_t FLT_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FLE_D::FLE_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FLE_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    double a = readFloat<double>(rf, rs1);
+    double b = readFloat<double>(rf, rs2);
+    rf.write(rd, !unordered(rf, a, b, false) && a <= b);
+}
+
+std::string FLE_D::toString() const {
+    std::stringstream ss;
+    ss << "fle.d x" << rd << ", f" << rs1 << ", f" << rs2;
+    return ss.str();
+}
+
+bool FLE_D::isJump() const {
+    return false; // FLE_D is not a jump instruction
+}
+
+uint64_t FLE_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCLASS_D::FCLASS_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCLASS_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, classify(readFloat<double>(rf, rs1)));
+}
+
+std::string FCLASS_D::toString() const {
+    std::stringstream ss;
+    ss << "fclass.d x" << rd << ", f" << rs1;
+    return ss.str();
+}
+
+bool FCLASS_D::isJump() const {
+    return false; // FCLASS_D is not a jump instruction
+}
+
+uint64_t FCLASS_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_W_D::FCVT_W_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_W_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<int64_t>(convertToInteger<int32_t>(rf, readFloat<double>(rf, rs1), roundingMode(rf, machineCode))));
+}
+
+std::string FCVT_W_D::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.w.d x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_W_D::isJump() const {
+    return false; // FCVT_W_D is not a jump instruction
+}
+
+uint64_t FCVT_W_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_WU_D::FCVT_WU_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_WU_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<int64_t>(static_cast<int32_t>(convertToInteger<uint32_t>(rf, readFloat<double>(rf, rs1), roundingMode(rf, machineCode)))));
+}
+
+std::string FCVT_WU_D::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.wu.d x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_WU_D::isJump() const {
+    return false; // FCVT_WU_D is not a jump instruction
+}
+
+uint64_t FCVT_WU_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_L_D::FCVT_L_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_L_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<uint64_t>(convertToInteger<int64_t>(rf, readFloat<double>(rf, rs1), roundingMode(rf, machineCode))));
+}
+
+std::string FCVT_L_D::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.l.d x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_L_D::isJump() const {
+    return false; // FCVT_L_D is not a jump instruction
+}
+
+uint64_t FCVT_L_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_LU_D::FCVT_LU_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_LU_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, convertToInteger<uint64_t>(rf, readFloat<double>(rf, rs1), roundingMode(rf, machineCode)));
+}
+
+std::string FCVT_LU_D::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.lu.d x" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_LU_D::isJump() const {
+    return false; // FCVT_LU_D is not a jump instruction
+}
+
+uint64_t FCVT_LU_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_D_W::FCVT_D_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_D_W::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, static_cast<int32_t>(rf.read(rs1))));
+}
+
+std::string FCVT_D_W::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.d.w f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_D_W::isJump() const {
+    return false; // FCVT_D_W is not a jump instruction
+}
+
+uint64_t FCVT_D_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_D_WU::FCVT_D_WU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_D_WU::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, static_cast<uint32_t>(rf.read(rs1))));
+}
+
+std::string FCVT_D_WU::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.d.wu f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_D_WU::isJump() const {
+    return false; // FCVT_D_WU is not a jump instruction
+}
+
+uint64_t FCVT_D_WU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_D_L::FCVT_D_L(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_D_L::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, static_cast<int64_t>(rf.read(rs1))));
+}
+
+std::string FCVT_D_L::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.d.l f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_D_L::isJump() const {
+    return false; // FCVT_D_L is not a jump instruction
+}
+
+uint64_t FCVT_D_L::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_D_LU::FCVT_D_LU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_D_LU::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, rf.read(rs1)));
+}
+
+std::string FCVT_D_LU::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.d.lu f" << rd << ", x" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_D_LU::isJump() const {
+    return false; // FCVT_D_LU is not a jump instruction
+}
+
+uint64_t FCVT_D_LU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_S_D::FCVT_S_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_S_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<float>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, readFloat<double>(rf, rs1)));
+}
+
+std::string FCVT_S_D::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.s.d f" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_S_D::isJump() const {
+    return false; // FCVT_S_D is not a jump instruction
+}
+
+uint64_t FCVT_S_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FCVT_D_S::FCVT_D_S(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FCVT_D_S::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeFloat(rf, rd, evaluate<double>(rf, roundingMode(rf, machineCode), [](auto x) { return x; }, readFloat<float>(rf, rs1)));
+}
+
+std::string FCVT_D_S::toString() const {
+    std::stringstream ss;
+    ss << "fcvt.d.s f" << rd << ", f" << rs1 << roundingSuffix(machineCode);
+    return ss.str();
+}
+
+bool FCVT_D_S::isJump() const {
+    return false; // FCVT_D_S is not a jump instruction
+}
+
+uint64_t FCVT_D_S::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMV_X_W::FMV_X_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMV_X_W::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, signExtend(rf.read(RegisterFile::F0 + rs1) & 0xFFFFFFFF, 32));
+}
+
+std::string FMV_X_W::toString() const {
+    std::stringstream ss;
+    ss << "fmv.x.w x" << rd << ", f" << rs1;
+    return ss.str();
+}
+
+bool FMV_X_W::isJump() const {
+    return false; // FMV_X_W is not a jump instruction
+}
+
+uint64_t FMV_X_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMV_W_X::FMV_W_X(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMV_W_X::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, static_cast<uint32_t>(rf.read(rs1)));
+}
+
+std::string FMV_W_X::toString() const {
+    std::stringstream ss;
+    ss << "fmv.w.x f" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool FMV_W_X::isJump() const {
+    return false; // FMV_W_X is not a jump instruction
+}
+
+uint64_t FMV_W_X::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMV_X_D::FMV_X_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMV_X_D::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(RegisterFile::F0 + rs1));
+}
+
+std::string FMV_X_D::toString() const {
+    std::stringstream ss;
+    ss << "fmv.x.d x" << rd << ", f" << rs1;
+    return ss.str();
+}
+
+bool FMV_X_D::isJump() const {
+    return false; // FMV_X_D is not a jump instruction
+}
+
+uint64_t FMV_X_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+FMV_D_X::FMV_D_X(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void FMV_D_X::execute(RegisterFile& rf, Memory& /* mem */) {
+    writeBits(rf, rd, rf.read(rs1));
+}
+
+std::string FMV_D_X::toString() const {
+    std::stringstream ss;
+    ss << "fmv.d.x f" << rd << ", x" << rs1;
+    return ss.str();
+}
+
+bool FMV_D_X::isJump() const {
+    return false; // FMV_D_X is not a jump instruction
+}
+
+uint64_t FMV_D_X::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
@@ -0,0 +1,129 @@
+#include "../include/hart.h"
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// funct5 of the AMO opcode
+bool isLoadReserved(uint32_t word) {
+    return (word & 0x7F) == 0x2F && (word >> 27) == 0x02;
+}
+
+bool isStoreConditional(uint32_t word) {
+    return (word & 0x7F) == 0x2F && (word >> 27) == 0x03;
+}
+
+} // namespace
+
+Hart::Hart(int id, const Program& program, Memory& mem, unsigned vlen)
+    : hartId(id), program(program), mem(mem), rf(vlen), decoded(program.size()), pc(0), executed(0),
+      atomicPending(false) {
+    rf.setHartId(id);
+    rf.write(RegisterFile::PC, 0);
+    rf.write(10, id);
+    rf.write(2, mem.getStackPointer() - id * STACK_SIZE);
+}
+
+Instruction& Hart::fetch() {
+    size_t index = program.indexAt(pc);
+    std::unique_ptr<Instruction>& inst = decoded[index];
+    if (!inst) {
+        inst = Instruction::decode(program.instruction(index), program.length(index));
+    }
+    return *inst;
+}
+
+void Hart::step() {
+    execute(view ? *view : mem);
+}
+
+void Hart::execute(Memory& target) {
+    Instruction& inst = fetch();
+    uint64_t old_pc = rf.read(RegisterFile::PC);
+    rf.setRetired(executed);
+    inst.execute(rf, target);
+    uint64_t new_pc = rf.read(RegisterFile::PC);
+
+    if (new_pc == old_pc) {
+        new_pc = old_pc + inst.length();
+        rf.write(RegisterFile::PC, new_pc);
+    }
+    if (rf.countsEvents()) {
+        rf.recordEvents(program.instruction(program.indexAt(old_pc)), new_pc != old_pc + inst.length());
+    }
+    pc = new_pc;
+    executed++;
+}
+
+void Hart::resume(const RegisterFile& regs, uint64_t resumePc, size_t executedSoFar) {
+    rf = regs;
+    pc = resumePc;
+    executed = executedSoFar;
+    fault.clear();
+}
+
+RegisterFile::Yield Hart::run(size_t maxInstructions) {
+    if (faulted()) {
+        return RegisterFile::YIELD_NONE;
+    }
+    try {
+        for (size_t i = 0; i < maxInstructions && !finished(); ++i) {
+            if (view && atAtomic()) {
+                atomicPending = true;
+                return RegisterFile::YIELD_ATOMIC;
+            }
+            step();
+            RegisterFile::Yield reason = rf.takeYield();
+            if (reason != RegisterFile::YIELD_NONE) {
+                return reason;
+            }
+        }
+    } catch (const std::exception& e) {
+        fault = e.what();
+    }
+    return RegisterFile::YIELD_NONE;
+}
+
+bool Hart::atAtomic() {
+    return (program.instruction(program.indexAt(pc)) & 0x7F) == 0x2F; // AMO opcode
+}
+
+void Hart::setIsolated(bool isolated) {
+    if (!isolated) {
+        view.reset();
+        viewStores.reset();
+        return;
+    }
+    view.reset(new Memory());
+    // Never wraps: every store of a round has to be published
+    viewStores.reset(new UndoLog(std::numeric_limits<size_t>::max()));
+    view->setJournal(viewStores.get());
+}
+
+void Hart::beginRound() {
+    // Pages stay shared with the other harts' views until written
+    view->shareImage(mem);
+    viewStores->reset(executed);
+}
+
+void Hart::commitRound() {
+    view->publishJournal(mem);
+    if (!atomicPending) {
+        return;
+    }
+    atomicPending = false;
+    try {
+        // An LR runs on to its SC here, so the pair cannot be split by
+        // another hart's barrier step. Constrained LR/SC loops are at most
+        // 16 instructions long.
+        bool reserved = isLoadReserved(program.instruction(program.indexAt(pc)));
+        execute(mem);
+        for (int i = 0; reserved && i < 16 && !finished(); ++i) {
+            reserved = !isStoreConditional(program.instruction(program.indexAt(pc)));
+            execute(mem);
+        }
+        rf.takeYield();
+    } catch (const std::exception& e) {
+        fault = e.what();
+    }
+}
@@ -0,0 +1,153 @@
+#include "../include/simulator.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+bool Simulator::prepareHarts(int hartCount) {
+    if (text.empty()) {
+        std::cout << "No program loaded" << std::endl;
+        return false;
+    }
+    if (hartCount < 1 || hartCount > MAX_HARTS) {
+        std::cout << "Hart count must be between 1 and " << MAX_HARTS << std::endl;
+        return false;
+    }
+    if (!mem.getWatchpoints().empty()) {
+        std::cout << "Watchpoints are not supported with multiple harts" << std::endl;
+        return false;
+    }
+
+    // Stores must not copy pages or journal while other threads run
+    mem.makePrivate();
+    mem.setJournal(nullptr);
+    harts.clear();
+    for (int i = 0; i < hartCount; ++i) {
+        harts.emplace_back(new Hart(i, text, mem, rf.vlen()));
+    }
+    return true;
+}
+
+void Simulator::finishHarts(double seconds, bool report) {
+    mem.setJournal(reverseEnabled ? &undoLog : nullptr);
+
+    // Memory changed behind the recorded history
+    checkpoints.clear();
+    undoLog.reset(executedInstructions);
+    if (!report) {
+        return;
+    }
+
+    size_t total = 0;
+    for (const auto& hart : harts) {
+        total += hart->instructionCount();
+        std::cout << "Hart " << std::dec << hart->id() << ": " << hart->instructionCount() << " instructions, ";
+        if (hart->faulted()) {
+            std::cout << "error: " << hart->error() << std::endl;
+        } else {
+            std::cout << (hart->finished() ? "finished" : "stopped at limit") << std::endl;
+        }
+    }
+    std::ios_base::fmtflags flags = std::cout.flags();
+    std::cout << harts.size() << " harts executed " << total << " instructions in " << std::fixed << std::setprecision(3)
+              << seconds * 1e3 << " ms (" << (seconds > 0 ? total / seconds / 1e6 : 0.0) << " MIPS)" << std::endl;
+    std::cout.flags(flags);
+    std::cout << std::setprecision(6);
+}
+
+void Simulator::runHarts(int hartCount, size_t maxInstructions) {
+    if (!prepareHarts(hartCount)) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (auto& hart : harts) {
+        Hart* h = hart.get();
+        threads.emplace_back([h, maxInstructions] {
+            while (!h->finished() && !h->faulted() && h->instructionCount() < maxInstructions) {
+                if (h->run(maxInstructions - h->instructionCount()) != RegisterFile::YIELD_NONE) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    finishHarts(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), true);
+}
+
+// Rounds end at a barrier, so which hart runs how far in which round
+// depends only on the guest, never on host timing. Within a round every
+// hart works on its own copy of memory; at the barrier their stores and
+// atomics are applied in hart order. A hart therefore sees other harts'
+// stores one round late, but the run is reproducible on any number of
+// workers.
+void Simulator::scheduleHarts(int hartCount, size_t workers, size_t quantum, size_t maxInstructions, bool report) {
+    if (quantum == 0) {
+        std::cout << "Quantum must be at least one instruction" << std::endl;
+        return;
+    }
+    if (!prepareHarts(hartCount)) {
+        return;
+    }
+
+    for (auto& hart : harts) {
+        hart->setIsolated(true);
+    }
+    auto start = std::chrono::steady_clock::now();
+    size_t rounds = 0;
+    size_t yields = 0;
+    {
+        WorkStealingPool pool(workers);
+        std::vector<RegisterFile::Yield> yielded(harts.size());
+        while (true) {
+            bool live = false;
+            for (size_t i = 0; i < harts.size(); ++i) {
+                Hart* h = harts[i].get();
+                if (h->finished() || h->faulted() || h->instructionCount() >= maxInstructions) {
+                    continue;
+                }
+                live = true;
+                size_t budget = std::min(quantum, maxInstructions - h->instructionCount());
+                // A hart that yields frees its worker early, which then
+                // steals the next harts of the round from busier workers
+                pool.submit([h, budget, &yielded, i] {
+                    h->beginRound();
+                    yielded[i] = h->run(budget);
+                });
+            }
+            if (!live) {
+                break;
+            }
+            pool.wait();
+            for (auto& hart : harts) {
+                hart->commitRound();
+            }
+            rounds++;
+            yields += harts.size() - std::count(yielded.begin(), yielded.end(), RegisterFile::YIELD_NONE);
+            std::fill(yielded.begin(), yielded.end(), RegisterFile::YIELD_NONE);
+        }
+        workers = pool.size();
+    }
+    for (auto& hart : harts) {
+        hart->setIsolated(false);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (report) {
+        std::cout << "Scheduled " << std::dec << hartCount << " harts on " << workers << " workers: " << rounds
+                  << " rounds of " << quantum << " instructions, " << yields << " early yields" << std::endl;
+    }
+    finishHarts(seconds, report);
+}
+
+void Simulator::printHartRegs(int hartId) const {
+    if (hartId < 0 || hartId >= static_cast<int>(harts.size())) {
+        std::cout << "No hart " << std::dec << hartId << " in the last multi-hart run" << std::endl;
+        return;
+    }
+    harts[hartId]->registers().printRegs();
+}
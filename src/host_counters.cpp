@@ -0,0 +1,138 @@
+#include "../include/host_counters.h"
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char* const COUNTER_NAMES[HostCounters::COUNTER_COUNT] = {
+    "cycles", "instructions", "branch-misses", "LLC-misses"
+};
+
+} // namespace
+
+HostCounters::HostCounters() {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        fds[i] = -1;
+        values[i] = -1;
+    }
+}
+
+HostCounters::~HostCounters() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+void HostCounters::open() {
+    opened = true;
+#ifdef __linux__
+    const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_MISSES
+    };
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1; // Allowed at perf_event_paranoid 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // This thread only: stream consumers and harts run on their own
+        fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fds[i] < 0 && openError.empty()) {
+            openError = std::string(COUNTER_NAMES[i]) + ": " + std::strerror(errno);
+        }
+    }
+#else
+    openError = "perf_event_open is Linux only";
+#endif
+}
+
+void HostCounters::start() {
+    if (!opened) {
+        open();
+    }
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void HostCounters::stop() {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        values[i] = -1;
+#ifdef __linux__
+        if (fds[i] < 0) {
+            continue;
+        }
+        ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t data[3]; // value, time enabled, time running
+        if (read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+            continue;
+        }
+        double scale = static_cast<double>(data[1]) / data[2];
+        values[i] = static_cast<int64_t>(data[0] * scale);
+#endif
+    }
+}
+
+void HostCounters::report(std::ostream& out, uint64_t guestInstructions, double seconds) const {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    char fill = out.fill(' ');
+    out << std::dec << std::fixed << std::setprecision(3);
+    out << "Guest instructions  " << std::setw(16) << guestInstructions << std::endl;
+    out << "Wall time           " << std::setw(16) << seconds * 1e3 << " ms" << std::endl;
+    out << "Guest MIPS          " << std::setw(16) << (seconds > 0 ? guestInstructions / seconds / 1e6 : 0.0)
+        << std::endl;
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        out << "Host " << std::left << std::setw(15) << COUNTER_NAMES[i] << std::right;
+        if (available(static_cast<Counter>(i))) {
+            out << std::setw(16) << values[i] << std::endl;
+        } else {
+            out << std::setw(16) << "unavailable" << std::endl;
+        }
+    }
+    if (guestInstructions > 0) {
+        if (available(CYCLES)) {
+            out << "Host cycles / guest instruction        "
+                << static_cast<double>(values[CYCLES]) / guestInstructions << std::endl;
+        }
+        if (available(INSTRUCTIONS)) {
+            out << "Host instructions / guest instruction  "
+                << static_cast<double>(values[INSTRUCTIONS]) / guestInstructions << std::endl;
+        }
+        if (available(BRANCH_MISSES)) {
+            out << "Host branch misses / 1000 guest instr. "
+                << 1000.0 * values[BRANCH_MISSES] / guestInstructions << std::endl;
+        }
+        if (available(LLC_MISSES)) {
+            out << "Host LLC misses / 1000 guest instr.    "
+                << 1000.0 * values[LLC_MISSES] / guestInstructions << std::endl;
+        }
+    }
+    if (!openError.empty()) {
+        out << "perf_event_open failed (" << openError << ")" << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out.fill(fill);
+}
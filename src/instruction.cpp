@@ -1,4 +1,5 @@
 #include "../include/instruction.h"
+#include "../include/vector_instruction.h"
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -6,15 +7,22 @@
 
 // Helper function to sign-extend a value
 int64_t signExtend(uint64_t value, int bits) {
-    int64_t x = (int64_t)value;
+    // Callers pass both zero- and sign-extended values; keep only the low bits
+    int64_t x = (int64_t)(bits < 64 ? value & ((1ULL << bits) - 1) : value);
     int64_t m = 1LL << (bits - 1);
     return (x ^ m) - m;
 }
 
+// Host 128-bit integers for the high halves of the M extension products
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+
 std::unique_ptr<Instruction> Instruction::decode(uint32_t machineCode) {
     uint32_t opcode = machineCode & 0x7F;
     uint32_t funct3 = (machineCode >> 12) & 0x7;
     uint32_t funct7 = (machineCode >> 25) & 0x7F;
+    uint32_t funct6 = machineCode >> 26; // RV64 shifts keep shamt[5] in funct7
+    uint32_t rs2 = (machineCode >> 20) & 0x1F;
 
     switch(opcode) {
         case 0x03: // LOAD
@@ -28,16 +36,35 @@ std::unique_ptr<Instruction> Instruction::decode(uint32_t machineCode) {
                 case 0x6: return std::make_unique<LWU>(machineCode);
             }
             break;
+        case 0x07: // LOAD-FP
+            if (funct3 == 0x2) return std::make_unique<FLW>(machineCode);
+            if (funct3 == 0x3) return std::make_unique<FLD>(machineCode);
+            if (std::unique_ptr<Instruction> vector = VectorInstruction::decode(machineCode)) return vector;
+            break;
         case 0x13: // OP-IMM
             switch(funct3) {
                 case 0x0: return std::make_unique<ADDI>(machineCode);
-                case 0x1: return std::make_unique<SLLI>(machineCode);
+                case 0x1:
+                    if (funct6 == 0x00) return std::make_unique<SLLI>(machineCode);
+                    if (funct7 == 0x30) {
+                        switch (rs2) {
+                            case 0x0: return std::make_unique<CLZ>(machineCode);
+                            case 0x1: return std::make_unique<CTZ>(machineCode);
+                            case 0x2: return std::make_unique<CPOP>(machineCode);
+                            case 0x4: return std::make_unique<SEXT_B>(machineCode);
+                            case 0x5: return std::make_unique<SEXT_H>(machineCode);
+                        }
+                    }
+                    break;
                 case 0x2: return std::make_unique<SLTI>(machineCode);
                 case 0x3: return std::make_unique<SLTIU>(machineCode);
                 case 0x4: return std::make_unique<XORI>(machineCode);
                 case 0x5: 
-                    if (funct7 == 0x00) return std::make_unique<SRLI>(machineCode);
-                    if (funct7 == 0x20) return std::make_unique<SRAI>(machineCode);
+                    if (funct6 == 0x00) return std::make_unique<SRLI>(machineCode);
+                    if (funct6 == 0x10) return std::make_unique<SRAI>(machineCode);
+                    if (funct6 == 0x18) return std::make_unique<RORI>(machineCode);
+                    if ((machineCode >> 20) == 0x287) return std::make_unique<ORC_B>(machineCode);
+                    if ((machineCode >> 20) == 0x6B8) return std::make_unique<REV8>(machineCode);
                     break;
                 case 0x6: return std::make_unique<ORI>(machineCode);
                 case 0x7: return std::make_unique<ANDI>(machineCode);
@@ -47,10 +74,21 @@ std::unique_ptr<Instruction> Instruction::decode(uint32_t machineCode) {
         case 0x1B: // OP-IMM-32
             switch(funct3) {
                 case 0x0: return std::make_unique<ADDIW>(machineCode);
-                case 0x1: return std::make_unique<SLLIW>(machineCode);
+                case 0x1:
+                    if (funct7 == 0x00) return std::make_unique<SLLIW>(machineCode);
+                    if (funct6 == 0x02) return std::make_unique<SLLI_UW>(machineCode);
+                    if (funct7 == 0x30) {
+                        switch (rs2) {
+                            case 0x0: return std::make_unique<CLZW>(machineCode);
+                            case 0x1: return std::make_unique<CTZW>(machineCode);
+                            case 0x2: return std::make_unique<CPOPW>(machineCode);
+                        }
+                    }
+                    break;
                 case 0x5:
                     if (funct7 == 0x00) return std::make_unique<SRLIW>(machineCode);
                     if (funct7 == 0x20) return std::make_unique<SRAIW>(machineCode);
+                    if (funct7 == 0x30) return std::make_unique<RORIW>(machineCode);
                     break;
             }
             break;
@@ -62,13 +100,92 @@ std::unique_ptr<Instruction> Instruction::decode(uint32_t machineCode) {
                 case 0x3: return std::make_unique<SD>(machineCode);
             }
             break;
+        case 0x27: // STORE-FP
+            if (funct3 == 0x2) return std::make_unique<FSW>(machineCode);
+            if (funct3 == 0x3) return std::make_unique<FSD>(machineCode);
+            if (std::unique_ptr<Instruction> vector = VectorInstruction::decode(machineCode)) return vector;
+            break;
+        case 0x2F: { // AMO
+            uint32_t funct5 = funct7 >> 2;
+            if (funct3 == 0x2) {
+                switch (funct5) {
+                    case 0x02: return std::make_unique<LR_W>(machineCode);
+                    case 0x03: return std::make_unique<SC_W>(machineCode);
+                    case 0x01: return std::make_unique<AMOSWAP_W>(machineCode);
+                    case 0x00: return std::make_unique<AMOADD_W>(machineCode);
+                    case 0x04: return std::make_unique<AMOXOR_W>(machineCode);
+                    case 0x0C: return std::make_unique<AMOAND_W>(machineCode);
+                    case 0x08: return std::make_unique<AMOOR_W>(machineCode);
+                    case 0x10: return std::make_unique<AMOMIN_W>(machineCode);
+                    case 0x14: return std::make_unique<AMOMAX_W>(machineCode);
+                    case 0x18: return std::make_unique<AMOMINU_W>(machineCode);
+                    case 0x1C: return std::make_unique<AMOMAXU_W>(machineCode);
+                }
+            } else if (funct3 == 0x3) {
+                switch (funct5) {
+                    case 0x02: return std::make_unique<LR_D>(machineCode);
+                    case 0x03: return std::make_unique<SC_D>(machineCode);
+                    case 0x01: return std::make_unique<AMOSWAP_D>(machineCode);
+                    case 0x00: return std::make_unique<AMOADD_D>(machineCode);
+                    case 0x04: return std::make_unique<AMOXOR_D>(machineCode);
+                    case 0x0C: return std::make_unique<AMOAND_D>(machineCode);
+                    case 0x08: return std::make_unique<AMOOR_D>(machineCode);
+                    case 0x10: return std::make_unique<AMOMIN_D>(machineCode);
+                    case 0x14: return std::make_unique<AMOMAX_D>(machineCode);
+                    case 0x18: return std::make_unique<AMOMINU_D>(machineCode);
+                    case 0x1C: return std::make_unique<AMOMAXU_D>(machineCode);
+                }
+            }
+            break;
+        }
         case 0x33: // OP
+            if (funct7 == 0x01) { // M extension
+                switch(funct3) {
+                    case 0x0: return std::make_unique<MUL>(machineCode);
+                    case 0x1: return std::make_unique<MULH>(machineCode);
+                    case 0x2: return std::make_unique<MULHSU>(machineCode);
+                    case 0x3: return std::make_unique<MULHU>(machineCode);
+                    case 0x4: return std::make_unique<DIV>(machineCode);
+                    case 0x5: return std::make_unique<DIVU>(machineCode);
+                    case 0x6: return std::make_unique<REM>(machineCode);
+                    case 0x7: return std::make_unique<REMU>(machineCode);
+                }
+            }
+            if (funct7 == 0x05) { // Zbb min/max
+                switch(funct3) {
+                    case 0x4: return std::make_unique<MIN>(machineCode);
+                    case 0x5: return std::make_unique<MINU>(machineCode);
+                    case 0x6: return std::make_unique<MAX>(machineCode);
+                    case 0x7: return std::make_unique<MAXU>(machineCode);
+                }
+                break;
+            }
+            if (funct7 == 0x10) { // Zba shifted adds
+                switch(funct3) {
+                    case 0x2: return std::make_unique<SH1ADD>(machineCode);
+                    case 0x4: return std::make_unique<SH2ADD>(machineCode);
+                    case 0x6: return std::make_unique<SH3ADD>(machineCode);
+                }
+                break;
+            }
+            if (funct7 == 0x20) { // Zbb logic with an inverted operand
+                switch(funct3) {
+                    case 0x4: return std::make_unique<XNOR>(machineCode);
+                    case 0x6: return std::make_unique<ORN>(machineCode);
+                    case 0x7: return std::make_unique<ANDN>(machineCode);
+                }
+            }
+            if (funct7 == 0x30) { // Zbb rotates
+                if (funct3 == 0x1) return std::make_unique<ROL>(machineCode);
+                if (funct3 == 0x5) return std::make_unique<ROR>(machineCode);
+                break;
+            }
             switch(funct3) {
                 case 0x0:
                     if (funct7 == 0x00) return std::make_unique<ADD>(machineCode);
                     if (funct7 == 0x20) return std::make_unique<SUB>(machineCode);
                     break;
-                case 0x1: return std::make_unique<SLL>(machineCode);
+                case 0x1: if (funct7 == 0x00) return std::make_unique<SLL>(machineCode); break;
                 case 0x2: return std::make_unique<SLT>(machineCode);
                 case 0x3: return std::make_unique<SLTU>(machineCode);
                 case 0x4: return std::make_unique<XOR>(machineCode);
@@ -82,18 +199,149 @@ std::unique_ptr<Instruction> Instruction::decode(uint32_t machineCode) {
             break;
         case 0x37: return std::make_unique<LUI>(machineCode);
         case 0x3B: // OP-32
+            if (funct7 == 0x01) { // M extension
+                switch(funct3) {
+                    case 0x0: return std::make_unique<MULW>(machineCode);
+                    case 0x4: return std::make_unique<DIVW>(machineCode);
+                    case 0x5: return std::make_unique<DIVUW>(machineCode);
+                    case 0x6: return std::make_unique<REMW>(machineCode);
+                    case 0x7: return std::make_unique<REMUW>(machineCode);
+                }
+                break;
+            }
+            if (funct7 == 0x04) { // Zba add.uw, Zbb zext.h
+                if (funct3 == 0x0) return std::make_unique<ADD_UW>(machineCode);
+                if (funct3 == 0x4 && rs2 == 0) return std::make_unique<ZEXT_H>(machineCode);
+                break;
+            }
+            if (funct7 == 0x10) { // Zba shifted adds of a zero-extended word
+                switch(funct3) {
+                    case 0x2: return std::make_unique<SH1ADD_UW>(machineCode);
+                    case 0x4: return std::make_unique<SH2ADD_UW>(machineCode);
+                    case 0x6: return std::make_unique<SH3ADD_UW>(machineCode);
+                }
+                break;
+            }
+            if (funct7 == 0x30) { // Zbb word rotates
+                if (funct3 == 0x1) return std::make_unique<ROLW>(machineCode);
+                if (funct3 == 0x5) return std::make_unique<RORW>(machineCode);
+                break;
+            }
             switch(funct3) {
                 case 0x0:
                     if (funct7 == 0x00) return std::make_unique<ADDW>(machineCode);
                     if (funct7 == 0x20) return std::make_unique<SUBW>(machineCode);
                     break;
-                case 0x1: return std::make_unique<SLLW>(machineCode);
+                case 0x1: if (funct7 == 0x00) return std::make_unique<SLLW>(machineCode); break;
                 case 0x5:
                     if (funct7 == 0x00) return std::make_unique<SRLW>(machineCode);
                     if (funct7 == 0x20) return std::make_unique<SRAW>(machineCode);
                     break;
             }
             break;
+        case 0x43: // MADD
+        case 0x47: // MSUB
+        case 0x4B: // NMSUB
+        case 0x4F: { // NMADD
+            bool isDouble = (funct7 & 0x3) == 0x1;
+            if ((funct7 & 0x3) > 0x1) break;
+            switch (opcode) {
+                case 0x43: if (isDouble) return std::make_unique<FMADD_D>(machineCode); return std::make_unique<FMADD_S>(machineCode);
+                case 0x47: if (isDouble) return std::make_unique<FMSUB_D>(machineCode); return std::make_unique<FMSUB_S>(machineCode);
+                case 0x4B: if (isDouble) return std::make_unique<FNMSUB_D>(machineCode); return std::make_unique<FNMSUB_S>(machineCode);
+                default: if (isDouble) return std::make_unique<FNMADD_D>(machineCode); return std::make_unique<FNMADD_S>(machineCode);
+            }
+        }
+        case 0x53: { // OP-FP
+            switch (funct7) {
+                case 0x00: return std::make_unique<FADD_S>(machineCode);
+                case 0x01: return std::make_unique<FADD_D>(machineCode);
+                case 0x04: return std::make_unique<FSUB_S>(machineCode);
+                case 0x05: return std::make_unique<FSUB_D>(machineCode);
+                case 0x08: return std::make_unique<FMUL_S>(machineCode);
+                case 0x09: return std::make_unique<FMUL_D>(machineCode);
+                case 0x0C: return std::make_unique<FDIV_S>(machineCode);
+                case 0x0D: return std::make_unique<FDIV_D>(machineCode);
+                case 0x2C: if (rs2 == 0) return std::make_unique<FSQRT_S>(machineCode); break;
+                case 0x2D: if (rs2 == 0) return std::make_unique<FSQRT_D>(machineCode); break;
+                case 0x10:
+                    if (funct3 == 0x0) return std::make_unique<FSGNJ_S>(machineCode);
+                    if (funct3 == 0x1) return std::make_unique<FSGNJN_S>(machineCode);
+                    if (funct3 == 0x2) return std::make_unique<FSGNJX_S>(machineCode);
+                    break;
+                case 0x11:
+                    if (funct3 == 0x0) return std::make_unique<FSGNJ_D>(machineCode);
+                    if (funct3 == 0x1) return std::make_unique<FSGNJN_D>(machineCode);
+                    if (funct3 == 0x2) return std::make_unique<FSGNJX_D>(machineCode);
+                    break;
+                case 0x14:
+                    if (funct3 == 0x0) return std::make_unique<FMIN_S>(machineCode);
+                    if (funct3 == 0x1) return std::make_unique<FMAX_S>(machineCode);
+                    break;
+                case 0x15:
+                    if (funct3 == 0x0) return std::make_unique<FMIN_D>(machineCode);
+                    if (funct3 == 0x1) return std::make_unique<FMAX_D>(machineCode);
+                    break;
+                case 0x20: if (rs2 == 1) return std::make_unique<FCVT_S_D>(machineCode); break;
+                case 0x21: if (rs2 == 0) return std::make_unique<FCVT_D_S>(machineCode); break;
+                case 0x50:
+                    if (funct3 == 0x0) return std::make_unique<FLE_S>(machineCode);
+                    if (funct3 == 0x1) return std::make_unique<FLT_S>(machineCode);
+                    if (funct3 == 0x2) return std::make_unique<FEQ_S>(machineCode);
+                    break;
+                case 0x51:
+                    if (funct3 == 0x0) return std::make_unique<FLE_D>(machineCode);
+                    if (funct3 == 0x1) return std::make_unique<FLT_D>(machineCode);
+                    if (funct3 == 0x2) return std::make_unique<FEQ_D>(machineCode);
+                    break;
+                case 0x60:
+                    switch (rs2) {
+                        case 0x0: return std::make_unique<FCVT_W_S>(machineCode);
+                        case 0x1: return std::make_unique<FCVT_WU_S>(machineCode);
+                        case 0x2: return std::make_unique<FCVT_L_S>(machineCode);
+                        case 0x3: return std::make_unique<FCVT_LU_S>(machineCode);
+                    }
+                    break;
+                case 0x61:
+                    switch (rs2) {
+                        case 0x0: return std::make_unique<FCVT_W_D>(machineCode);
+                        case 0x1: return std::make_unique<FCVT_WU_D>(machineCode);
+                        case 0x2: return std::make_unique<FCVT_L_D>(machineCode);
+                        case 0x3: return std::make_unique<FCVT_LU_D>(machineCode);
+                    }
+                    break;
+                case 0x68:
+                    switch (rs2) {
+                        case 0x0: return std::make_unique<FCVT_S_W>(machineCode);
+                        case 0x1: return std::make_unique<FCVT_S_WU>(machineCode);
+                        case 0x2: return std::make_unique<FCVT_S_L>(machineCode);
+                        case 0x3: return std::make_unique<FCVT_S_LU>(machineCode);
+                    }
+                    break;
+                case 0x69:
+                    switch (rs2) {
+                        case 0x0: return std::make_unique<FCVT_D_W>(machineCode);
+                        case 0x1: return std::make_unique<FCVT_D_WU>(machineCode);
+                        case 0x2: return std::make_unique<FCVT_D_L>(machineCode);
+                        case 0x3: return std::make_unique<FCVT_D_LU>(machineCode);
+                    }
+                    break;
+                case 0x70:
+                    if (rs2 == 0 && funct3 == 0x0) return std::make_unique<FMV_X_W>(machineCode);
+                    if (rs2 == 0 && funct3 == 0x1) return std::make_unique<FCLASS_S>(machineCode);
+                    break;
+                case 0x71:
+                    if (rs2 == 0 && funct3 == 0x0) return std::make_unique<FMV_X_D>(machineCode);
+                    if (rs2 == 0 && funct3 == 0x1) return std::make_unique<FCLASS_D>(machineCode);
+                    break;
+                case 0x78: if (rs2 == 0 && funct3 == 0x0) return std::make_unique<FMV_W_X>(machineCode); break;
+                case 0x79: if (rs2 == 0 && funct3 == 0x0) return std::make_unique<FMV_D_X>(machineCode); break;
+            }
+            break;
+        }
+        case 0x57: // OP-V
+            if (std::unique_ptr<Instruction> vector = VectorInstruction::decode(machineCode)) return vector;
+            break;
         case 0x63: // BRANCH
             switch(funct3) {
                 case 0x0: return std::make_unique<BEQ>(machineCode);
@@ -106,10 +354,27 @@ std::unique_ptr<Instruction> Instruction::decode(uint32_t machineCode) {
             break;
         case 0x67: return std::make_unique<JALR>(machineCode);
         case 0x6F: return std::make_unique<JAL>(machineCode);
+        case 0x73: // SYSTEM
+            if (machineCode == 0x10500073) return std::make_unique<WFI>(machineCode);
+            switch(funct3) {
+                case 0x1: return std::make_unique<CSRRW>(machineCode);
+                case 0x2: return std::make_unique<CSRRS>(machineCode);
+                case 0x3: return std::make_unique<CSRRC>(machineCode);
+                case 0x5: return std::make_unique<CSRRWI>(machineCode);
+                case 0x6: return std::make_unique<CSRRSI>(machineCode);
+                case 0x7: return std::make_unique<CSRRCI>(machineCode);
+            }
+            break;
     }
     throw std::runtime_error("Unknown instruction");
 }
 
+std::unique_ptr<Instruction> Instruction::decode(uint32_t machineCode, unsigned length) {
+    std::unique_ptr<Instruction> inst = decode(machineCode);
+    inst->encodedLength = length;
+    return inst;
+}
+
 // LOAD instructions
 // LB::LB(uint32_t machineCode) : Instruction(machineCode) {
 //     rd = (machineCode >> 7) & 0x1F;
@@ -1035,354 +1300,1561 @@ uint64_t SRAW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /
     return 0; // No jump address
 }
 
-// BRANCH instructions
-JAL::JAL(uint32_t machineCode) : Instruction(machineCode) {
+// M extension instructions. Each runs as a single host operation; the high
+// halves of MULH* come from a 128-bit product. Division never traps: by zero
+// it yields all ones (remainder: the dividend), and the signed overflow case
+// INT_MIN / -1 yields the dividend (remainder: zero), as the spec requires.
+MUL::MUL(uint32_t machineCode) : Instruction(machineCode) {
     rd = (machineCode >> 7) & 0x1F;
-    
-    // Unpack the immediate components
-    uint32_t imm20 = (machineCode >> 31) & 0x1;
-    uint32_t imm10_1 = (machineCode >> 21) & 0x3FF;
-    uint32_t imm11 = (machineCode >> 20) & 0x1;
-    uint32_t imm19_12 = (machineCode >> 12) & 0xFF;
-    
-    // Assemble the immediate
-    imm = signExtend(
-        (imm20 << 20) |
-        (imm19_12 << 12) |
-        (imm11 << 11) |
-        (imm10_1 << 1),
-        21
-    );
-    
-    // Add debug output
-    // std::cout << "JAL Immediate components:" << std::endl;
-    // std::cout << "  imm20: " << imm20 << std::endl;
-    // std::cout << "  imm19_12: 0x" << std::hex << imm19_12 << std::endl;
-    // std::cout << "  imm11: " << std::dec << imm11 << std::endl;
-    // std::cout << "  imm10_1: 0x" << std::hex << imm10_1 << std::endl;
-    // std::cout << "  Final imm: 0x" << std::hex << imm << std::endl;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
 }
 
-void JAL::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    uint64_t return_address = current_pc + 4;
-    uint64_t jump_address = current_pc + imm;
-
-    rf.write(rd, return_address);
-    rf.write(RegisterFile::PC, jump_address);
-
-    // std::cout << "JAL Debug:" << std::endl;
-    // std::cout << "  Current PC: 0x" << std::hex << current_pc << std::endl;
-    // std::cout << "  Return Address: 0x" << std::hex << return_address << std::endl;
-    // std::cout << "  Jump Address: 0x" << std::hex << jump_address << std::endl;
-    // std::cout << "  Updated PC: 0x" << std::hex << rf.read(RegisterFile::PC) << std::endl;
+void MUL::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, rf.read(rs1) * rf.read(rs2));
 }
 
-std::string JAL::toString() const {
+std::string MUL::toString() const {
     std::stringstream ss;
-    ss << "jal x" << rd << ", " << (static_cast<int32_t>(imm));
+    ss << "mul x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool JAL::isJump() const {
-    return true; // JAL is a jump instruction
+bool MUL::isJump() const {
+    return false; // MUL is not a jump instruction
 }
 
-uint64_t JAL::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return imm; // Return the immediate value as the jump address
+uint64_t MUL::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// JALR instruction implementation
-JALR::JALR(uint32_t machineCode) : Instruction(machineCode) {
+MULH::MULH(uint32_t machineCode) : Instruction(machineCode) {
     rd = (machineCode >> 7) & 0x1F;
     rs1 = (machineCode >> 15) & 0x1F;
-    imm = signExtend(machineCode >> 20, 12);
+    rs2 = (machineCode >> 20) & 0x1F;
 }
 
-void JALR::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    uint64_t return_address = current_pc + 4;
-    uint64_t jump_address = (rf.read(rs1) + imm) & ~1ULL;  // Clear least significant bit
-
-    rf.write(rd, return_address);
-    rf.write(RegisterFile::PC, jump_address);
+void MULH::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<uint64_t>((static_cast<int128>(static_cast<int64_t>(rf.read(rs1))) *
+                                           static_cast<int64_t>(rf.read(rs2))) >> 64));
 }
 
-std::string JALR::toString() const {
+std::string MULH::toString() const {
     std::stringstream ss;
-    ss << "jalr x" << rd << ", x" << rs1 << ", " << imm;
+    ss << "mulh x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool JALR::isJump() const {
-    return true; // JALR is a jump instruction
+bool MULH::isJump() const {
+    return false; // MULH is not a jump instruction
 }
 
-uint64_t JALR::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return rf.read(rs1) + imm; // Return the calculated address
+uint64_t MULH::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// BEQ instruction implementation
-BEQ::BEQ(uint32_t machineCode) : Instruction(machineCode) {
+MULHSU::MULHSU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
     rs1 = (machineCode >> 15) & 0x1F;
     rs2 = (machineCode >> 20) & 0x1F;
-    imm = signExtend(
-        ((machineCode >> 31) & 0x1) << 12 |
-        ((machineCode >> 25) & 0x3F) << 5 |
-        ((machineCode >> 8) & 0xF) << 1 |
-        ((machineCode >> 7) & 0x1) << 11,
-        13
-    );
 }
 
-void BEQ::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    if (rf.read(rs1) == rf.read(rs2)) {
-        rf.write(RegisterFile::PC, current_pc + imm);
-    } else {
-        rf.write(RegisterFile::PC, current_pc + 4);
-    }
+void MULHSU::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<uint64_t>((static_cast<int128>(static_cast<int64_t>(rf.read(rs1))) *
+                                           static_cast<int128>(rf.read(rs2))) >> 64));
 }
 
-std::string BEQ::toString() const {
+std::string MULHSU::toString() const {
     std::stringstream ss;
-    ss << "beq x" << rs1 << ", x" << rs2 << ", " << (static_cast<int32_t>(imm));
+    ss << "mulhsu x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool BEQ::isJump() const {
-    return true; // BEQ is a jump instruction
+bool MULHSU::isJump() const {
+    return false; // MULHSU is not a jump instruction
 }
 
-uint64_t BEQ::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return imm; // Return the immediate value as the jump address
+uint64_t MULHSU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// BNE instruction implementation
-BNE::BNE(uint32_t machineCode) : Instruction(machineCode) {
+MULHU::MULHU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
     rs1 = (machineCode >> 15) & 0x1F;
     rs2 = (machineCode >> 20) & 0x1F;
-    imm = signExtend(
-        ((machineCode >> 31) & 0x1) << 12 |
-        ((machineCode >> 25) & 0x3F) << 5 |
-        ((machineCode >> 8) & 0xF) << 1 |
-        ((machineCode >> 7) & 0x1) << 11,
-        13
-    );
 }
 
-void BNE::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    if (rf.read(rs1) != rf.read(rs2)) {
-        rf.write(RegisterFile::PC, current_pc + imm);
-    } else {
-        rf.write(RegisterFile::PC, current_pc + 4);
-    }
+void MULHU::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.write(rd, static_cast<uint64_t>((static_cast<uint128>(rf.read(rs1)) * rf.read(rs2)) >> 64));
 }
 
-std::string BNE::toString() const {
+std::string MULHU::toString() const {
     std::stringstream ss;
-    ss << "bne x" << rs1 << ", x" << rs2 << ", " << imm;
+    ss << "mulhu x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool BNE::isJump() const {
-    return true; // BNE is a jump instruction
+bool MULHU::isJump() const {
+    return false; // MULHU is not a jump instruction
 }
 
-uint64_t BNE::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return imm; // Return the immediate value as the jump address
+uint64_t MULHU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// BLT instruction implementation
-BLT::BLT(uint32_t machineCode) : Instruction(machineCode) {
-   rs1 = (machineCode >> 15) & 0x1F;
+DIV::DIV(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
     rs2 = (machineCode >> 20) & 0x1F;
-    imm = signExtend(
-        ((machineCode >> 31) & 0x1) << 12 |
-        ((machineCode >> 25) & 0x3F) << 5 |
-        ((machineCode >> 8) & 0xF) << 1 |
-        ((machineCode >> 7) & 0x1) << 11,
-        13
-    );
 }
 
-void BLT::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    if (static_cast<int64_t>(rf.read(rs1)) < static_cast<int64_t>(rf.read(rs2))) {
-        rf.write(RegisterFile::PC, current_pc + imm);
+void DIV::execute(RegisterFile& rf, Memory& /* mem */) {
+    int64_t dividend = rf.read(rs1);
+    int64_t divisor = rf.read(rs2);
+    if (divisor == 0) {
+        rf.write(rd, UINT64_MAX);
+    } else if (dividend == INT64_MIN && divisor == -1) {
+        rf.write(rd, dividend); // Overflow: the quotient wraps to the dividend
     } else {
-        rf.write(RegisterFile::PC, current_pc + 4);
+        rf.write(rd, dividend / divisor);
     }
 }
 
-std::string BLT::toString() const {
+std::string DIV::toString() const {
     std::stringstream ss;
-    ss << "blt x" << rs1 << ", x" << rs2 << ", " << imm;
+    ss << "div x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool BLT::isJump() const {
-    return true; // BEQ is a jump instruction
+bool DIV::isJump() const {
+    return false; // DIV is not a jump instruction
 }
 
-uint64_t BLT::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return imm; // Return the immediate value as the jump address
+uint64_t DIV::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// BGE instruction implementation
-BGE::BGE(uint32_t machineCode) : Instruction(machineCode) {
+DIVU::DIVU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
     rs1 = (machineCode >> 15) & 0x1F;
     rs2 = (machineCode >> 20) & 0x1F;
-    imm = signExtend(
-        ((machineCode >> 31) & 0x1) << 12 |
-        ((machineCode >> 25) & 0x3F) << 5 |
-        ((machineCode >> 8) & 0xF) << 1 |
-        ((machineCode >> 7) & 0x1) << 11,
-        13
-    );
 }
 
-void BGE::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    if (static_cast<int64_t>(rf.read(rs1)) >= static_cast<int64_t>(rf.read(rs2))) {
-        rf.write(RegisterFile::PC, current_pc + imm);
-    } else {
-        rf.write(RegisterFile::PC, current_pc + 4);
-    }
+void DIVU::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t divisor = rf.read(rs2);
+    rf.write(rd, divisor == 0 ? UINT64_MAX : rf.read(rs1) / divisor);
 }
 
-std::string BGE::toString() const {
+std::string DIVU::toString() const {
     std::stringstream ss;
-    ss << "bge x" << rs1 << ", x" << rs2 << ", " << imm;
+    ss << "divu x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool BGE::isJump() const {
-    return true; // BEQ is a jump instruction
+bool DIVU::isJump() const {
+    return false; // DIVU is not a jump instruction
 }
 
-uint64_t BGE::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return imm; // Return the immediate value as the jump address
+uint64_t DIVU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// BLTU instruction implementation
-BLTU::BLTU(uint32_t machineCode) : Instruction(machineCode) {
+REM::REM(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
     rs1 = (machineCode >> 15) & 0x1F;
     rs2 = (machineCode >> 20) & 0x1F;
-    imm = signExtend(
-        ((machineCode >> 31) & 0x1) << 12 |
-        ((machineCode >> 25) & 0x3F) << 5 |
-        ((machineCode >> 8) & 0xF) << 1 |
-        ((machineCode >> 7) & 0x1) << 11,
-        13
-    );
 }
 
-void BLTU::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    if (rf.read(rs1) < rf.read(rs2)) {
-        rf.write(RegisterFile::PC, current_pc + imm);
+void REM::execute(RegisterFile& rf, Memory& /* mem */) {
+    int64_t dividend = rf.read(rs1);
+    int64_t divisor = rf.read(rs2);
+    if (divisor == 0) {
+        rf.write(rd, dividend);
+    } else if (dividend == INT64_MIN && divisor == -1) {
+        rf.write(rd, 0);
     } else {
-        rf.write(RegisterFile::PC, current_pc + 4);
+        rf.write(rd, dividend % divisor);
     }
 }
 
-std::string BLTU::toString() const {
+std::string REM::toString() const {
     std::stringstream ss;
-    ss << "bltu x" << rs1 << ", x" << rs2 << ", " << imm;
+    ss << "rem x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool BLTU::isJump() const {
-    return true; // BEQ is a jump instruction
+bool REM::isJump() const {
+    return false; // REM is not a jump instruction
 }
 
-uint64_t BLTU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return imm; // Return the immediate value as the jump address
+uint64_t REM::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// BGEU instruction implementation
-BGEU::BGEU(uint32_t machineCode) : Instruction(machineCode) {
+REMU::REMU(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
     rs1 = (machineCode >> 15) & 0x1F;
     rs2 = (machineCode >> 20) & 0x1F;
-    imm = signExtend(
-        ((machineCode >> 31) & 0x1) << 12 |
-        ((machineCode >> 25) & 0x3F) << 5 |
-        ((machineCode >> 8) & 0xF) << 1 |
-        ((machineCode >> 7) & 0x1) << 11,
-        13
-    );
 }
 
-void BGEU::execute(RegisterFile& rf, Memory& /* mem */) {
-    uint64_t current_pc = rf.read(RegisterFile::PC);
-    if (rf.read(rs1) >= rf.read(rs2)) {
-        rf.write(RegisterFile::PC, current_pc + imm);
-    } else {
-        rf.write(RegisterFile::PC, current_pc + 4);
-    }
+void REMU::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t dividend = rf.read(rs1);
+    uint64_t divisor = rf.read(rs2);
+    rf.write(rd, divisor == 0 ? dividend : dividend % divisor);
 }
 
-std::string BGEU::toString() const {
+std::string REMU::toString() const {
     std::stringstream ss;
-    ss << "bgeu x" << rs1 << ", x" << rs2 << ", " << imm;
+    ss << "remu x" << rd << ", x" << rs1 << ", x" << rs2;
     return ss.str();
 }
 
-bool BGEU::isJump() const {
-    return true; // BEQ is a jump instruction
+bool REMU::isJump() const {
+    return false; // REMU is not a jump instruction
 }
 
-uint64_t BGEU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
-    return imm; // Return the immediate value as the jump address
+uint64_t REMU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
 }
 
-// LUI instruction
-LUI::LUI(uint32_t machineCode) : Instruction(machineCode) {
+MULW::MULW(uint32_t machineCode) : Instruction(machineCode) {
     rd = (machineCode >> 7) & 0x1F;
-        imm = (machineCode >> 12) & 0xFFFFF;// Get the upper 20 bits
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
 }
 
-void LUI::execute(RegisterFile& rf, Memory& /* mem */) {
-      uint64_t value = static_cast<uint64_t>(imm) << 12;
-        rf.write(rd, value);
+void MULW::execute(RegisterFile& rf, Memory& /* mem */) {
+    int32_t result = static_cast<int32_t>(rf.read(rs1) * rf.read(rs2));
+    rf.write(rd, signExtend(result, 32));
 }
 
-std::string LUI::toString() const {
+std::string MULW::toString() const {
     std::stringstream ss;
-        ss << "lui x" << rd << ", 0x" << std::hex << imm << std::dec;
-        return ss.str();
+    ss << "mulw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
 }
 
-bool LUI::isJump() const {
-    return false; // LUI is not a jump instruction
+bool MULW::isJump() const {
+    return false; // MULW is not a jump instruction
 }
 
-uint64_t LUI::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+uint64_t MULW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
     return 0; // No jump address
 }
 
-// AUIPC instruction
-AUIPC::AUIPC(uint32_t machineCode) : Instruction(machineCode) {
+DIVW::DIVW(uint32_t machineCode) : Instruction(machineCode) {
     rd = (machineCode >> 7) & 0x1F;
-    imm = machineCode & 0xFFFFF000;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void DIVW::execute(RegisterFile& rf, Memory& /* mem */) {
+    int32_t dividend = static_cast<int32_t>(rf.read(rs1));
+    int32_t divisor = static_cast<int32_t>(rf.read(rs2));
+    int32_t result;
+    if (divisor == 0) {
+        result = -1;
+    } else if (dividend == INT32_MIN && divisor == -1) {
+        result = dividend;
+    } else {
+        result = dividend / divisor;
+    }
+    rf.write(rd, signExtend(result, 32));
+}
+
+std::string DIVW::toString() const {
+    std::stringstream ss;
+    ss << "divw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool DIVW::isJump() const {
+    return false; // DIVW is not a jump instruction
+}
+
+uint64_t DIVW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+DIVUW::DIVUW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void DIVUW::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint32_t dividend = static_cast<uint32_t>(rf.read(rs1));
+    uint32_t divisor = static_cast<uint32_t>(rf.read(rs2));
+    int32_t result = static_cast<int32_t>(divisor == 0 ? UINT32_MAX : dividend / divisor);
+    rf.write(rd, signExtend(result, 32));
+}
+
+std::string DIVUW::toString() const {
+    std::stringstream ss;
+    ss << "divuw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool DIVUW::isJump() const {
+    return false; // DIVUW is not a jump instruction
+}
+
+uint64_t DIVUW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+REMW::REMW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void REMW::execute(RegisterFile& rf, Memory& /* mem */) {
+    int32_t dividend = static_cast<int32_t>(rf.read(rs1));
+    int32_t divisor = static_cast<int32_t>(rf.read(rs2));
+    int32_t result;
+    if (divisor == 0) {
+        result = dividend;
+    } else if (dividend == INT32_MIN && divisor == -1) {
+        result = 0;
+    } else {
+        result = dividend % divisor;
+    }
+    rf.write(rd, signExtend(result, 32));
+}
+
+std::string REMW::toString() const {
+    std::stringstream ss;
+    ss << "remw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool REMW::isJump() const {
+    return false; // REMW is not a jump instruction
+}
+
+uint64_t REMW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+REMUW::REMUW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+}
+
+void REMUW::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint32_t dividend = static_cast<uint32_t>(rf.read(rs1));
+    uint32_t divisor = static_cast<uint32_t>(rf.read(rs2));
+    int32_t result = static_cast<int32_t>(divisor == 0 ? dividend : dividend % divisor);
+    rf.write(rd, signExtend(result, 32));
+}
+
+std::string REMUW::toString() const {
+    std::stringstream ss;
+    ss << "remuw x" << rd << ", x" << rs1 << ", x" << rs2;
+    return ss.str();
+}
+
+bool REMUW::isJump() const {
+    return false; // REMUW is not a jump instruction
+}
+
+uint64_t REMUW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+// BRANCH instructions
+JAL::JAL(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    
+    // Unpack the immediate components
+    uint32_t imm20 = (machineCode >> 31) & 0x1;
+    uint32_t imm10_1 = (machineCode >> 21) & 0x3FF;
+    uint32_t imm11 = (machineCode >> 20) & 0x1;
+    uint32_t imm19_12 = (machineCode >> 12) & 0xFF;
+    
+    // Assemble the immediate
+    imm = signExtend(
+        (imm20 << 20) |
+        (imm19_12 << 12) |
+        (imm11 << 11) |
+        (imm10_1 << 1),
+        21
+    );
+    
+    // Add debug output
+    // std::cout << "JAL Immediate components:" << std::endl;
+    // std::cout << "  imm20: " << imm20 << std::endl;
+    // std::cout << "  imm19_12: 0x" << std::hex << imm19_12 << std::endl;
+    // std::cout << "  imm11: " << std::dec << imm11 << std::endl;
+    // std::cout << "  imm10_1: 0x" << std::hex << imm10_1 << std::endl;
+    // std::cout << "  Final imm: 0x" << std::hex << imm << std::endl;
+}
+
+void JAL::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    uint64_t return_address = current_pc + encodedLength;
+    uint64_t jump_address = current_pc + imm;
+
+    rf.write(rd, return_address);
+    rf.write(RegisterFile::PC, jump_address);
+
+    // std::cout << "JAL Debug:" << std::endl;
+    // std::cout << "  Current PC: 0x" << std::hex << current_pc << std::endl;
+    // std::cout << "  Return Address: 0x" << std::hex << return_address << std::endl;
+    // std::cout << "  Jump Address: 0x" << std::hex << jump_address << std::endl;
+    // std::cout << "  Updated PC: 0x" << std::hex << rf.read(RegisterFile::PC) << std::endl;
+}
+
+std::string JAL::toString() const {
+    std::stringstream ss;
+    ss << "jal x" << rd << ", " << (static_cast<int32_t>(imm));
+    return ss.str();
+}
+
+bool JAL::isJump() const {
+    return true; // JAL is a jump instruction
+}
+
+uint64_t JAL::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // Return the immediate value as the jump address
+}
+
+// JALR instruction implementation
+JALR::JALR(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = signExtend(machineCode >> 20, 12);
+}
+
+void JALR::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    uint64_t return_address = current_pc + encodedLength;
+    uint64_t jump_address = (rf.read(rs1) + imm) & ~1ULL;  // Clear least significant bit
+
+    rf.write(rd, return_address);
+    rf.write(RegisterFile::PC, jump_address);
+}
+
+std::string JALR::toString() const {
+    std::stringstream ss;
+    ss << "jalr x" << rd << ", x" << rs1 << ", " << imm;
+    return ss.str();
+}
+
+bool JALR::isJump() const {
+    return true; // JALR is a jump instruction
+}
+
+uint64_t JALR::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // rs1 is only known at run time
+}
+
+// BEQ instruction implementation
+BEQ::BEQ(uint32_t machineCode) : Instruction(machineCode) {
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(
+        ((machineCode >> 31) & 0x1) << 12 |
+        ((machineCode >> 25) & 0x3F) << 5 |
+        ((machineCode >> 8) & 0xF) << 1 |
+        ((machineCode >> 7) & 0x1) << 11,
+        13
+    );
+}
+
+void BEQ::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    if (rf.read(rs1) == rf.read(rs2)) {
+        rf.write(RegisterFile::PC, current_pc + imm);
+    } else {
+        rf.write(RegisterFile::PC, current_pc + encodedLength);
+    }
+}
+
+std::string BEQ::toString() const {
+    std::stringstream ss;
+    ss << "beq x" << rs1 << ", x" << rs2 << ", " << (static_cast<int32_t>(imm));
+    return ss.str();
+}
+
+bool BEQ::isJump() const {
+    return true; // BEQ is a jump instruction
+}
+
+uint64_t BEQ::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // Return the immediate value as the jump address
+}
+
+// BNE instruction implementation
+BNE::BNE(uint32_t machineCode) : Instruction(machineCode) {
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(
+        ((machineCode >> 31) & 0x1) << 12 |
+        ((machineCode >> 25) & 0x3F) << 5 |
+        ((machineCode >> 8) & 0xF) << 1 |
+        ((machineCode >> 7) & 0x1) << 11,
+        13
+    );
+}
+
+void BNE::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    if (rf.read(rs1) != rf.read(rs2)) {
+        rf.write(RegisterFile::PC, current_pc + imm);
+    } else {
+        rf.write(RegisterFile::PC, current_pc + encodedLength);
+    }
+}
+
+std::string BNE::toString() const {
+    std::stringstream ss;
+    ss << "bne x" << rs1 << ", x" << rs2 << ", " << imm;
+    return ss.str();
+}
+
+bool BNE::isJump() const {
+    return true; // BNE is a jump instruction
+}
+
+uint64_t BNE::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // Return the immediate value as the jump address
+}
+
+// BLT instruction implementation
+BLT::BLT(uint32_t machineCode) : Instruction(machineCode) {
+   rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(
+        ((machineCode >> 31) & 0x1) << 12 |
+        ((machineCode >> 25) & 0x3F) << 5 |
+        ((machineCode >> 8) & 0xF) << 1 |
+        ((machineCode >> 7) & 0x1) << 11,
+        13
+    );
+}
+
+void BLT::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    if (static_cast<int64_t>(rf.read(rs1)) < static_cast<int64_t>(rf.read(rs2))) {
+        rf.write(RegisterFile::PC, current_pc + imm);
+    } else {
+        rf.write(RegisterFile::PC, current_pc + encodedLength);
+    }
+}
+
+std::string BLT::toString() const {
+    std::stringstream ss;
+    ss << "blt x" << rs1 << ", x" << rs2 << ", " << imm;
+    return ss.str();
+}
+
+bool BLT::isJump() const {
+    return true; // BEQ is a jump instruction
+}
+
+uint64_t BLT::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // Return the immediate value as the jump address
+}
+
+// BGE instruction implementation
+BGE::BGE(uint32_t machineCode) : Instruction(machineCode) {
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(
+        ((machineCode >> 31) & 0x1) << 12 |
+        ((machineCode >> 25) & 0x3F) << 5 |
+        ((machineCode >> 8) & 0xF) << 1 |
+        ((machineCode >> 7) & 0x1) << 11,
+        13
+    );
+}
+
+void BGE::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    if (static_cast<int64_t>(rf.read(rs1)) >= static_cast<int64_t>(rf.read(rs2))) {
+        rf.write(RegisterFile::PC, current_pc + imm);
+    } else {
+        rf.write(RegisterFile::PC, current_pc + encodedLength);
+    }
+}
+
+std::string BGE::toString() const {
+    std::stringstream ss;
+    ss << "bge x" << rs1 << ", x" << rs2 << ", " << imm;
+    return ss.str();
+}
+
+bool BGE::isJump() const {
+    return true; // BEQ is a jump instruction
+}
+
+uint64_t BGE::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // Return the immediate value as the jump address
+}
+
+// BLTU instruction implementation
+BLTU::BLTU(uint32_t machineCode) : Instruction(machineCode) {
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(
+        ((machineCode >> 31) & 0x1) << 12 |
+        ((machineCode >> 25) & 0x3F) << 5 |
+        ((machineCode >> 8) & 0xF) << 1 |
+        ((machineCode >> 7) & 0x1) << 11,
+        13
+    );
+}
+
+void BLTU::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    if (rf.read(rs1) < rf.read(rs2)) {
+        rf.write(RegisterFile::PC, current_pc + imm);
+    } else {
+        rf.write(RegisterFile::PC, current_pc + encodedLength);
+    }
+}
+
+std::string BLTU::toString() const {
+    std::stringstream ss;
+    ss << "bltu x" << rs1 << ", x" << rs2 << ", " << imm;
+    return ss.str();
+}
+
+bool BLTU::isJump() const {
+    return true; // BEQ is a jump instruction
+}
+
+uint64_t BLTU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // Return the immediate value as the jump address
+}
+
+// BGEU instruction implementation
+BGEU::BGEU(uint32_t machineCode) : Instruction(machineCode) {
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = signExtend(
+        ((machineCode >> 31) & 0x1) << 12 |
+        ((machineCode >> 25) & 0x3F) << 5 |
+        ((machineCode >> 8) & 0xF) << 1 |
+        ((machineCode >> 7) & 0x1) << 11,
+        13
+    );
+}
+
+void BGEU::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t current_pc = rf.read(RegisterFile::PC);
+    if (rf.read(rs1) >= rf.read(rs2)) {
+        rf.write(RegisterFile::PC, current_pc + imm);
+    } else {
+        rf.write(RegisterFile::PC, current_pc + encodedLength);
+    }
+}
+
+std::string BGEU::toString() const {
+    std::stringstream ss;
+    ss << "bgeu x" << rs1 << ", x" << rs2 << ", " << imm;
+    return ss.str();
+}
+
+bool BGEU::isJump() const {
+    return true; // BEQ is a jump instruction
+}
+
+uint64_t BGEU::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return imm; // Return the immediate value as the jump address
+}
+
+// LUI instruction
+LUI::LUI(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+        imm = (machineCode >> 12) & 0xFFFFF;// Get the upper 20 bits
+}
+
+void LUI::execute(RegisterFile& rf, Memory& /* mem */) {
+      uint64_t value = static_cast<uint64_t>(imm) << 12;
+        rf.write(rd, value);
+}
+
+std::string LUI::toString() const {
+    std::stringstream ss;
+        ss << "lui x" << rd << ", 0x" << std::hex << imm << std::dec;
+        return ss.str();
+}
+
+bool LUI::isJump() const {
+    return false; // LUI is not a jump instruction
+}
+
+uint64_t LUI::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+// AUIPC instruction
+AUIPC::AUIPC(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    imm = machineCode & 0xFFFFF000;
 }
 
 void AUIPC::execute(RegisterFile& rf, Memory& /* mem */) {
     rf.write(rd, rf.read(RegisterFile::PC) + imm - 4);
 }
 
-std::string AUIPC::toString() const {
+std::string AUIPC::toString() const {
+    std::stringstream ss;
+    ss << "auipc x" << rd << ", " << (imm >> 12);
+    return ss.str();
+}
+
+bool AUIPC::isJump() const {
+    return false; // LUI is not a jump instruction
+}
+
+uint64_t AUIPC::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+// AMO instructions (A extension). aq/rl are accepted and ignored: every
+// atomic access is sequentially consistent on the host.
+
+// A hart holds at most one reservation; LR replaces it and SC consumes it
+static void releaseReservation(RegisterFile& rf, Memory& mem) {
+    uint64_t address, value, generation;
+    if (rf.takeReservation(address, value, generation)) {
+        mem.releaseReservation(address);
+    }
+}
+
+static bool storeConditional(RegisterFile& rf, Memory& mem, uint64_t addr, int size, uint64_t desired) {
+    uint64_t address, value, generation;
+    if (!rf.takeReservation(address, value, generation)) {
+        return false;
+    }
+    if (address != addr) {
+        mem.releaseReservation(address);
+        return false;
+    }
+    return mem.storeConditional(addr, size, generation, value, desired);
+}
+
+LR_W::LR_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void LR_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1);
+    releaseReservation(rf, mem);
+    uint64_t generation;
+    uint64_t value = mem.loadReserved(addr, 4, generation);
+    rf.setReservation(addr, value, generation);
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string LR_W::toString() const {
+    std::stringstream ss;
+    ss << "lr.w x" << rd << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool LR_W::isJump() const {
+    return false;
+}
+
+uint64_t LR_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+SC_W::SC_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void SC_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1);
+    bool stored = storeConditional(rf, mem, addr, 4, rf.read(rs2));
+    rf.write(rd, stored ? 0 : 1);
+    if (!stored) {
+        rf.requestYield(RegisterFile::YIELD_SPIN);
+    }
+}
+
+std::string SC_W::toString() const {
+    std::stringstream ss;
+    ss << "sc.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool SC_W::isJump() const {
+    return false;
+}
+
+uint64_t SC_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOSWAP_W::AMOSWAP_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOSWAP_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_SWAP, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOSWAP_W::toString() const {
+    std::stringstream ss;
+    ss << "amoswap.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOSWAP_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOSWAP_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOADD_W::AMOADD_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOADD_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_ADD, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOADD_W::toString() const {
+    std::stringstream ss;
+    ss << "amoadd.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOADD_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOADD_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOXOR_W::AMOXOR_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOXOR_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_XOR, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOXOR_W::toString() const {
+    std::stringstream ss;
+    ss << "amoxor.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOXOR_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOXOR_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOAND_W::AMOAND_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOAND_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_AND, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOAND_W::toString() const {
+    std::stringstream ss;
+    ss << "amoand.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOAND_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOAND_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOOR_W::AMOOR_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOOR_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_OR, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOOR_W::toString() const {
+    std::stringstream ss;
+    ss << "amoor.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOOR_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOOR_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMIN_W::AMOMIN_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMIN_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_MIN, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOMIN_W::toString() const {
+    std::stringstream ss;
+    ss << "amomin.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMIN_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOMIN_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMAX_W::AMOMAX_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMAX_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_MAX, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOMAX_W::toString() const {
+    std::stringstream ss;
+    ss << "amomax.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMAX_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOMAX_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMINU_W::AMOMINU_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMINU_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_MINU, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOMINU_W::toString() const {
+    std::stringstream ss;
+    ss << "amominu.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMINU_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOMINU_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMAXU_W::AMOMAXU_W(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMAXU_W::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t value = mem.atomicOp(rf.read(rs1), 4, Memory::AMO_MAXU, rf.read(rs2));
+    rf.write(rd, signExtend(value, 32));
+}
+
+std::string AMOMAXU_W::toString() const {
+    std::stringstream ss;
+    ss << "amomaxu.w x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMAXU_W::isJump() const {
+    return false;
+}
+
+uint64_t AMOMAXU_W::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+LR_D::LR_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void LR_D::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1);
+    releaseReservation(rf, mem);
+    uint64_t generation;
+    uint64_t value = mem.loadReserved(addr, 8, generation);
+    rf.setReservation(addr, value, generation);
+    rf.write(rd, value);
+}
+
+std::string LR_D::toString() const {
+    std::stringstream ss;
+    ss << "lr.d x" << rd << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool LR_D::isJump() const {
+    return false;
+}
+
+uint64_t LR_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+SC_D::SC_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void SC_D::execute(RegisterFile& rf, Memory& mem) {
+    uint64_t addr = rf.read(rs1);
+    bool stored = storeConditional(rf, mem, addr, 8, rf.read(rs2));
+    rf.write(rd, stored ? 0 : 1);
+    if (!stored) {
+        rf.requestYield(RegisterFile::YIELD_SPIN);
+    }
+}
+
+std::string SC_D::toString() const {
     std::stringstream ss;
-    ss << "auipc x" << rd << ", " << (imm >> 12);
+    ss << "sc.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
     return ss.str();
 }
 
-bool AUIPC::isJump() const {
-    return false; // LUI is not a jump instruction
+bool SC_D::isJump() const {
+    return false;
 }
 
-uint64_t AUIPC::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+uint64_t SC_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOSWAP_D::AMOSWAP_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOSWAP_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_SWAP, rf.read(rs2)));
+}
+
+std::string AMOSWAP_D::toString() const {
+    std::stringstream ss;
+    ss << "amoswap.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOSWAP_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOSWAP_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOADD_D::AMOADD_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOADD_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_ADD, rf.read(rs2)));
+}
+
+std::string AMOADD_D::toString() const {
+    std::stringstream ss;
+    ss << "amoadd.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOADD_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOADD_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOXOR_D::AMOXOR_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOXOR_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_XOR, rf.read(rs2)));
+}
+
+std::string AMOXOR_D::toString() const {
+    std::stringstream ss;
+    ss << "amoxor.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOXOR_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOXOR_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOAND_D::AMOAND_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOAND_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_AND, rf.read(rs2)));
+}
+
+std::string AMOAND_D::toString() const {
+    std::stringstream ss;
+    ss << "amoand.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOAND_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOAND_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOOR_D::AMOOR_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOOR_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_OR, rf.read(rs2)));
+}
+
+std::string AMOOR_D::toString() const {
+    std::stringstream ss;
+    ss << "amoor.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOOR_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOOR_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMIN_D::AMOMIN_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMIN_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_MIN, rf.read(rs2)));
+}
+
+std::string AMOMIN_D::toString() const {
+    std::stringstream ss;
+    ss << "amomin.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMIN_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOMIN_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMAX_D::AMOMAX_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMAX_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_MAX, rf.read(rs2)));
+}
+
+std::string AMOMAX_D::toString() const {
+    std::stringstream ss;
+    ss << "amomax.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMAX_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOMAX_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMINU_D::AMOMINU_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMINU_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_MINU, rf.read(rs2)));
+}
+
+std::string AMOMINU_D::toString() const {
+    std::stringstream ss;
+    ss << "amominu.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMINU_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOMINU_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+AMOMAXU_D::AMOMAXU_D(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    rs2 = (machineCode >> 20) & 0x1F;
+    imm = 0;
+}
+
+void AMOMAXU_D::execute(RegisterFile& rf, Memory& mem) {
+    rf.write(rd, mem.atomicOp(rf.read(rs1), 8, Memory::AMO_MAXU, rf.read(rs2)));
+}
+
+std::string AMOMAXU_D::toString() const {
+    std::stringstream ss;
+    ss << "amomaxu.d x" << rd << ", x" << rs2 << ", (x" << rs1 << ")";
+    return ss.str();
+}
+
+bool AMOMAXU_D::isJump() const {
+    return false;
+}
+
+uint64_t AMOMAXU_D::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+// WFI: no interrupts are modelled, so it only tells a multi-hart scheduler
+// to run other harts before this one continues
+WFI::WFI(uint32_t machineCode) : Instruction(machineCode) {
+    rd = 0;
+    rs1 = 0;
+    rs2 = 0;
+    imm = 0;
+}
+
+void WFI::execute(RegisterFile& rf, Memory& /* mem */) {
+    rf.requestYield(RegisterFile::YIELD_WFI);
+}
+
+std::string WFI::toString() const {
+    return "wfi";
+}
+
+bool WFI::isJump() const {
+    return false;
+}
+
+uint64_t WFI::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0;
+}
+
+// Zicsr instructions. The CSR address is kept in imm and, for the
+// immediate forms, the 5-bit zero-extended operand in rs1. The CSR is
+// written before rd so a fault leaves both unchanged.
+
+CSRRW::CSRRW(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = machineCode >> 20;
+}
+
+void CSRRW::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t operand = rf.read(rs1);
+    uint64_t old = rd != 0 ? rf.readCsr(imm) : 0; // csrw does not read the CSR
+    rf.writeCsr(imm, operand);
+    rf.write(rd, old);
+}
+
+std::string CSRRW::toString() const {
+    std::stringstream ss;
+    const char* name = RegisterFile::csrName(imm);
+    ss << "csrrw x" << rd << ", ";
+    if (name) {
+        ss << name;
+    } else {
+        ss << "0x" << std::hex << imm << std::dec;
+    }
+    ss << ", x" << rs1;
+    return ss.str();
+}
+
+bool CSRRW::isJump() const {
+    return false; // CSRRW is not a jump instruction
+}
+
+uint64_t CSRRW::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CSRRS::CSRRS(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = machineCode >> 20;
+}
+
+void CSRRS::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t operand = rf.read(rs1);
+    uint64_t old = rf.readCsr(imm);
+    if (rs1 != 0) { // csrr and friends do not write the CSR
+        rf.writeCsr(imm, old | operand);
+    }
+    rf.write(rd, old);
+}
+
+std::string CSRRS::toString() const {
+    std::stringstream ss;
+    const char* name = RegisterFile::csrName(imm);
+    ss << "csrrs x" << rd << ", ";
+    if (name) {
+        ss << name;
+    } else {
+        ss << "0x" << std::hex << imm << std::dec;
+    }
+    ss << ", x" << rs1;
+    return ss.str();
+}
+
+bool CSRRS::isJump() const {
+    return false; // CSRRS is not a jump instruction
+}
+
+uint64_t CSRRS::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CSRRC::CSRRC(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = machineCode >> 20;
+}
+
+void CSRRC::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t operand = rf.read(rs1);
+    uint64_t old = rf.readCsr(imm);
+    if (rs1 != 0) { // csrr and friends do not write the CSR
+        rf.writeCsr(imm, old & ~operand);
+    }
+    rf.write(rd, old);
+}
+
+std::string CSRRC::toString() const {
+    std::stringstream ss;
+    const char* name = RegisterFile::csrName(imm);
+    ss << "csrrc x" << rd << ", ";
+    if (name) {
+        ss << name;
+    } else {
+        ss << "0x" << std::hex << imm << std::dec;
+    }
+    ss << ", x" << rs1;
+    return ss.str();
+}
+
+bool CSRRC::isJump() const {
+    return false; // CSRRC is not a jump instruction
+}
+
+uint64_t CSRRC::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CSRRWI::CSRRWI(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = machineCode >> 20;
+}
+
+void CSRRWI::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t operand = static_cast<uint64_t>(rs1);
+    uint64_t old = rd != 0 ? rf.readCsr(imm) : 0; // csrw does not read the CSR
+    rf.writeCsr(imm, operand);
+    rf.write(rd, old);
+}
+
+std::string CSRRWI::toString() const {
+    std::stringstream ss;
+    const char* name = RegisterFile::csrName(imm);
+    ss << "csrrwi x" << rd << ", ";
+    if (name) {
+        ss << name;
+    } else {
+        ss << "0x" << std::hex << imm << std::dec;
+    }
+    ss << ", " << rs1;
+    return ss.str();
+}
+
+bool CSRRWI::isJump() const {
+    return false; // CSRRWI is not a jump instruction
+}
+
+uint64_t CSRRWI::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CSRRSI::CSRRSI(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = machineCode >> 20;
+}
+
+void CSRRSI::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t operand = static_cast<uint64_t>(rs1);
+    uint64_t old = rf.readCsr(imm);
+    if (rs1 != 0) { // csrr and friends do not write the CSR
+        rf.writeCsr(imm, old | operand);
+    }
+    rf.write(rd, old);
+}
+
+std::string CSRRSI::toString() const {
+    std::stringstream ss;
+    const char* name = RegisterFile::csrName(imm);
+    ss << "csrrsi x" << rd << ", ";
+    if (name) {
+        ss << name;
+    } else {
+        ss << "0x" << std::hex << imm << std::dec;
+    }
+    ss << ", " << rs1;
+    return ss.str();
+}
+
+bool CSRRSI::isJump() const {
+    return false; // CSRRSI is not a jump instruction
+}
+
+uint64_t CSRRSI::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
+    return 0; // No jump address
+}
+
+CSRRCI::CSRRCI(uint32_t machineCode) : Instruction(machineCode) {
+    rd = (machineCode >> 7) & 0x1F;
+    rs1 = (machineCode >> 15) & 0x1F;
+    imm = machineCode >> 20;
+}
+
+void CSRRCI::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t operand = static_cast<uint64_t>(rs1);
+    uint64_t old = rf.readCsr(imm);
+    if (rs1 != 0) { // csrr and friends do not write the CSR
+        rf.writeCsr(imm, old & ~operand);
+    }
+    rf.write(rd, old);
+}
+
+std::string CSRRCI::toString() const {
+    std::stringstream ss;
+    const char* name = RegisterFile::csrName(imm);
+    ss << "csrrci x" << rd << ", ";
+    if (name) {
+        ss << name;
+    } else {
+        ss << "0x" << std::hex << imm << std::dec;
+    }
+    ss << ", " << rs1;
+    return ss.str();
+}
+
+bool CSRRCI::isJump() const {
+    return false; // CSRRCI is not a jump instruction
+}
+
+uint64_t CSRRCI::getJumpAddress(const std::unordered_map<std::string, uint64_t>& /* labels */) const {
     return 0; // No jump address
 }
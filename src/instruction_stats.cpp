@@ -0,0 +1,59 @@
+#include "../include/instruction_stats.h"
+#include "../include/profiler.h"
+#include <string>
+
+namespace {
+
+// Access width of a scalar load or store in bytes, 0 for vector accesses
+int accessWidth(uint32_t instruction) {
+    uint32_t opcode = instruction & 0x7F;
+    uint32_t funct3 = (instruction >> 12) & 0x7;
+    if (opcode == 0x07 || opcode == 0x27) { // LOAD-FP, STORE-FP: flh/fsh, flw/fsw, fld/fsd
+        return funct3 >= 1 && funct3 <= 3 ? 1 << funct3 : 0;
+    }
+    return 1 << (funct3 & 0x3);
+}
+
+std::string widthBucket(int width) {
+    return width == 0 ? "vector" : std::to_string(width);
+}
+
+} // namespace
+
+void InstructionStats::registerStats(StatsRegistry& stats, const Program& program) const {
+    uint64_t taken = 0, notTaken = 0, jumpCount = 0;
+    for (size_t i = 0; i < counts.size() && i < program.size(); ++i) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        uint32_t instruction = program.instruction(i);
+        stats.histogram("instructions.mix", Profiler::instructionClass(instruction), counts[i]);
+        bool load = false, store = false;
+        switch (instruction & 0x7F) {
+            case 0x03: case 0x07: load = true; break;
+            case 0x23: case 0x27: store = true; break;
+            case 0x2F: { // AMO: lr loads, sc stores, the rest do both
+                uint32_t funct5 = instruction >> 27;
+                load = funct5 != 0x03;
+                store = funct5 != 0x02;
+                break;
+            }
+            case 0x63:
+                taken += jumps[i];
+                notTaken += counts[i] - jumps[i];
+                break;
+            case 0x67: case 0x6F:
+                jumpCount += counts[i];
+                break;
+        }
+        if (load) {
+            stats.histogram("memory.loads_by_width", widthBucket(accessWidth(instruction)), counts[i]);
+        }
+        if (store) {
+            stats.histogram("memory.stores_by_width", widthBucket(accessWidth(instruction)), counts[i]);
+        }
+    }
+    stats.counter("branches.taken", taken);
+    stats.counter("branches.not_taken", notTaken);
+    stats.counter("jumps", jumpCount);
+}
@@ -1,11 +1,41 @@
 #include "../include/simulator.h"
+#include "../include/server.h"
+#include "../include/batch_runner.h"
+#include "../include/simt_runner.h"
+#include "../include/bench_runner.h"
+#include "../include/stream_consumers.h"
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--server") {
+        return serverMain(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        return batchMain(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--simt") {
+        return simtMain(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        return benchMain(argc, argv);
+    }
+
     Simulator sim;
     std::string command;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--perf-stats") {
+            sim.setPerfStats(true);
+        } else if (std::string(argv[i]) == "--stats" && i + 1 < argc) {
+            sim.setStatsFile(argv[++i]);
+        } else {
+            std::cerr << "Usage: simulator [--perf-stats] [--stats <file.json|file.csv>]"
+                      << " | --server ... | --batch ... | --simt ... | --bench ..." << std::endl;
+            return 1;
+        }
+    }
 
     // Automatically load the input file at startup
     // std::string inputFile = "input/input.hex";
@@ -19,7 +49,9 @@ int main() {
 
     while (true) {
         std::cout << "> ";
-        std::getline(std::cin, command);
+        if (!std::getline(std::cin, command)) {
+            break;
+        }
         std::istringstream iss(command);
         std::string cmd;
         iss >> cmd;
@@ -42,8 +74,253 @@ int main() {
             sim.run();
         } else if (cmd == "step") {
             sim.step();
+        } else if (cmd == "reverse-step") {
+            sim.reverseStep();
+        } else if (cmd == "reverse-continue") {
+            sim.reverseContinue();
+        } else if (cmd == "goto") {
+            size_t target = 0;
+            if (iss >> target) {
+                sim.gotoInstruction(target);
+            } else {
+                std::cout << "Usage: goto <instruction count>" << std::endl;
+            }
+        } else if (cmd == "reverse") {
+            std::string mode;
+            iss >> mode;
+            if (mode == "on" || mode == "off") {
+                sim.setReverseDebugging(mode == "on");
+                std::cout << "Reverse debugging " << mode << std::endl;
+            } else {
+                std::cout << "Usage: reverse on|off" << std::endl;
+            }
+        } else if (cmd == "reverse-config") {
+            size_t entries, interval, limit;
+            if (iss >> entries >> interval >> limit) {
+                sim.configureReverse(entries, interval, limit);
+            } else {
+                std::cout << "Usage: reverse-config <log-entries> <interval> <max-checkpoints>" << std::endl;
+            }
+        } else if (cmd == "reverse-stats") {
+            sim.printReverseStats();
+        } else if (cmd == "harts") {
+            int count = 0;
+            size_t limit = std::numeric_limits<size_t>::max();
+            if (iss >> count) {
+                iss >> limit;
+                sim.runHarts(count, limit);
+            } else {
+                std::cout << "Usage: harts <count> [instruction limit]" << std::endl;
+            }
+        } else if (cmd == "schedule") {
+            int count = 0;
+            size_t workers = 0;
+            size_t quantum = 0;
+            size_t limit = std::numeric_limits<size_t>::max();
+            if (iss >> count >> workers >> quantum) {
+                iss >> limit;
+                sim.scheduleHarts(count, workers, quantum, limit);
+            } else {
+                std::cout << "Usage: schedule <harts> <workers> <quantum> [instruction limit]" << std::endl;
+            }
+        } else if (cmd == "hart-regs") {
+            int id = 0;
+            if (iss >> id) {
+                sim.printHartRegs(id);
+            } else {
+                std::cout << "Usage: hart-regs <id>" << std::endl;
+            }
+        } else if (cmd == "snapshot") {
+            std::string subCmd;
+            std::string name;
+            iss >> subCmd >> name;
+            try {
+                if (subCmd == "take" && !name.empty()) {
+                    sim.takeSnapshot(name);
+                } else if (subCmd == "restore" && !name.empty()) {
+                    sim.restoreSnapshot(name);
+                } else if (subCmd == "delete" && !name.empty()) {
+                    sim.deleteSnapshot(name);
+                } else if (subCmd == "list") {
+                    sim.listSnapshots();
+                } else if (subCmd == "save" && !name.empty()) {
+                    sim.saveSnapshotFile(name);
+                } else if (subCmd == "load" && !name.empty()) {
+                    sim.loadSnapshotFile(name);
+                } else {
+                    std::cout << "Usage: snapshot take|restore|delete <name> | list | save|load <file>" << std::endl;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+        } else if (cmd == "profile") {
+            std::string subCmd;
+            iss >> subCmd;
+            size_t top = 0;
+            std::string file;
+            if (subCmd == "on") {
+                if (iss >> top) {
+                    sim.setProfiling(true, top);
+                } else {
+                    sim.setProfiling(true);
+                }
+                std::cout << "Profiling on" << std::endl;
+            } else if (subCmd == "off") {
+                sim.setProfiling(false);
+                std::cout << "Profiling off" << std::endl;
+            } else if (subCmd == "reset") {
+                sim.resetProfile();
+            } else if (subCmd == "report") {
+                sim.printProfile(iss >> top ? top : 10);
+            } else if (subCmd == "listing" && iss >> file) {
+                try {
+                    sim.writeProfileListing(file);
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+            } else {
+                std::cout << "Usage: profile on [top-n] | off | reset | report [n] | listing <file>" << std::endl;
+            }
+        } else if (cmd == "callgraph") {
+            std::string subCmd;
+            std::string file;
+            iss >> subCmd;
+            if (subCmd == "on" || subCmd == "off") {
+                sim.setCallProfiling(subCmd == "on");
+                std::cout << "Call graph profiling " << subCmd << std::endl;
+            } else if (subCmd == "reset") {
+                sim.resetCallGraph();
+            } else if (subCmd == "report") {
+                sim.printCallGraph();
+            } else if (subCmd == "write" && iss >> file) {
+                try {
+                    sim.writeCallgrind(file);
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+            } else {
+                std::cout << "Usage: callgraph on|off|reset | report | write <file>" << std::endl;
+            }
+        } else if (cmd == "sample") {
+            std::string subCmd;
+            std::string file;
+            uint64_t interval = 0;
+            iss >> subCmd;
+            if (subCmd == "on") {
+                if (iss >> interval && interval > 0) {
+                    sim.setSampleInterval(interval);
+                }
+                sim.setSampling(true);
+                std::cout << "Stack sampling on" << std::endl;
+            } else if (subCmd == "off") {
+                sim.setSampling(false);
+                std::cout << "Stack sampling off" << std::endl;
+            } else if (subCmd == "reset") {
+                sim.resetSamples();
+            } else if (subCmd == "write" && iss >> file) {
+                try {
+                    sim.writeFoldedStacks(file);
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+            } else {
+                std::cout << "Usage: sample on [interval] | off | reset | write <file>" << std::endl;
+            }
+        } else if (cmd == "plugin") {
+            std::string subCmd;
+            std::string path;
+            iss >> subCmd;
+            if (subCmd == "load" && iss >> path) {
+                std::string args;
+                std::getline(iss >> std::ws, args);
+                try {
+                    sim.loadPlugin(path, args);
+                    std::cout << "Loaded plugin " << path << std::endl;
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+            } else if (subCmd == "list") {
+                sim.listPlugins();
+            } else {
+                std::cout << "Usage: plugin load <file.so> [args] | list" << std::endl;
+            }
+        } else if (cmd == "stats") {
+            std::string subCmd;
+            std::string arg;
+            iss >> subCmd >> arg;
+            try {
+                if (subCmd == "on" || subCmd == "off") {
+                    sim.setStatsCollection(subCmd == "on");
+                    std::cout << "Statistics collection " << subCmd << std::endl;
+                } else if (subCmd == "reset") {
+                    sim.resetStats();
+                } else if (subCmd == "show" && (arg.empty() || arg == "json" || arg == "csv")) {
+                    sim.printStats(arg == "csv");
+                } else if (subCmd == "write" && !arg.empty()) {
+                    sim.writeStats(arg);
+                    std::cout << "Statistics written to " << arg << std::endl;
+                } else {
+                    std::cout << "Usage: stats on|off|reset | show [json|csv] | write <file>" << std::endl;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+        } else if (cmd == "perf-stats") {
+            std::string mode;
+            iss >> mode;
+            if (mode == "on" || mode == "off") {
+                sim.setPerfStats(mode == "on");
+                std::cout << "Perf stats " << mode << std::endl;
+            } else {
+                std::cout << "Usage: perf-stats on|off" << std::endl;
+            }
+        } else if (cmd == "stream") {
+            std::string subCmd;
+            iss >> subCmd;
+            try {
+                if (subCmd == "cache" || subCmd == "mix") {
+                    std::unique_ptr<EventConsumer> consumer;
+                    size_t sets = 0, ways = 0, line = 0;
+                    if (subCmd == "mix") {
+                        consumer.reset(new InstructionMix());
+                    } else if (iss >> sets >> ways >> line) {
+                        consumer.reset(new CacheModel(sets, ways, line));
+                    }
+                    std::string policy = "block";
+                    iss >> policy;
+                    if (!consumer || (policy != "drop" && policy != "block")) {
+                        std::cout << "Usage: stream cache <sets> <ways> <line-bytes> [drop|block] | mix [drop|block]" << std::endl;
+                    } else {
+                        sim.addStreamConsumer(std::move(consumer), policy == "drop" ? EventStream::DROP : EventStream::BLOCK);
+                        std::cout << "Streaming to " << subCmd << " (" << policy << " when full)" << std::endl;
+                    }
+                } else if (subCmd == "stats") {
+                    sim.printStreamStats();
+                } else if (subCmd == "stop") {
+                    sim.stopStream();
+                } else {
+                    std::cout << "Usage: stream cache <sets> <ways> <line-bytes> [drop|block] | mix [drop|block] | stats | stop" << std::endl;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
         } else if (cmd == "regs") {
             sim.printRegs();
+        } else if (cmd == "fregs") {
+            sim.printFloatRegs();
+        } else if (cmd == "vregs") {
+            sim.printVectorRegs();
+        } else if (cmd == "vlen") {
+            unsigned bits = 0;
+            if (iss >> bits) {
+                try {
+                    sim.setVectorLength(bits);
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                }
+            } else {
+                std::cout << "VLEN = " << sim.registers().vlen() << " bits" << std::endl;
+            }
         } else if (cmd == "mem") {
             uint64_t addr;
             int count;
@@ -55,6 +332,23 @@ int main() {
         } else if(cmd == "list-breaks"){
             sim.listBreakpoints();
         }
+        else if (cmd == "watch") {
+            uint64_t addr = 0;
+            uint64_t length = 0;
+            std::string mode = "w";
+            iss >> std::hex >> addr >> std::dec >> length >> mode;
+            if (mode == "r") {
+                sim.setWatchpoint(addr, length, Memory::WATCH_READ);
+            } else if (mode == "w") {
+                sim.setWatchpoint(addr, length, Memory::WATCH_WRITE);
+            } else if (mode == "rw") {
+                sim.setWatchpoint(addr, length, Memory::WATCH_RW);
+            } else {
+                std::cout << "Unknown watch mode: " << mode << std::endl;
+            }
+        } else if (cmd == "list-watches") {
+            sim.listWatchpoints();
+        }
         else if (cmd == "break") {
             int line;
             iss >> line;
@@ -66,6 +360,10 @@ int main() {
                 int line;
                 iss >> line;
                 sim.deleteBreakpoint(line);
+            } else if (subCmd == "watch") {
+                uint64_t addr;
+                iss >> std::hex >> addr >> std::dec;
+                sim.deleteWatchpoint(addr);
             } else {
                 std::cout << "Unknown command" << std::endl;
             }
@@ -88,5 +386,9 @@ int main() {
         std::cout << std::endl;
     }
 
+    sim.finishProfile();
+    sim.finishStats();
+    sim.stopStream();
+    sim.unloadPlugins();
     return 0;
 }
\ No newline at end of file
@@ -1,17 +1,144 @@
 #include "../include/memory.h"
+#include "../include/undo_log.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 
-Memory::Memory() : mem(MEM_SIZE, 0) {}
+namespace {
+
+template <typename T>
+T applyAtomic(T* target, Memory::AtomicOp op, T operand) {
+    using Signed = typename std::make_signed<T>::type;
+    switch (op) {
+        case Memory::AMO_SWAP: return __atomic_exchange_n(target, operand, __ATOMIC_SEQ_CST);
+        case Memory::AMO_ADD: return __atomic_fetch_add(target, operand, __ATOMIC_SEQ_CST);
+        case Memory::AMO_XOR: return __atomic_fetch_xor(target, operand, __ATOMIC_SEQ_CST);
+        case Memory::AMO_AND: return __atomic_fetch_and(target, operand, __ATOMIC_SEQ_CST);
+        case Memory::AMO_OR: return __atomic_fetch_or(target, operand, __ATOMIC_SEQ_CST);
+        default: break;
+    }
+    // No host instruction for min/max: retry until no other hart got in between
+    T old = __atomic_load_n(target, __ATOMIC_RELAXED);
+    T desired;
+    do {
+        switch (op) {
+            case Memory::AMO_MIN: desired = static_cast<Signed>(old) < static_cast<Signed>(operand) ? old : operand; break;
+            case Memory::AMO_MAX: desired = static_cast<Signed>(old) > static_cast<Signed>(operand) ? old : operand; break;
+            case Memory::AMO_MINU: desired = std::min(old, operand); break;
+            default: desired = std::max(old, operand); break;
+        }
+    } while (!__atomic_compare_exchange_n(target, &old, desired, true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+    return old;
+}
+
+} // namespace
+
+Memory::Memory()
+    : zeroPage(std::make_shared<Page>()),
+      watchedPages(((MEM_SIZE >> PAGE_SHIFT) + 63) / 64, 0),
+      maxWatchLength(0),
+      logAccesses(false),
+      journal(nullptr),
+      nextGeneration(0),
+      reservationHolders(0),
+      reservationLock(0) {
+    zeroPage->fill(0);
+    pages.assign(MEM_SIZE >> PAGE_SHIFT, zeroPage);
+}
 
 bool Memory::isValidAddress(uint64_t address) const {
     return address < MEM_SIZE;
 }
 
+Memory::Page& Memory::writablePage(uint64_t index) {
+    std::shared_ptr<Page>& page = pages[index];
+    if (page.use_count() > 1) {
+        page = std::make_shared<Page>(*page); // Copy on write
+    }
+    return *page;
+}
+
+// Naturally aligned accesses are single relaxed host atomics, so harts on
+// other threads never see torn values. They compile to plain moves and
+// assume a little-endian host, like the guest.
+uint64_t Memory::load(uint64_t address, int size) const {
+    if ((address & (size - 1)) == 0) {
+        const uint8_t* bytes = pages[address >> PAGE_SHIFT]->data() + (address & PAGE_MASK);
+        switch (size) {
+            case 1: return __atomic_load_n(bytes, __ATOMIC_RELAXED);
+            case 2: return __atomic_load_n(reinterpret_cast<const uint16_t*>(bytes), __ATOMIC_RELAXED);
+            case 4: return __atomic_load_n(reinterpret_cast<const uint32_t*>(bytes), __ATOMIC_RELAXED);
+            case 8: return __atomic_load_n(reinterpret_cast<const uint64_t*>(bytes), __ATOMIC_RELAXED);
+        }
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < size; ++i) {
+        uint64_t a = address + i;
+        uint8_t byte = __atomic_load_n(pages[a >> PAGE_SHIFT]->data() + (a & PAGE_MASK), __ATOMIC_RELAXED);
+        value |= static_cast<uint64_t>(byte) << (i * 8);
+    }
+    return value;
+}
+
+void Memory::store(uint64_t address, int size, uint64_t value) {
+    if (hasReservations()) {
+        lockReservations();
+        invalidateReservations(address, size);
+        storeBytes(address, size, value);
+        unlockReservations();
+        return;
+    }
+    storeBytes(address, size, value);
+}
+
+void Memory::storeBytes(uint64_t address, int size, uint64_t value) {
+    if ((address & (size - 1)) == 0) {
+        uint8_t* bytes = writablePage(address >> PAGE_SHIFT).data() + (address & PAGE_MASK);
+        switch (size) {
+            case 1: __atomic_store_n(bytes, static_cast<uint8_t>(value), __ATOMIC_RELAXED); return;
+            case 2: __atomic_store_n(reinterpret_cast<uint16_t*>(bytes), static_cast<uint16_t>(value), __ATOMIC_RELAXED); return;
+            case 4: __atomic_store_n(reinterpret_cast<uint32_t*>(bytes), static_cast<uint32_t>(value), __ATOMIC_RELAXED); return;
+            case 8: __atomic_store_n(reinterpret_cast<uint64_t*>(bytes), value, __ATOMIC_RELAXED); return;
+        }
+    }
+    for (int i = 0; i < size; ++i) {
+        uint64_t a = address + i;
+        __atomic_store_n(writablePage(a >> PAGE_SHIFT).data() + (a & PAGE_MASK),
+                         static_cast<uint8_t>(value >> (i * 8)), __ATOMIC_RELAXED);
+    }
+}
+
+void Memory::makePrivate() {
+    for (uint64_t i = 0; i < pages.size(); ++i) {
+        writablePage(i);
+    }
+}
+
+uint64_t Memory::footprint() const {
+    uint64_t used = 0;
+    for (const auto& page : pages) {
+        // Pages made private for harts may still be all zero
+        if (page != zeroPage && std::any_of(page->begin(), page->end(), [](uint8_t b) { return b != 0; })) {
+            ++used;
+        }
+    }
+    return used * PAGE_SIZE;
+}
+
 void Memory::write64(uint64_t address, uint64_t value) {
     if (!isValidAddress(address) || !isValidAddress(address + 7)) {
         throw std::out_of_range("Memory write out of bounds");
     }
-    for (int i = 0; i < 8; ++i) {
-        mem[address + i] = (value >> (i * 8)) & 0xFF;
+    uint64_t oldValue = 0;
+    if (journal || isWatchedPage(address, 8)) {
+        oldValue = load(address, 8);
+        if (journal) {
+            journal->recordMemory(address, 8, oldValue);
+        }
+    }
+    store(address, 8, value);
+    if (isWatchedPage(address, 8)) {
+        checkWatch(address, 8, true, oldValue, value);
     }
 }
 
@@ -19,9 +146,9 @@ uint64_t Memory::read64(uint64_t address) const {
     if (!isValidAddress(address) || !isValidAddress(address + 7)) {
         throw std::out_of_range("Memory read out of bounds");
     }
-    uint64_t value = 0;
-    for (int i = 0; i < 8; ++i) {
-        value |= static_cast<uint64_t>(mem[address + i]) << (i * 8);
+    uint64_t value = static_cast<uint64_t>(load(address, 8));
+    if (isWatchedPage(address, 8)) {
+        checkWatch(address, 8, false, value, value);
     }
     return value;
 }
@@ -30,8 +157,16 @@ void Memory::write32(uint64_t address, uint32_t value) {
     if (!isValidAddress(address) || !isValidAddress(address + 3)) {
         throw std::out_of_range("Memory write out of bounds");
     }
-    for (int i = 0; i < 4; ++i) {
-        mem[address + i] = (value >> (i * 8)) & 0xFF;
+    uint64_t oldValue = 0;
+    if (journal || isWatchedPage(address, 4)) {
+        oldValue = load(address, 4);
+        if (journal) {
+            journal->recordMemory(address, 4, oldValue);
+        }
+    }
+    store(address, 4, value);
+    if (isWatchedPage(address, 4)) {
+        checkWatch(address, 4, true, oldValue, value);
     }
 }
 
@@ -39,9 +174,9 @@ uint32_t Memory::read32(uint64_t address) const {
     if (!isValidAddress(address) || !isValidAddress(address + 3)) {
         throw std::out_of_range("Memory read out of bounds");
     }
-    uint32_t value = 0;
-    for (int i = 0; i < 4; ++i) {
-        value |= static_cast<uint32_t>(mem[address + i]) << (i * 8);
+    uint32_t value = static_cast<uint32_t>(load(address, 4));
+    if (isWatchedPage(address, 4)) {
+        checkWatch(address, 4, false, value, value);
     }
     return value;
 }
@@ -50,8 +185,16 @@ void Memory::write16(uint64_t address, uint32_t value) {
     if (!isValidAddress(address) || !isValidAddress(address + 1)) {
         throw std::out_of_range("Memory write out of bounds");
     }
-    for (int i = 0; i < 2; ++i) {
-        mem[address + i] = (value >> (i * 8)) & 0xFF;
+    uint64_t oldValue = 0;
+    if (journal || isWatchedPage(address, 2)) {
+        oldValue = load(address, 2);
+        if (journal) {
+            journal->recordMemory(address, 2, oldValue);
+        }
+    }
+    store(address, 2, value);
+    if (isWatchedPage(address, 2)) {
+        checkWatch(address, 2, true, oldValue, value);
     }
 }
 
@@ -59,9 +202,9 @@ uint32_t Memory::read16(uint64_t address) const {
     if (!isValidAddress(address) || !isValidAddress(address + 1)) {
         throw std::out_of_range("Memory read out of bounds");
     }
-    uint32_t value = 0;
-    for (int i = 0; i < 2; ++i) {
-        value |= static_cast<uint32_t>(mem[address + i]) << (i * 8);
+    uint32_t value = static_cast<uint32_t>(load(address, 2));
+    if (isWatchedPage(address, 2)) {
+        checkWatch(address, 2, false, value, value);
     }
     return value;
 }
@@ -70,18 +213,300 @@ void Memory::write8(uint64_t address, uint32_t value) {
     if (!isValidAddress(address) || !isValidAddress(address)) {
         throw std::out_of_range("Memory write out of bounds");
     }
-    for (int i = 0; i < 1; ++i) {
-        mem[address + i] = (value >> (i * 8)) & 0xFF;
+    uint64_t oldValue = 0;
+    if (journal || isWatchedPage(address, 1)) {
+        oldValue = load(address, 1);
+        if (journal) {
+            journal->recordMemory(address, 1, oldValue);
+        }
+    }
+    store(address, 1, value);
+    if (isWatchedPage(address, 1)) {
+        checkWatch(address, 1, true, oldValue, value);
     }
 }
 
 uint32_t Memory::read8(uint64_t address) const {
-    if (!isValidAddress(address) || !isValidAddress(address )) {
+    if (!isValidAddress(address) || !isValidAddress(address)) {
+        throw std::out_of_range("Memory read out of bounds");
+    }
+    uint32_t value = static_cast<uint32_t>(load(address, 1));
+    if (isWatchedPage(address, 1)) {
+        checkWatch(address, 1, false, value, value);
+    }
+    return value;
+}
+
+bool Memory::isWatchedRange(uint64_t address, uint64_t size) const {
+    for (uint64_t page = address >> PAGE_SHIFT; page <= (address + size - 1) >> PAGE_SHIFT; ++page) {
+        if ((watchedPages[page >> 6] >> (page & 63)) & 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Memory::readBlock(uint64_t address, void* dst, uint64_t count, int elementSize) const {
+    uint64_t size = count * elementSize;
+    if (size == 0) {
+        return;
+    }
+    if (!isValidAddress(address) || size > MEM_SIZE - address) {
         throw std::out_of_range("Memory read out of bounds");
     }
-    uint32_t value = 0;
-    for (int i = 0; i < 1; ++i) {
-        value |= static_cast<uint32_t>(mem[address + i]) << (i * 8);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    if (isWatchedRange(address, size)) {
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t value = load(address + i * elementSize, elementSize);
+            checkWatch(address + i * elementSize, elementSize, false, value, value);
+            std::memcpy(out + i * elementSize, &value, elementSize);
+        }
+        return;
+    }
+    while (size > 0) {
+        uint64_t offset = address & PAGE_MASK;
+        uint64_t chunk = std::min(size, PAGE_SIZE - offset);
+        std::memcpy(out, pages[address >> PAGE_SHIFT]->data() + offset, chunk);
+        address += chunk;
+        out += chunk;
+        size -= chunk;
+    }
+}
+
+void Memory::writeBlock(uint64_t address, const void* src, uint64_t count, int elementSize) {
+    uint64_t size = count * elementSize;
+    if (size == 0) {
+        return;
+    }
+    if (!isValidAddress(address) || size > MEM_SIZE - address) {
+        throw std::out_of_range("Memory write out of bounds");
+    }
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    if (journal || isWatchedRange(address, size)) {
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t value = 0;
+            std::memcpy(&value, in + i * elementSize, elementSize);
+            switch (elementSize) {
+                case 1: write8(address + i, static_cast<uint32_t>(value)); break;
+                case 2: write16(address + i * 2, static_cast<uint32_t>(value)); break;
+                case 4: write32(address + i * 4, static_cast<uint32_t>(value)); break;
+                default: write64(address + i * 8, value); break;
+            }
+        }
+        return;
+    }
+    bool locked = hasReservations();
+    if (locked) {
+        lockReservations();
+        invalidateReservations(address, size);
+    }
+    while (size > 0) {
+        uint64_t offset = address & PAGE_MASK;
+        uint64_t chunk = std::min(size, PAGE_SIZE - offset);
+        std::memcpy(writablePage(address >> PAGE_SHIFT).data() + offset, in, chunk);
+        address += chunk;
+        in += chunk;
+        size -= chunk;
+    }
+    if (locked) {
+        unlockReservations();
+    }
+}
+
+void Memory::restore(uint64_t address, int size, uint64_t value) {
+    if (!isValidAddress(address) || !isValidAddress(address + size - 1)) {
+        throw std::out_of_range("Memory write out of bounds");
+    }
+    store(address, size, value);
+}
+
+void Memory::publishJournal(Memory& target) {
+    while (!journal->empty()) {
+        const UndoLog::Entry& entry = journal->back();
+        if (entry.kind == UndoLog::MEMORY) {
+            // Later stores to the same location were logged too; all of
+            // them copy the final value, so the order does not matter
+            target.restore(entry.location, entry.size, load(entry.location, entry.size));
+        }
+        journal->popBack();
+    }
+}
+
+void Memory::checkAtomicAddress(uint64_t address, int size) const {
+    if (!isValidAddress(address) || !isValidAddress(address + size - 1)) {
+        throw std::out_of_range("Memory atomic access out of bounds");
+    }
+    if (address & (size - 1)) {
+        throw std::runtime_error("Misaligned atomic memory access");
+    }
+}
+
+// Journaling and watchpoints are single-hart features, so reading the new
+// value back here is not racy
+void Memory::finishAtomic(uint64_t address, int size, uint64_t oldValue, bool isRead) {
+    if (journal) {
+        journal->recordMemory(address, size, oldValue);
+    }
+    if (isWatchedPage(address, size)) {
+        if (isRead) {
+            checkWatch(address, size, false, oldValue, oldValue);
+        }
+        checkWatch(address, size, true, oldValue, load(address, size));
+    }
+}
+
+uint64_t Memory::atomicOp(uint64_t address, int size, AtomicOp op, uint64_t operand) {
+    checkAtomicAddress(address, size);
+    bool locked = hasReservations();
+    if (locked) {
+        lockReservations();
+        invalidateReservations(address, size);
+    }
+    uint8_t* target = writablePage(address >> PAGE_SHIFT).data() + (address & PAGE_MASK);
+    uint64_t oldValue = size == 4
+        ? applyAtomic(reinterpret_cast<uint32_t*>(target), op, static_cast<uint32_t>(operand))
+        : applyAtomic(reinterpret_cast<uint64_t*>(target), op, operand);
+    if (locked) {
+        unlockReservations();
+    }
+    finishAtomic(address, size, oldValue, true);
+    return oldValue;
+}
+
+void Memory::lockReservations() {
+    while (__atomic_exchange_n(&reservationLock, 1, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(&reservationLock, __ATOMIC_RELAXED)) {
+        }
+    }
+}
+
+void Memory::invalidateReservations(uint64_t address, uint64_t size) {
+    uint64_t last = (address + size - 1) & ~(RESERVATION_GRANULE - 1);
+    for (uint64_t granule = address & ~(RESERVATION_GRANULE - 1); granule <= last; granule += RESERVATION_GRANULE) {
+        auto it = reservations.find(granule);
+        if (it != reservations.end()) {
+            it->second.generation = ++nextGeneration;
+        }
+    }
+}
+
+void Memory::dropReservation(uint64_t granule) {
+    auto it = reservations.find(granule);
+    if (it == reservations.end()) {
+        return; // Restored state can hold a reservation this memory never saw
+    }
+    if (--it->second.holders == 0) {
+        reservations.erase(it);
+    }
+    __atomic_fetch_sub(&reservationHolders, 1, __ATOMIC_SEQ_CST);
+}
+
+// The holder count goes up before the value is read, so a store that
+// still saw no reservations either lands before the load or changes the
+// value the SC checks
+uint64_t Memory::loadReserved(uint64_t address, int size, uint64_t& generation) {
+    checkAtomicAddress(address, size);
+    lockReservations();
+    uint64_t granule = address & ~(RESERVATION_GRANULE - 1);
+    auto inserted = reservations.insert({granule, {++nextGeneration, 0}});
+    inserted.first->second.holders++;
+    generation = inserted.first->second.generation;
+    __atomic_fetch_add(&reservationHolders, 1, __ATOMIC_SEQ_CST);
+    const uint8_t* source = pages[address >> PAGE_SHIFT]->data() + (address & PAGE_MASK);
+    uint64_t value = size == 4
+        ? __atomic_load_n(reinterpret_cast<const uint32_t*>(source), __ATOMIC_SEQ_CST)
+        : __atomic_load_n(reinterpret_cast<const uint64_t*>(source), __ATOMIC_SEQ_CST);
+    unlockReservations();
+    if (isWatchedPage(address, size)) {
+        checkWatch(address, size, false, value, value);
     }
     return value;
-}
\ No newline at end of file
+}
+
+bool Memory::storeConditional(uint64_t address, int size, uint64_t generation, uint64_t expected, uint64_t value) {
+    checkAtomicAddress(address, size);
+    lockReservations();
+    uint64_t granule = address & ~(RESERVATION_GRANULE - 1);
+    auto it = reservations.find(granule);
+    uint64_t oldValue = load(address, size);
+    bool stored = it != reservations.end() && it->second.generation == generation && oldValue == expected;
+    if (stored) {
+        invalidateReservations(address, size);
+        storeBytes(address, size, value);
+    }
+    dropReservation(granule);
+    unlockReservations();
+    if (stored) {
+        finishAtomic(address, size, oldValue, false);
+    }
+    return stored;
+}
+
+void Memory::releaseReservation(uint64_t address) {
+    lockReservations();
+    dropReservation(address & ~(RESERVATION_GRANULE - 1));
+    unlockReservations();
+}
+
+void Memory::addWatchpoint(uint64_t address, uint64_t length, int type) {
+    if (length == 0 || !isValidAddress(address) || !isValidAddress(address + length - 1)) {
+        throw std::out_of_range("Watchpoint out of bounds");
+    }
+    watchpoints[address] = {address, length, type};
+    rebuildWatchedPages();
+}
+
+bool Memory::removeWatchpoint(uint64_t address) {
+    if (watchpoints.erase(address) == 0) {
+        return false;
+    }
+    rebuildWatchedPages();
+    return true;
+}
+
+void Memory::setAccessLogging(bool enabled) {
+    logAccesses = enabled;
+    accessLog.clear();
+    rebuildWatchedPages();
+}
+
+void Memory::rebuildWatchedPages() {
+    std::fill(watchedPages.begin(), watchedPages.end(), logAccesses ? ~0ULL : 0);
+    maxWatchLength = 0;
+    for (const auto& entry : watchpoints) {
+        const Watchpoint& wp = entry.second;
+        for (uint64_t page = wp.start >> PAGE_SHIFT; page <= (wp.start + wp.length - 1) >> PAGE_SHIFT; ++page) {
+            watchedPages[page >> 6] |= 1ULL << (page & 63);
+        }
+        maxWatchLength = std::max(maxWatchLength, wp.length);
+    }
+}
+
+// Slow path: only reached for accesses touching a watched page
+void Memory::checkWatch(uint64_t address, int size, bool isWrite, uint64_t oldValue, uint64_t newValue) const {
+    int mask = isWrite ? WATCH_WRITE : WATCH_READ;
+    if (size < 8) {
+        newValue &= (1ULL << (size * 8)) - 1;
+    }
+    if (logAccesses) {
+        accessLog.push_back({address, size, isWrite, newValue});
+    }
+    uint64_t end = address + size;
+    // A watchpoint starting more than maxWatchLength below the access cannot reach it
+    auto it = watchpoints.lower_bound(address >= maxWatchLength ? address - maxWatchLength + 1 : 0);
+    for (; it != watchpoints.end() && it->first < end; ++it) {
+        const Watchpoint& wp = it->second;
+        if ((wp.type & mask) && wp.start + wp.length > address) {
+            pendingHits.push_back({wp, address, size, isWrite, oldValue, newValue});
+        }
+    }
+}
+
+bool Memory::takeWatchHit(WatchHit& hit) {
+    if (pendingHits.empty()) {
+        return false;
+    }
+    hit = pendingHits.front();
+    pendingHits.erase(pendingHits.begin());
+    return true;
+}
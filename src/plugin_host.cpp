@@ -0,0 +1,153 @@
+#include "../include/plugin_host.h"
+#include "../include/instruction.h"
+#include <dlfcn.h>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+typedef Plugin* (*CreatePlugin)(const char* args);
+
+Plugin::InstructionInfo describe(const Program& program, size_t index) {
+    Plugin::InstructionInfo info;
+    info.index = index;
+    info.address = program.address(index);
+    info.encoding = program.encoding(index);
+    info.instruction = program.instruction(index);
+    info.length = program.length(index);
+    info.line = program.line(index);
+    try {
+        info.disassembly = Instruction::decode(program.instruction(index))->toString();
+    } catch (const std::exception&) {
+        info.disassembly = "unknown";
+    }
+    return info;
+}
+
+} // namespace
+
+PluginHost::~PluginHost() {
+    unloadAll();
+}
+
+void PluginHost::load(const std::string& path, const std::string& args, const Program& program) {
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        throw std::runtime_error(std::string("Could not load plugin: ") + dlerror());
+    }
+    const int* version = static_cast<const int*>(dlsym(handle, "rvsim_plugin_api_version"));
+    CreatePlugin create = reinterpret_cast<CreatePlugin>(dlsym(handle, "rvsim_plugin_create"));
+    if (!version || !create) {
+        dlclose(handle);
+        throw std::runtime_error("Not a simulator plugin: " + path);
+    }
+    if (*version != RVSIM_PLUGIN_API_VERSION) {
+        dlclose(handle);
+        throw std::runtime_error("Plugin " + path + " was built for a different plugin API version");
+    }
+
+    std::unique_ptr<Plugin> plugin;
+    try {
+        plugin.reset(create(args.c_str()));
+    } catch (...) {
+        dlclose(handle);
+        throw;
+    }
+    if (!plugin) {
+        dlclose(handle);
+        throw std::runtime_error("Plugin " + path + " failed to start");
+    }
+    plugins.push_back({path, handle, std::move(plugin), {}});
+    instrument(plugins.back(), program);
+    combine();
+}
+
+void PluginHost::unloadAll() {
+    for (Loaded& loaded : plugins) {
+        loaded.plugin->finish();
+        // The plugin's code lives in the shared object, so destroy it first
+        loaded.plugin.reset();
+        dlclose(loaded.handle);
+    }
+    plugins.clear();
+    combined.clear();
+    memoryWanted = false;
+}
+
+void PluginHost::list() const {
+    if (plugins.empty()) {
+        std::cout << "No plugins loaded." << std::endl;
+        return;
+    }
+    for (const Loaded& loaded : plugins) {
+        size_t instrumented = 0;
+        for (uint8_t w : loaded.wanted) {
+            instrumented += w != 0;
+        }
+        std::cout << loaded.path << ": " << std::dec << instrumented << " of " << loaded.wanted.size()
+                  << " instructions instrumented" << std::endl;
+    }
+}
+
+void PluginHost::translate(const Program& program) {
+    for (Loaded& loaded : plugins) {
+        loaded.wanted.assign(program.size(), 0);
+    }
+    for (size_t i = 0; i < program.size() && !plugins.empty(); ++i) {
+        Plugin::InstructionInfo info = describe(program, i);
+        for (Loaded& loaded : plugins) {
+            loaded.wanted[i] = static_cast<uint8_t>(loaded.plugin->instrument(info));
+        }
+    }
+    combine();
+}
+
+void PluginHost::instrument(Loaded& loaded, const Program& program) {
+    loaded.wanted.assign(program.size(), 0);
+    for (size_t i = 0; i < program.size(); ++i) {
+        loaded.wanted[i] = static_cast<uint8_t>(loaded.plugin->instrument(describe(program, i)));
+    }
+}
+
+void PluginHost::combine() {
+    combined.clear();
+    memoryWanted = false;
+    for (const Loaded& loaded : plugins) {
+        combined.resize(loaded.wanted.size(), 0);
+        for (size_t i = 0; i < loaded.wanted.size(); ++i) {
+            combined[i] |= loaded.wanted[i];
+        }
+    }
+    for (uint8_t w : combined) {
+        memoryWanted = memoryWanted || (w & Plugin::EVENT_MEMORY);
+    }
+}
+
+void PluginHost::dispatch(const Executed& executed, const std::vector<Memory::Access>& accesses) {
+    for (Loaded& loaded : plugins) {
+        unsigned wanted = loaded.wanted[executed.index];
+        if (wanted == 0) {
+            continue;
+        }
+        Plugin& plugin = *loaded.plugin;
+        if (wanted & Plugin::EVENT_INSTRUCTION) {
+            plugin.onInstruction(executed.index, executed.pc);
+        }
+        if (wanted & Plugin::EVENT_MEMORY) {
+            for (const Memory::Access& access : accesses) {
+                plugin.onMemoryAccess(executed.index, access.address, access.size, access.isWrite, access.value);
+            }
+        }
+        if ((wanted & Plugin::EVENT_BRANCH) && executed.isBranch) {
+            plugin.onBranch(executed.index, executed.pc, executed.nextPc, executed.nextPc != executed.fallThrough);
+        }
+        if (wanted & Plugin::EVENT_CALL) {
+            for (size_t i = 0; i < executed.framesPopped; ++i) {
+                plugin.onReturn(executed.index, executed.pc, executed.nextPc);
+            }
+            if (executed.framePushed) {
+                plugin.onCall(executed.index, executed.pc, executed.nextPc);
+            }
+        }
+    }
+}
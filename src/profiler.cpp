@@ -0,0 +1,168 @@
+#include "../include/profiler.h"
+#include "../include/instruction.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+std::string disassemble(uint32_t instruction) {
+    try {
+        return Instruction::decode(instruction)->toString();
+    } catch (const std::exception&) {
+        return "unknown";
+    }
+}
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+// Prints a histogram sorted by count, largest first
+void printHistogram(std::ostream& out, const char* title, const std::map<std::string, uint64_t>& histogram,
+                    uint64_t total) {
+    std::vector<std::pair<std::string, uint64_t>> rows(histogram.begin(), histogram.end());
+    std::stable_sort(rows.begin(), rows.end(), [](const std::pair<std::string, uint64_t>& a,
+                                                  const std::pair<std::string, uint64_t>& b) {
+        return a.second > b.second;
+    });
+    out << title << ":" << std::endl;
+    for (const auto& row : rows) {
+        out << "  " << std::left << std::setw(12) << row.first << std::right << std::setw(14) << row.second
+            << std::setw(8) << std::fixed << std::setprecision(2) << percent(row.second, total) << "%" << std::endl;
+    }
+}
+
+} // namespace
+
+uint64_t Profiler::total() const {
+    uint64_t sum = 0;
+    for (uint64_t c : counts) {
+        sum += c;
+    }
+    return sum;
+}
+
+std::string Profiler::mnemonic(uint32_t instruction) {
+    std::string text = disassemble(instruction);
+    return text.substr(0, text.find(' '));
+}
+
+const char* Profiler::instructionClass(uint32_t instruction) {
+    uint32_t opcode = instruction & 0x7F;
+    uint32_t funct3 = (instruction >> 12) & 0x7;
+    uint32_t funct7 = instruction >> 25;
+    switch (opcode) {
+        case 0x03: return "load";
+        case 0x23: return "store";
+        case 0x63: return "branch";
+        case 0x67:
+        case 0x6F: return "jump";
+        case 0x33:
+        case 0x3B: return funct7 == 0x01 ? "muldiv" : "alu";
+        case 0x13:
+        case 0x1B:
+        case 0x17:
+        case 0x37: return "alu";
+        case 0x2F: return "atomic";
+        // Widths 1, 2 and 3 are the scalar FP accesses, the rest vector
+        case 0x07:
+        case 0x27: return funct3 >= 1 && funct3 <= 3 ? "fp" : "vector";
+        case 0x43:
+        case 0x47:
+        case 0x4B:
+        case 0x4F:
+        case 0x53: return "fp";
+        case 0x57: return "vector";
+        case 0x0F:
+        case 0x73: return "system";
+        default: return "other";
+    }
+}
+
+void Profiler::report(std::ostream& out, const Program& program, size_t topN) const {
+    // The REPL leaves hex and '0' fill set on std::cout
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    char fill = out.fill(' ');
+    uint64_t sum = total();
+    out << "Profile: " << std::dec << sum << " instructions executed" << std::endl;
+    if (sum == 0) {
+        out.fill(fill);
+        return;
+    }
+
+    std::vector<size_t> order;
+    std::map<std::string, uint64_t> opcodes;
+    std::map<std::string, uint64_t> classes;
+    for (size_t i = 0; i < counts.size() && i < program.size(); ++i) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        order.push_back(i);
+        opcodes[mnemonic(program.instruction(i))] += counts[i];
+        classes[instructionClass(program.instruction(i))] += counts[i];
+    }
+    // Hottest first; ties in program order
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return counts[a] > counts[b];
+    });
+
+    out << "Hottest instructions:" << std::endl;
+    out << std::setw(14) << "count" << std::setw(9) << "%" << "  " << std::setw(10) << "address"
+        << std::setw(7) << "line" << "  instruction" << std::endl;
+    for (size_t k = 0; k < order.size() && k < topN; ++k) {
+        size_t i = order[k];
+        out << std::setw(14) << counts[i] << std::setw(8) << std::fixed << std::setprecision(2)
+            << percent(counts[i], sum) << "%" << "  0x" << std::hex << std::setw(8) << std::setfill('0')
+            << program.address(i) << std::setfill(' ') << std::dec << std::setw(7) << program.line(i) << "  "
+            << disassemble(program.instruction(i)) << std::endl;
+    }
+    printHistogram(out, "By opcode", opcodes, sum);
+    printHistogram(out, "By class", classes, sum);
+    out.flags(flags);
+    out.precision(precision);
+    out.fill(fill);
+}
+
+void Profiler::writeListing(const Program& program, const std::string& source, const std::string& listing) const {
+    std::ifstream in(source);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open file: " + source);
+    }
+    std::ofstream out(listing);
+    if (!out.is_open()) {
+        throw std::runtime_error("Could not write file: " + listing);
+    }
+
+    // Program lines are ascending, so one pass pairs them with the source
+    size_t next = 0;
+    std::string line;
+    for (int lineNum = 1; std::getline(in, line); ++lineNum) {
+        bool hasInstruction = false;
+        uint64_t count = 0;
+        std::string disassembly;
+        while (next < program.size() && program.line(next) == lineNum) {
+            if (next < counts.size()) {
+                count += counts[next];
+            }
+            disassembly = disassemble(program.instruction(next));
+            hasInstruction = true;
+            ++next;
+        }
+
+        if (!hasInstruction) {
+            out << std::setw(14) << "-" << ": " << std::setw(5) << lineNum << ": " << line << std::endl;
+        } else {
+            if (count == 0) {
+                out << std::setw(14) << "#####";
+            } else {
+                out << std::setw(14) << count;
+            }
+            out << ": " << std::setw(5) << lineNum << ": " << line << "    # " << disassembly << std::endl;
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#include "../include/program.h"
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+uint32_t bits(uint32_t value, int hi, int lo) {
+    return (value >> lo) & ((1u << (hi - lo + 1)) - 1);
+}
+
+int32_t sext(uint32_t value, int width) {
+    int32_t m = 1 << (width - 1);
+    return (static_cast<int32_t>(value) ^ m) - m;
+}
+
+// 32-bit instruction formats
+uint32_t rType(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+    return funct7 << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+
+uint32_t iType(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+    return (static_cast<uint32_t>(imm) & 0xFFF) << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+
+uint32_t sType(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t opcode) {
+    uint32_t u = static_cast<uint32_t>(imm) & 0xFFF;
+    return (u >> 5) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | (u & 0x1F) << 7 | opcode;
+}
+
+uint32_t bType(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3) {
+    uint32_t u = static_cast<uint32_t>(imm) & 0x1FFF;
+    return bits(u, 12, 12) << 31 | bits(u, 10, 5) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 |
+           bits(u, 4, 1) << 8 | bits(u, 11, 11) << 7 | 0x63;
+}
+
+uint32_t uType(int32_t imm20, uint32_t rd, uint32_t opcode) {
+    return (static_cast<uint32_t>(imm20) & 0xFFFFF) << 12 | rd << 7 | opcode;
+}
+
+uint32_t jType(int32_t imm, uint32_t rd) {
+    uint32_t u = static_cast<uint32_t>(imm) & 0x1FFFFF;
+    return bits(u, 20, 20) << 31 | bits(u, 10, 1) << 21 | bits(u, 11, 11) << 20 | bits(u, 19, 12) << 12 | rd << 7 | 0x6F;
+}
+
+// Scaled offsets of the word and doubleword CL/CS forms
+uint32_t wordOffset(uint32_t p) {
+    return bits(p, 12, 10) << 3 | bits(p, 6, 6) << 2 | bits(p, 5, 5) << 6;
+}
+
+uint32_t doubleOffset(uint32_t p) {
+    return bits(p, 12, 10) << 3 | bits(p, 6, 5) << 6;
+}
+
+} // namespace
+
+uint32_t Program::expand(uint16_t parcel) {
+    uint32_t p = parcel;
+    uint32_t funct3 = bits(p, 15, 13);
+    uint32_t rd = bits(p, 11, 7);       // rd/rs1 of the CR and CI forms
+    uint32_t rs2 = bits(p, 6, 2);
+    uint32_t rdc = bits(p, 4, 2) + 8;   // rd'/rs2': x8-x15
+    uint32_t rs1c = bits(p, 9, 7) + 8;  // rs1'
+    int32_t imm6 = sext(bits(p, 12, 12) << 5 | bits(p, 6, 2), 6);
+    uint32_t shamt = bits(p, 12, 12) << 5 | bits(p, 6, 2);
+
+    switch (p & 0x3) {
+        case 0x0:
+            switch (funct3) {
+                case 0x0: { // C.ADDI4SPN
+                    uint32_t imm = bits(p, 12, 11) << 4 | bits(p, 10, 7) << 6 | bits(p, 6, 6) << 2 | bits(p, 5, 5) << 3;
+                    return imm ? iType(imm, 2, 0x0, rdc, 0x13) : 0;
+                }
+                case 0x1: return iType(doubleOffset(p), rs1c, 0x3, rdc, 0x07); // C.FLD
+                case 0x2: return iType(wordOffset(p), rs1c, 0x2, rdc, 0x03);   // C.LW
+                case 0x3: return iType(doubleOffset(p), rs1c, 0x3, rdc, 0x03); // C.LD
+                case 0x5: return sType(doubleOffset(p), rdc, rs1c, 0x3, 0x27); // C.FSD
+                case 0x6: return sType(wordOffset(p), rdc, rs1c, 0x2, 0x23);   // C.SW
+                case 0x7: return sType(doubleOffset(p), rdc, rs1c, 0x3, 0x23); // C.SD
+            }
+            break;
+        case 0x1:
+            switch (funct3) {
+                case 0x0: return iType(imm6, rd, 0x0, rd, 0x13);            // C.ADDI, C.NOP
+                case 0x1: return rd ? iType(imm6, rd, 0x0, rd, 0x1B) : 0;   // C.ADDIW
+                case 0x2: return iType(imm6, 0, 0x0, rd, 0x13);             // C.LI
+                case 0x3:
+                    if (rd == 2) { // C.ADDI16SP
+                        int32_t imm = sext(bits(p, 12, 12) << 9 | bits(p, 6, 6) << 4 | bits(p, 5, 5) << 6 |
+                                           bits(p, 4, 3) << 7 | bits(p, 2, 2) << 5, 10);
+                        return imm ? iType(imm, 2, 0x0, 2, 0x13) : 0;
+                    }
+                    return imm6 ? uType(imm6, rd, 0x37) : 0; // C.LUI
+                case 0x4:
+                    switch (bits(p, 11, 10)) {
+                        case 0x0: return iType(shamt, rs1c, 0x5, rs1c, 0x13);          // C.SRLI
+                        case 0x1: return iType(0x400 | shamt, rs1c, 0x5, rs1c, 0x13);  // C.SRAI
+                        case 0x2: return iType(imm6, rs1c, 0x7, rs1c, 0x13);           // C.ANDI
+                    }
+                    if (bits(p, 12, 12) == 0) {
+                        switch (bits(p, 6, 5)) {
+                            case 0x0: return rType(0x20, rdc, rs1c, 0x0, rs1c, 0x33); // C.SUB
+                            case 0x1: return rType(0x00, rdc, rs1c, 0x4, rs1c, 0x33); // C.XOR
+                            case 0x2: return rType(0x00, rdc, rs1c, 0x6, rs1c, 0x33); // C.OR
+                            case 0x3: return rType(0x00, rdc, rs1c, 0x7, rs1c, 0x33); // C.AND
+                        }
+                    }
+                    switch (bits(p, 6, 5)) {
+                        case 0x0: return rType(0x20, rdc, rs1c, 0x0, rs1c, 0x3B); // C.SUBW
+                        case 0x1: return rType(0x00, rdc, rs1c, 0x0, rs1c, 0x3B); // C.ADDW
+                    }
+                    break;
+                case 0x5: // C.J
+                    return jType(sext(bits(p, 12, 12) << 11 | bits(p, 11, 11) << 4 | bits(p, 10, 9) << 8 |
+                                      bits(p, 8, 8) << 10 | bits(p, 7, 7) << 6 | bits(p, 6, 6) << 7 |
+                                      bits(p, 5, 3) << 1 | bits(p, 2, 2) << 5, 12), 0);
+                case 0x6: // C.BEQZ
+                case 0x7: // C.BNEZ
+                    return bType(sext(bits(p, 12, 12) << 8 | bits(p, 11, 10) << 3 | bits(p, 6, 5) << 6 |
+                                      bits(p, 4, 3) << 1 | bits(p, 2, 2) << 5, 9), 0, rs1c, funct3 & 0x1);
+            }
+            break;
+        case 0x2:
+            switch (funct3) {
+                case 0x0: return iType(shamt, rd, 0x1, rd, 0x13); // C.SLLI
+                case 0x1: // C.FLDSP
+                    return iType(bits(p, 12, 12) << 5 | bits(p, 6, 5) << 3 | bits(p, 4, 2) << 6, 2, 0x3, rd, 0x07);
+                case 0x2: // C.LWSP
+                    return rd ? iType(bits(p, 12, 12) << 5 | bits(p, 6, 4) << 2 | bits(p, 3, 2) << 6, 2, 0x2, rd, 0x03) : 0;
+                case 0x3: // C.LDSP
+                    return rd ? iType(bits(p, 12, 12) << 5 | bits(p, 6, 5) << 3 | bits(p, 4, 2) << 6, 2, 0x3, rd, 0x03) : 0;
+                case 0x4:
+                    if (bits(p, 12, 12) == 0) {
+                        if (rs2 == 0) {
+                            return rd ? iType(0, rd, 0x0, 0, 0x67) : 0; // C.JR
+                        }
+                        return rType(0x00, rs2, 0, 0x0, rd, 0x33); // C.MV
+                    }
+                    if (rs2 == 0) {
+                        return rd ? iType(0, rd, 0x0, 1, 0x67) : 0x00100073; // C.JALR, C.EBREAK
+                    }
+                    return rType(0x00, rs2, rd, 0x0, rd, 0x33); // C.ADD
+                case 0x5: return sType(bits(p, 12, 10) << 3 | bits(p, 9, 7) << 6, rs2, 2, 0x3, 0x27); // C.FSDSP
+                case 0x6: return sType(bits(p, 12, 9) << 2 | bits(p, 8, 7) << 6, rs2, 2, 0x2, 0x23);  // C.SWSP
+                case 0x7: return sType(bits(p, 12, 10) << 3 | bits(p, 9, 7) << 6, rs2, 2, 0x3, 0x23); // C.SDSP
+            }
+            break;
+    }
+    return 0;
+}
+
+void Program::clear() {
+    code.clear();
+    encodings.clear();
+    lengths.clear();
+    addresses.clear();
+    lines.clear();
+    starts.clear();
+    end = 0;
+}
+
+void Program::append(uint32_t encoding, int line) {
+    bool compressed = isCompressed(encoding);
+    code.push_back(compressed ? expand(static_cast<uint16_t>(encoding)) : encoding);
+    encodings.push_back(encoding);
+    lengths.push_back(compressed ? 2 : 4);
+    addresses.push_back(end);
+    lines.push_back(line);
+    starts.push_back(static_cast<uint32_t>(code.size()));
+    if (!compressed) {
+        starts.push_back(0);
+    }
+    end += compressed ? 2 : 4;
+}
+
+size_t Program::indexAt(uint64_t pc) const {
+    if (pc >= end) {
+        return NO_INSTRUCTION;
+    }
+    uint32_t start = (pc & 1) ? 0 : starts[pc / 2];
+    if (start == 0) {
+        std::ostringstream message;
+        message << "PC 0x" << std::hex << pc << " is not at the start of an instruction";
+        throw std::runtime_error(message.str());
+    }
+    return start - 1;
+}
@@ -1,11 +1,43 @@
 #include "../include/register_file.h"
+#include "../include/undo_log.h"
 #include <iostream>
 #include <iomanip>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
-RegisterFile::RegisterFile() : regs(33, 0) {}  // 32 general-purpose registers + PC
+RegisterFile::RegisterFile(unsigned vlen)  // 32 general-purpose registers + PC
+    : regs(COUNT, 0), vlenb(0), retired(0), hartId(0), journal(nullptr), reservationAddress(0), reservationValue(0),
+      reservationGeneration(0), reservationValid(false), yieldReason(YIELD_NONE) {
+    setVectorLength(vlen);
+}
+
+void RegisterFile::setVectorLength(unsigned bits) {
+    if (bits < MIN_VLEN || bits > MAX_VLEN || (bits & (bits - 1)) != 0) {
+        throw std::out_of_range("VLEN must be a power of two from " + std::to_string(MIN_VLEN) + " to " +
+                                std::to_string(MAX_VLEN));
+    }
+    vlenb = bits / 8;
+    regs.assign(COUNT + (32 * vlenb + VECTOR_PADDING) / sizeof(uint64_t), 0);
+    regs[VTYPE] = VTYPE_VILL;
+}
+
+uint8_t* RegisterFile::writeVector(int v, int count) {
+    size_t first = COUNT + v * vlenb / sizeof(uint64_t);
+    if (journal) {
+        for (size_t i = 0; i < count * vlenb / sizeof(uint64_t); ++i) {
+            journal->recordRegister(static_cast<int>(first + i), regs[first + i]);
+        }
+    }
+    return reinterpret_cast<uint8_t*>(regs.data() + first);
+}
 
 void RegisterFile::write(int reg, uint64_t value) {
     if (reg != 0) {  // x0 is always 0
+        if (journal) {
+            journal->recordRegister(reg, regs[reg]);
+        }
         regs[reg] = value;
     }
 }
@@ -14,6 +46,118 @@ uint64_t RegisterFile::read(int reg) const {
     return regs[reg];
 }
 
+namespace {
+
+struct CsrInfo {
+    unsigned address;
+    const char* name;
+};
+
+const CsrInfo CSRS[] = {
+    {0x001, "fflags"}, {0x002, "frm"}, {0x003, "fcsr"}, {0x008, "vstart"},
+    {0x323, "mhpmevent3"}, {0x324, "mhpmevent4"}, {0x325, "mhpmevent5"}, {0x326, "mhpmevent6"},
+    {0xB00, "mcycle"}, {0xB02, "minstret"},
+    {0xB03, "mhpmcounter3"}, {0xB04, "mhpmcounter4"}, {0xB05, "mhpmcounter5"}, {0xB06, "mhpmcounter6"},
+    {0xC00, "cycle"}, {0xC01, "time"}, {0xC02, "instret"},
+    {0xC03, "hpmcounter3"}, {0xC04, "hpmcounter4"}, {0xC05, "hpmcounter5"}, {0xC06, "hpmcounter6"},
+    {0xC20, "vl"}, {0xC21, "vtype"}, {0xC22, "vlenb"}, {0xF14, "mhartid"},
+};
+
+std::string csrLabel(unsigned csr) {
+    const char* name = RegisterFile::csrName(csr);
+    if (name) {
+        return name;
+    }
+    std::ostringstream oss;
+    oss << "0x" << std::hex << csr;
+    return oss.str();
+}
+
+} // namespace
+
+const char* RegisterFile::csrName(unsigned csr) {
+    for (const CsrInfo& info : CSRS) {
+        if (info.address == csr) {
+            return info.name;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t RegisterFile::readCsr(unsigned csr) const {
+    switch (csr) {
+        case 0x001: return regs[FCSR] & 0x1F;
+        case 0x002: return (regs[FCSR] >> 5) & 0x7;
+        case 0x003: return regs[FCSR] & 0xFF;
+        case 0x008: return regs[VSTART];
+        case 0xB00: case 0xC00: return retired + regs[CYCLE_OFFSET];
+        case 0xC01: return retired;
+        case 0xB02: case 0xC02: return retired + regs[INSTRET_OFFSET];
+        case 0xB03: case 0xB04: case 0xB05: case 0xB06:
+        case 0xC03: case 0xC04: case 0xC05: case 0xC06:
+            return regs[HPMCOUNTER3 + (csr & 0x1F) - 3];
+        case 0x323: case 0x324: case 0x325: case 0x326:
+            return regs[HPMEVENT3 + (csr & 0x1F) - 3];
+        case 0xC20: return regs[VL];
+        case 0xC21: return regs[VTYPE];
+        case 0xC22: return vlenb;
+        case 0xF14: return static_cast<uint64_t>(hartId);
+    }
+    throw std::runtime_error("Unknown CSR " + csrLabel(csr));
+}
+
+void RegisterFile::writeCsr(unsigned csr, uint64_t value) {
+    switch (csr) {
+        case 0x001: write(FCSR, (regs[FCSR] & ~0x1FULL) | (value & 0x1F)); return;
+        case 0x002: write(FCSR, (regs[FCSR] & 0x1F) | ((value & 0x7) << 5)); return;
+        case 0x003: write(FCSR, value & 0xFF); return;
+        case 0x008: write(VSTART, value & (vlen() - 1)); return;
+        // The next instruction reads the value written
+        case 0xB00: write(CYCLE_OFFSET, value - (retired + 1)); return;
+        case 0xB02: write(INSTRET_OFFSET, value - (retired + 1)); return;
+        case 0xB03: case 0xB04: case 0xB05: case 0xB06:
+            write(HPMCOUNTER3 + (csr & 0x1F) - 3, value);
+            return;
+        case 0x323: case 0x324: case 0x325: case 0x326:
+            // Unsupported events read back as none
+            write(HPMEVENT3 + (csr & 0x1F) - 3, value < EVENT_COUNT ? value : static_cast<uint64_t>(EVENT_NONE));
+            return;
+    }
+    if (csrName(csr)) {
+        throw std::runtime_error("Write to read-only CSR " + csrLabel(csr));
+    }
+    throw std::runtime_error("Unknown CSR " + csrLabel(csr));
+}
+
+void RegisterFile::recordEvents(uint32_t machineCode, bool jumped) {
+    bool load = false, store = false, branch = false, jump = false;
+    switch (machineCode & 0x7F) {
+        case 0x03: case 0x07: load = true; break;  // LOAD, LOAD-FP
+        case 0x23: case 0x27: store = true; break; // STORE, STORE-FP
+        case 0x2F: {                              // AMO: lr loads, sc stores, the rest do both
+            uint32_t funct5 = machineCode >> 27;
+            load = funct5 != 0x03;
+            store = funct5 != 0x02;
+            break;
+        }
+        case 0x63: branch = true; break;
+        case 0x67: case 0x6F: jump = true; break;
+    }
+    for (int i = 0; i < HPM_COUNTERS; ++i) {
+        bool counts = false;
+        switch (regs[HPMEVENT3 + i]) {
+            case EVENT_LOAD: counts = load; break;
+            case EVENT_STORE: counts = store; break;
+            case EVENT_BRANCH: counts = branch; break;
+            case EVENT_BRANCH_TAKEN: counts = branch && jumped; break;
+            case EVENT_JUMP: counts = jump; break;
+        }
+        if (counts) {
+            write(HPMCOUNTER3 + i, regs[HPMCOUNTER3 + i] + 1);
+        }
+    }
+}
+
 void RegisterFile::printRegs() const {
     for (int i = 0; i < 33; ++i) {
         if (i == 32) {
@@ -28,4 +172,47 @@ void RegisterFile::printRegs() const {
         }
         std::cout << std::endl;
     }
-}
\ No newline at end of file
+}
+void RegisterFile::printFloatRegs() const {
+    for (int i = 0; i < 32; ++i) {
+        uint64_t bits = regs[F0 + i];
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        std::cout << "f" << std::dec << std::setfill('0') << std::setw(2) << i << " = 0x" << std::hex
+                  << std::setw(16) << bits << std::setfill(' ');
+        if ((bits >> 32) == 0xFFFFFFFF) {
+            float f;
+            uint32_t low = static_cast<uint32_t>(bits);
+            std::memcpy(&f, &low, sizeof(f));
+            std::cout << "  (float " << f << ")";
+        } else {
+            std::cout << "  (double " << d << ")";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "fcsr = 0x" << std::hex << regs[FCSR] << std::dec << std::endl;
+}
+
+void RegisterFile::printVectorRegs() const {
+    uint64_t vtype = regs[VTYPE];
+    std::cout << "vl = " << std::dec << regs[VL] << ", vtype = 0x" << std::hex << vtype;
+    if (vtype & VTYPE_VILL) {
+        std::cout << " (vill)";
+    } else {
+        unsigned vlmul = vtype & 0x7;
+        std::cout << " (e" << std::dec << (8u << ((vtype >> 3) & 0x7)) << ", "
+                  << (vlmul < 4 ? "m" + std::to_string(1 << vlmul) : "mf" + std::to_string(1 << (8 - vlmul)))
+                  << ((vtype & 0x40) ? ", ta" : ", tu") << ((vtype & 0x80) ? ", ma" : ", mu") << ")";
+    }
+    std::cout << ", VLEN = " << std::dec << vlen() << std::endl;
+    // Most significant byte first, like a wide integer
+    for (int v = 0; v < 32; ++v) {
+        const uint8_t* bytes = vector(v);
+        std::cout << "v" << std::dec << std::setfill('0') << std::setw(2) << v << " = 0x" << std::hex;
+        for (unsigned i = vlenb; i-- > 0;) {
+            std::cout << std::setw(2) << static_cast<unsigned>(bytes[i]);
+        }
+        std::cout << std::setfill(' ') << std::endl;
+    }
+    std::cout << std::dec;
+}
@@ -0,0 +1,249 @@
+#include "../include/server.h"
+#include "../include/simulator.h"
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t DEFAULT_JOB_LIMIT = 100000000;
+
+struct MemoryDump {
+    uint64_t address;
+    int count;
+};
+
+bool readRequest(int fd, std::vector<std::string>& lines) {
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+        size_t newline;
+        while ((newline = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line == "run") {
+                return true;
+            }
+            lines.push_back(line);
+        }
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, n);
+    }
+}
+
+void writeAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+        if (n <= 0) {
+            return;
+        }
+        sent += n;
+    }
+}
+
+int directiveSize(const std::string& directive) {
+    if (directive == ".byte") return 1;
+    if (directive == ".half" || directive == ".short") return 2;
+    if (directive == ".word" || directive == ".long") return 4;
+    if (directive == ".dword" || directive == ".quad") return 8;
+    return 0;
+}
+
+void storeValue(Memory& mem, uint64_t address, int size, uint64_t value) {
+    switch (size) {
+        case 1: mem.write8(address, static_cast<uint32_t>(value)); break;
+        case 2: mem.write16(address, static_cast<uint32_t>(value)); break;
+        case 4: mem.write32(address, static_cast<uint32_t>(value)); break;
+        case 8: mem.write64(address, value); break;
+    }
+}
+
+long long microsecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs in the forked child: everything it changes stays private to the job
+void handleJob(Simulator& sim, int conn, std::chrono::steady_clock::time_point forkStart) {
+    std::vector<std::string> lines;
+    if (!readRequest(conn, lines)) {
+        return;
+    }
+
+    std::ostringstream reply;
+    size_t limit = DEFAULT_JOB_LIMIT;
+    std::vector<MemoryDump> dumps;
+    std::string status;
+    try {
+        for (const std::string& line : lines) {
+            std::istringstream iss(line);
+            std::string cmd;
+            if (!(iss >> cmd)) {
+                continue;
+            }
+            if (cmd == "limit") {
+                iss >> limit;
+            } else if (cmd == "dump") {
+                std::string addr;
+                int count = 0;
+                iss >> addr >> count;
+                dumps.push_back({std::stoull(addr, nullptr, 0), count});
+            } else if (int size = directiveSize(cmd)) {
+                std::string addr, value;
+                iss >> addr;
+                uint64_t address = std::stoull(addr, nullptr, 0);
+                while (std::getline(iss >> std::ws, value, ',')) {
+                    std::istringstream values(value);
+                    std::string token;
+                    while (values >> token) {
+                        storeValue(sim.memory(), address, size, std::stoull(token, nullptr, 0));
+                        address += size;
+                    }
+                }
+            } else {
+                throw std::runtime_error("Unknown request: " + line);
+            }
+        }
+    } catch (const std::exception& e) {
+        status = std::string("error ") + e.what();
+    }
+
+    long long setupUs = microsecondsSince(forkStart);
+    auto runStart = std::chrono::steady_clock::now();
+    if (status.empty()) {
+        try {
+            status = sim.runQuiet(limit) ? "done" : "limit";
+        } catch (const std::exception& e) {
+            status = std::string("error ") + e.what();
+        }
+    }
+    long long runUs = microsecondsSince(runStart);
+
+    reply << "status " << status << "\n";
+    reply << "instructions " << sim.instructionCount() << "\n";
+    reply << "setup_us " << setupUs << "\n";
+    reply << "run_us " << runUs << "\n";
+    for (int i = 0; i < 32; ++i) {
+        reply << "x" << std::dec << i << " 0x" << std::hex << sim.registers().read(i) << "\n";
+    }
+    for (const MemoryDump& dump : dumps) {
+        reply << "mem 0x" << std::hex << dump.address;
+        for (int i = 0; i < dump.count && sim.memory().isValidAddress(dump.address + i); ++i) {
+            reply << " " << std::setw(2) << std::setfill('0') << sim.memory().read8(dump.address + i);
+        }
+        reply << "\n";
+    }
+    reply << "end\n";
+    writeAll(conn, reply.str());
+}
+
+void printServerUsage() {
+    std::cerr << "Usage: simulator --server <socket> (<program.hex> [data.s] | --snapshot <file>) [--warm <instructions>]" << std::endl;
+}
+
+} // namespace
+
+int serverMain(int argc, char* argv[]) {
+    if (argc < 4) {
+        printServerUsage();
+        return 1;
+    }
+    std::string socketPath = argv[2];
+    std::string snapshotFile;
+    std::vector<std::string> inputs;
+    size_t warmInstructions = 0;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--snapshot" && i + 1 < argc) {
+            snapshotFile = argv[++i];
+        } else if (arg == "--warm" && i + 1 < argc) {
+            warmInstructions = std::stoull(argv[++i]);
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (snapshotFile.empty() == inputs.empty() || inputs.size() > 2) {
+        printServerUsage();
+        return 1;
+    }
+
+    Simulator sim;
+    try {
+        sim.setReverseDebugging(false);
+        if (!snapshotFile.empty()) {
+            sim.loadSnapshotFile(snapshotFile);
+        } else {
+            sim.loadProgram(inputs[0]);
+            if (inputs.size() > 1) {
+                sim.loadDataSection(inputs[1]);
+            }
+        }
+        if (warmInstructions > 0) {
+            sim.runQuiet(warmInstructions);
+            std::cout << "Warmed up for " << sim.instructionCount() << " instructions" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (listenFd < 0 || socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: Could not create socket " << socketPath << std::endl;
+        return 1;
+    }
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd, 128) != 0) {
+        std::cerr << "Error: Could not listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        close(listenFd);
+        return 1;
+    }
+
+    // Children are reaped automatically; jobs run concurrently
+    signal(SIGCHLD, SIG_IGN);
+    std::cout << "Serving jobs on " << socketPath << std::endl;
+
+    while (true) {
+        int conn = accept(listenFd, nullptr, nullptr);
+        if (conn < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error: accept failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        std::cout.flush();
+        auto forkStart = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(listenFd);
+            handleJob(sim, conn, forkStart);
+            close(conn);
+            _exit(0);
+        }
+        if (pid < 0) {
+            std::cerr << "Error: fork failed: " << std::strerror(errno) << std::endl;
+        }
+        close(conn);
+    }
+    close(listenFd);
+    unlink(socketPath.c_str());
+    return 1;
+}
@@ -0,0 +1,463 @@
+#include "../include/simt.h"
+#include "../include/hart.h"
+#include <stdexcept>
+#include <utility>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+enum AluOp {
+    OP_ADD, OP_SUB, OP_XOR, OP_OR, OP_AND, OP_SLL, OP_SRL, OP_SRA, OP_SLT, OP_SLTU,
+    OP_ADDW, OP_SUBW, OP_SLLW, OP_SRLW, OP_SRAW
+};
+
+// ALU operation of OP and OP-IMM by funct3
+const int FUNCT3_OPS[8] = {OP_ADD, OP_SLL, OP_SLT, OP_SLTU, OP_XOR, OP_SRL, OP_OR, OP_AND};
+
+int64_t sext(uint64_t value, int bits) {
+    int64_t m = 1LL << (bits - 1);
+    return (static_cast<int64_t>(value) ^ m) - m;
+}
+
+uint64_t sext32(uint64_t value) {
+    return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(value)));
+}
+
+void aluPortable(int op, uint64_t* d, const uint64_t* a, const uint64_t* b, int n) {
+    for (int i = 0; i < n; ++i) {
+        uint64_t x = a[i];
+        uint64_t y = b[i];
+        switch (op) {
+            case OP_ADD: d[i] = x + y; break;
+            case OP_SUB: d[i] = x - y; break;
+            case OP_XOR: d[i] = x ^ y; break;
+            case OP_OR: d[i] = x | y; break;
+            case OP_AND: d[i] = x & y; break;
+            case OP_SLL: d[i] = x << (y & 0x3F); break;
+            case OP_SRL: d[i] = x >> (y & 0x3F); break;
+            case OP_SRA: d[i] = static_cast<int64_t>(x) >> (y & 0x3F); break;
+            case OP_SLT: d[i] = static_cast<int64_t>(x) < static_cast<int64_t>(y) ? 1 : 0; break;
+            case OP_SLTU: d[i] = x < y ? 1 : 0; break;
+            case OP_ADDW: d[i] = sext32(x + y); break;
+            case OP_SUBW: d[i] = sext32(x - y); break;
+            case OP_SLLW: d[i] = sext32(static_cast<uint32_t>(x) << (y & 0x1F)); break;
+            case OP_SRLW: d[i] = sext32(static_cast<uint32_t>(x) >> (y & 0x1F)); break;
+            case OP_SRAW: d[i] = sext32(static_cast<uint32_t>(static_cast<int32_t>(x) >> (y & 0x1F))); break;
+        }
+    }
+}
+
+#if defined(__x86_64__)
+// Sign-extends the low 32 bits of each 64-bit element
+__attribute__((target("avx2")))
+__m256i sext32Avx2(__m256i v) {
+    __m256i sign = _mm256_shuffle_epi32(_mm256_srai_epi32(v, 31), _MM_SHUFFLE(2, 2, 0, 0));
+    return _mm256_blend_epi32(v, sign, 0xAA);
+}
+
+// n is a multiple of 4; d may alias a or b
+__attribute__((target("avx2")))
+void aluAvx2(int op, uint64_t* d, const uint64_t* a, const uint64_t* b, int n) {
+    const __m256i shift64 = _mm256_set1_epi64x(0x3F);
+    const __m256i shift32 = _mm256_set1_epi64x(0x1F);
+    const __m256i signBit = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    for (int i = 0; i < n; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i r;
+        switch (op) {
+            case OP_ADD: r = _mm256_add_epi64(x, y); break;
+            case OP_SUB: r = _mm256_sub_epi64(x, y); break;
+            case OP_XOR: r = _mm256_xor_si256(x, y); break;
+            case OP_OR: r = _mm256_or_si256(x, y); break;
+            case OP_AND: r = _mm256_and_si256(x, y); break;
+            case OP_SLL: r = _mm256_sllv_epi64(x, _mm256_and_si256(y, shift64)); break;
+            case OP_SRL: r = _mm256_srlv_epi64(x, _mm256_and_si256(y, shift64)); break;
+            case OP_SRA: {
+                // No 64-bit arithmetic shift before AVX-512: shift the sign fill back in
+                __m256i count = _mm256_and_si256(y, shift64);
+                __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+                __m256i fill = _mm256_sllv_epi64(sign, _mm256_sub_epi64(_mm256_set1_epi64x(64), count));
+                r = _mm256_or_si256(_mm256_srlv_epi64(x, count), fill);
+                break;
+            }
+            case OP_SLT: r = _mm256_srli_epi64(_mm256_cmpgt_epi64(y, x), 63); break;
+            case OP_SLTU:
+                r = _mm256_srli_epi64(_mm256_cmpgt_epi64(_mm256_xor_si256(y, signBit), _mm256_xor_si256(x, signBit)), 63);
+                break;
+            case OP_ADDW: r = sext32Avx2(_mm256_add_epi64(x, y)); break;
+            case OP_SUBW: r = sext32Avx2(_mm256_sub_epi64(x, y)); break;
+            case OP_SLLW: r = sext32Avx2(_mm256_sllv_epi32(x, _mm256_and_si256(y, shift32))); break;
+            case OP_SRLW: r = sext32Avx2(_mm256_srlv_epi32(x, _mm256_and_si256(y, shift32))); break;
+            case OP_SRAW: r = sext32Avx2(_mm256_srav_epi32(x, _mm256_and_si256(y, shift32))); break;
+            default: r = x; break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), r);
+    }
+}
+#endif
+
+bool branchTaken(int condition, uint64_t x, uint64_t y) {
+    switch (condition) {
+        case 0x0: return x == y;
+        case 0x1: return x != y;
+        case 0x4: return static_cast<int64_t>(x) < static_cast<int64_t>(y);
+        case 0x5: return static_cast<int64_t>(x) >= static_cast<int64_t>(y);
+        case 0x6: return x < y;
+        default: return x >= y;
+    }
+}
+
+int lowestLane(uint32_t mask) {
+    return __builtin_ctz(mask);
+}
+
+} // namespace
+
+bool SimtGroup::hasAvx2() {
+#if defined(__x86_64__)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+SimtGroup::SimtGroup(const Program& program, const std::vector<Memory*>& laneMemory)
+    : program(program), memory(laneMemory), laneCount(static_cast<int>(laneMemory.size())),
+      vectorWidth((laneCount + 3) & ~3), active(0), pc(0), executed(0), limit(0) {
+    if (laneCount < 1 || laneCount > MAX_LANES) {
+        throw std::out_of_range("SIMT group needs 1 to " + std::to_string(MAX_LANES) + " lanes");
+    }
+    // Lanes start from the same all-zero registers as a single-hart
+    // Simulator, so --scalar runs are a like-for-like baseline
+    for (auto& row : regs) {
+        for (uint64_t& value : row) {
+            value = 0;
+        }
+    }
+    laneRegisters.resize(laneCount);
+    results.resize(laneCount);
+
+    // Predecode once for every lane. Words the decoder rejects only fault
+    // the lanes that actually reach them.
+    ops.resize(program.size());
+    for (size_t i = 0; i < program.size(); ++i) {
+        uint32_t mc = program.instruction(i);
+        Op& op = ops[i];
+        op.kind = OTHER;
+        op.length = program.length(i);
+        op.function = 0;
+        op.rd = (mc >> 7) & 0x1F;
+        op.rs1 = (mc >> 15) & 0x1F;
+        op.rs2 = (mc >> 20) & 0x1F;
+        op.imm = sext(mc >> 20, 12);
+        try {
+            op.scalar = Instruction::decode(mc, op.length);
+        } catch (const std::exception&) {
+            continue;
+        }
+
+        uint32_t opcode = mc & 0x7F;
+        uint32_t funct3 = (mc >> 12) & 0x7;
+        uint32_t funct7 = (mc >> 25) & 0x7F;
+        bool alt = funct7 == 0x20;
+        // Zba/Zbb share these opcodes; anything else in funct7 runs as OTHER
+        bool base = funct7 == 0x00 || (alt && (funct3 == 0x0 || funct3 == 0x5));
+        switch (opcode) {
+            case 0x33: // OP
+                if (base) {
+                    op.kind = ALU;
+                    op.function = alt ? (funct3 == 0x0 ? OP_SUB : OP_SRA) : FUNCT3_OPS[funct3];
+                }
+                break;
+            case 0x13: // OP-IMM
+                // Shifts keep shamt[5] in funct7, so match on funct6
+                if ((funct3 == 0x1 && (mc >> 26) != 0x00) ||
+                    (funct3 == 0x5 && (mc >> 26) != 0x00 && (mc >> 26) != 0x10)) {
+                    break;
+                }
+                op.kind = ALU_IMM;
+                op.function = FUNCT3_OPS[funct3];
+                if (funct3 == 0x1 || funct3 == 0x5) {
+                    op.imm = (mc >> 20) & 0x3F;
+                    if ((mc >> 26) == 0x10) op.function = OP_SRA;
+                }
+                break;
+            case 0x3B: // OP-32
+                if (base) {
+                    op.kind = ALU;
+                    op.function = funct3 == 0x0 ? (alt ? OP_SUBW : OP_ADDW) : funct3 == 0x1 ? OP_SLLW : (alt ? OP_SRAW : OP_SRLW);
+                }
+                break;
+            case 0x1B: // OP-IMM-32
+                if (funct3 != 0x0 && !base) {
+                    break;
+                }
+                op.kind = ALU_IMM;
+                op.function = funct3 == 0x0 ? OP_ADDW : funct3 == 0x1 ? OP_SLLW : (alt ? OP_SRAW : OP_SRLW);
+                if (funct3 != 0x0) {
+                    op.imm = (mc >> 20) & 0x1F;
+                }
+                break;
+            case 0x37:
+                op.kind = LUI;
+                op.imm = static_cast<int64_t>(mc & 0xFFFFF000);
+                break;
+            case 0x03:
+                op.kind = LOAD;
+                op.function = funct3;
+                break;
+            case 0x23:
+                op.kind = STORE;
+                op.function = funct3;
+                op.imm = sext(((mc >> 7) & 0x1F) | ((mc >> 25) << 5), 12);
+                break;
+            case 0x63:
+                op.kind = BRANCH;
+                op.function = funct3;
+                op.imm = sext(((mc >> 31) & 0x1) << 12 | ((mc >> 25) & 0x3F) << 5 |
+                              ((mc >> 8) & 0xF) << 1 | ((mc >> 7) & 0x1) << 11, 13);
+                break;
+            case 0x6F:
+                op.kind = JAL;
+                op.imm = sext(((mc >> 31) & 0x1) << 20 | ((mc >> 12) & 0xFF) << 12 |
+                              ((mc >> 20) & 0x1) << 11 | ((mc >> 21) & 0x3FF) << 1, 21);
+                break;
+            case 0x67:
+                op.kind = JALR;
+                break;
+        }
+    }
+}
+
+void SimtGroup::executeAlu(int function, int rd, const uint64_t* a, const uint64_t* b) {
+    if (rd == 0) {
+        return;
+    }
+#if defined(__x86_64__)
+    if (hasAvx2()) {
+        aluAvx2(function, regs[rd], a, b, vectorWidth);
+        return;
+    }
+#endif
+    aluPortable(function, regs[rd], a, b, laneCount);
+}
+
+RegisterFile SimtGroup::laneState(int lane) const {
+    RegisterFile rf = laneRegisters[lane];
+    for (int r = 1; r < 32; ++r) {
+        rf.write(r, regs[r][lane]);
+    }
+    rf.write(RegisterFile::PC, pc);
+    return rf;
+}
+
+void SimtGroup::retire(int lane, const std::string& error) {
+    LaneResult& result = results[lane];
+    result.registers = laneState(lane);
+    result.instructions = executed;
+    result.finished = error.empty() && pc >= program.endAddress();
+    result.splitOff = false;
+    result.error = error;
+    active &= ~(1u << lane);
+}
+
+// The lane has already executed the current instruction; it continues alone
+void SimtGroup::splitOff(int lane, uint64_t nextPc, size_t maxInstructions) {
+    RegisterFile rf = laneState(lane);
+    rf.write(RegisterFile::PC, nextPc);
+    Hart hart(lane, program, *memory[lane]);
+    hart.resume(rf, nextPc, executed + 1);
+    while (!hart.finished() && !hart.faulted() && hart.instructionCount() < maxInstructions) {
+        hart.run(maxInstructions - hart.instructionCount());
+    }
+
+    LaneResult& result = results[lane];
+    result.registers = hart.registers();
+    result.instructions = hart.instructionCount();
+    result.finished = hart.finished();
+    result.splitOff = true;
+    result.error = hart.error();
+    active &= ~(1u << lane);
+}
+
+void SimtGroup::executeLoad(const Op& op) {
+    for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+        int lane = lowestLane(lanes);
+        uint64_t addr = regs[op.rs1][lane] + op.imm;
+        try {
+            uint64_t value;
+            switch (op.function) {
+                case 0x2: value = sext(memory[lane]->read32(addr), 32); break;
+                case 0x3: value = memory[lane]->read64(addr); break;
+                default: value = memory[lane]->read32(addr); break;
+            }
+            if (op.rd != 0) {
+                regs[op.rd][lane] = value;
+            }
+        } catch (const std::exception& e) {
+            retire(lane, e.what());
+        }
+    }
+}
+
+void SimtGroup::executeStore(const Op& op) {
+    for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+        int lane = lowestLane(lanes);
+        uint64_t addr = regs[op.rs1][lane] + op.imm;
+        try {
+            if (op.function == 0x3) {
+                memory[lane]->write64(addr, regs[op.rs2][lane]);
+            } else {
+                memory[lane]->write32(addr, regs[op.rs2][lane] & 0xFFFFFFFF);
+            }
+        } catch (const std::exception& e) {
+            retire(lane, e.what());
+        }
+    }
+}
+
+// Branches and jumps to the current instruction fall through, as in Simulator::step
+void SimtGroup::executeBranch(const Op& op) {
+    uint64_t target = pc + (op.imm == 0 ? op.length : op.imm);
+    uint32_t taken = 0;
+    for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+        int lane = lowestLane(lanes);
+        if (branchTaken(op.function, regs[op.rs1][lane], regs[op.rs2][lane])) {
+            taken |= 1u << lane;
+        }
+    }
+    // The majority stays in lockstep; ties follow the lowest active lane
+    int takenCount = __builtin_popcount(taken);
+    int activeCount = __builtin_popcount(active);
+    bool followTaken = takenCount * 2 > activeCount ||
+                       (takenCount * 2 == activeCount && ((taken >> lowestLane(active)) & 1));
+    uint32_t diverging = followTaken ? active & ~taken : taken;
+    for (uint32_t lanes = diverging; lanes; lanes &= lanes - 1) {
+        splitOff(lowestLane(lanes), followTaken ? pc + op.length : target, limit);
+    }
+    pc = followTaken ? target : pc + op.length;
+}
+
+void SimtGroup::executeJalr(const Op& op) {
+    uint64_t next[MAX_LANES];
+    for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+        int lane = lowestLane(lanes);
+        uint64_t target = (regs[op.rs1][lane] + op.imm) & ~1ULL;
+        next[lane] = target == pc ? pc + op.length : target;
+    }
+    if (op.rd != 0) {
+        for (int lane = 0; lane < laneCount; ++lane) {
+            regs[op.rd][lane] = pc + op.length;
+        }
+    }
+    uint64_t leaderNext = next[lowestLane(active)];
+    for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+        int lane = lowestLane(lanes);
+        if (next[lane] != leaderNext) {
+            splitOff(lane, next[lane], limit);
+        }
+    }
+    pc = leaderNext;
+}
+
+// Instructions without a lane-parallel form run through the regular
+// Instruction objects, one lane at a time
+void SimtGroup::executeScalar(const Op& op) {
+    for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+        int lane = lowestLane(lanes);
+        if (!op.scalar) {
+            retire(lane, "Unknown instruction");
+            continue;
+        }
+        RegisterFile rf = laneState(lane);
+        rf.setRetired(executed);
+        try {
+            op.scalar->execute(rf, *memory[lane]);
+        } catch (const std::exception& e) {
+            retire(lane, e.what());
+            continue;
+        }
+        for (int r = 1; r < 32; ++r) {
+            regs[r][lane] = rf.read(r);
+        }
+        bool countsEvents = rf.countsEvents();
+        laneRegisters[lane] = std::move(rf);
+        // Lockstep execution does not count events, so a lane that
+        // selects one continues on its own
+        if (countsEvents) {
+            splitOff(lane, pc + op.length, limit);
+        }
+    }
+    pc += op.length;
+}
+
+void SimtGroup::run(size_t maxInstructions) {
+    limit = maxInstructions;
+    active = (1u << laneCount) - 1;
+    while (active && pc < program.endAddress() && executed < limit) {
+        size_t index;
+        try {
+            index = program.indexAt(pc);
+        } catch (const std::exception& e) {
+            for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+                retire(lowestLane(lanes), e.what());
+            }
+            break;
+        }
+        const Op& op = ops[index];
+        switch (op.kind) {
+            case ALU:
+                executeAlu(op.function, op.rd, regs[op.rs1], regs[op.rs2]);
+                pc += op.length;
+                break;
+            case ALU_IMM:
+                for (int lane = 0; lane < vectorWidth; ++lane) {
+                    operand[lane] = op.imm;
+                }
+                executeAlu(op.function, op.rd, regs[op.rs1], operand);
+                pc += op.length;
+                break;
+            case LUI:
+                if (op.rd != 0) {
+                    for (int lane = 0; lane < laneCount; ++lane) {
+                        regs[op.rd][lane] = static_cast<uint64_t>(op.imm);
+                    }
+                }
+                pc += op.length;
+                break;
+            case LOAD:
+                executeLoad(op);
+                pc += op.length;
+                break;
+            case STORE:
+                executeStore(op);
+                pc += op.length;
+                break;
+            case BRANCH:
+                executeBranch(op);
+                break;
+            case JAL:
+                if (op.rd != 0) {
+                    for (int lane = 0; lane < laneCount; ++lane) {
+                        regs[op.rd][lane] = pc + op.length;
+                    }
+                }
+                pc += op.imm == 0 ? op.length : op.imm;
+                break;
+            case JALR:
+                executeJalr(op);
+                break;
+            case OTHER:
+                executeScalar(op);
+                break;
+        }
+        executed++;
+    }
+    for (uint32_t lanes = active; lanes; lanes &= lanes - 1) {
+        retire(lowestLane(lanes), "");
+    }
+}
@@ -0,0 +1,127 @@
+#include "../include/simt_runner.h"
+#include "../include/simt.h"
+#include "../include/simulator.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t DEFAULT_SIMT_LIMIT = 100000000;
+
+struct InstanceResult {
+    std::string status;
+    uint64_t a0;
+    size_t instructions;
+    bool splitOff;
+};
+
+std::unique_ptr<Simulator> loadInstance(const std::string& program, const std::string& data) {
+    std::unique_ptr<Simulator> sim(new Simulator());
+    sim->setReverseDebugging(false);
+    sim->loadProgram(program);
+    sim->loadDataSection(data);
+    return sim;
+}
+
+void printSimtUsage() {
+    std::cerr << "Usage: simulator --simt <program.hex> [--lanes <n>] [--limit <instructions>] [--scalar] <data.s>..." << std::endl;
+}
+
+} // namespace
+
+int simtMain(int argc, char* argv[]) {
+    if (argc < 4) {
+        printSimtUsage();
+        return 1;
+    }
+    std::string program = argv[2];
+    int lanes = 8;
+    size_t limit = DEFAULT_SIMT_LIMIT;
+    bool scalar = false;
+    std::vector<std::string> dataFiles;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--lanes" && i + 1 < argc) {
+            lanes = std::stoi(argv[++i]);
+        } else if (arg == "--limit" && i + 1 < argc) {
+            limit = std::stoull(argv[++i]);
+        } else if (arg == "--scalar") {
+            scalar = true;
+        } else {
+            dataFiles.push_back(arg);
+        }
+    }
+    if (dataFiles.empty() || lanes < 1 || lanes > SimtGroup::MAX_LANES) {
+        printSimtUsage();
+        return 1;
+    }
+
+    std::vector<InstanceResult> results(dataFiles.size());
+    size_t lockstep = 0;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        for (size_t first = 0; first < dataFiles.size(); first += scalar ? 1 : lanes) {
+            size_t count = scalar ? 1 : std::min<size_t>(lanes, dataFiles.size() - first);
+            std::vector<std::unique_ptr<Simulator>> instances;
+            std::vector<Memory*> memories;
+            for (size_t i = 0; i < count; ++i) {
+                instances.push_back(loadInstance(program, dataFiles[first + i]));
+                memories.push_back(&instances.back()->memory());
+            }
+
+            if (scalar) {
+                InstanceResult& r = results[first];
+                try {
+                    r.status = instances[0]->runQuiet(limit) ? "done" : "limit";
+                } catch (const std::exception& e) {
+                    r.status = "error";
+                }
+                r.a0 = instances[0]->registers().read(10);
+                r.instructions = instances[0]->instructionCount();
+                r.splitOff = false;
+                continue;
+            }
+
+            SimtGroup group(instances[0]->program(), memories);
+            group.run(limit);
+            lockstep += group.lockstepInstructions();
+            for (size_t i = 0; i < count; ++i) {
+                const SimtGroup::LaneResult& lane = group.result(static_cast<int>(i));
+                InstanceResult& r = results[first + i];
+                r.status = !lane.error.empty() ? "error" : lane.finished ? "done" : "limit";
+                r.a0 = lane.registers.read(10);
+                r.instructions = lane.instructions;
+                r.splitOff = lane.splitOff;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t total = 0;
+    size_t splits = 0;
+    for (size_t i = 0; i < dataFiles.size(); ++i) {
+        const InstanceResult& r = results[i];
+        total += r.instructions;
+        splits += r.splitOff;
+        std::cout << std::left << std::setw(40) << dataFiles[i] << std::right << std::setw(7) << r.status
+                  << "  a0=0x" << std::hex << r.a0 << std::dec << std::setw(12) << r.instructions << " instr"
+                  << (r.splitOff ? "  (scalar after divergence)" : "") << std::endl;
+    }
+    if (scalar) {
+        std::cout << "Scalar: ";
+    } else {
+        std::cout << "SIMT: " << lanes << " lanes (" << (SimtGroup::hasAvx2() ? "AVX2" : "portable") << "), "
+                  << lockstep << " lockstep steps, " << splits << " lanes split off; ";
+    }
+    std::cout << dataFiles.size() << " runs, " << total << " instructions in " << std::fixed << std::setprecision(3)
+              << seconds * 1e3 << " ms (" << (seconds > 0 ? total / seconds / 1e6 : 0.0) << " MIPS)" << std::endl;
+    return 0;
+}
@@ -1,12 +1,15 @@
 #include "../include/simulator.h"
 #include "../include/instruction.h"
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <cstring>
+#include <limits>
 #include <unordered_map>
+#include <unordered_set>
 
 
 void Simulator::scanLabels(const std::string& filename) {
@@ -18,13 +21,19 @@ void Simulator::scanLabels(const std::string& filename) {
     std::string line;
     uint64_t address = 0;
     while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#')); // Hand-written test programs annotate words
         size_t colonPos = line.find(':');
         if (colonPos != std::string::npos) {
             std::string label = line.substr(0, colonPos);
             labels[label] = address;
+            symbols.add(address, label);
+        }
+        // Each line holds one instruction, 2 bytes if compressed
+        std::string word = line.substr(colonPos == std::string::npos ? 0 : colonPos + 1);
+        word.erase(std::remove_if(word.begin(), word.end(), ::isspace), word.end());
+        if (!word.empty()) {
+            address += Program::isCompressed(std::stoul(word, nullptr, 16)) ? 2 : 4;
         }
-        // Assuming each line corresponds to one instruction
-        address += 4;
     }
 }
 
@@ -34,14 +43,16 @@ void Simulator::loadProgram(const std::string& filename) {
         throw std::runtime_error("Could not open file: " + filename);
     }
 
-    machineCode.clear();
-    lineNumbers.clear();
+    text.clear();
+    programFile = filename;
     labels.clear();  // Clear any existing labels
+    symbols.clear();
     scanLabels(filename); // Scan for labels
 
     std::string line;
     int lineNum = 1;
     while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
         // Check for labels
         size_t colonPos = line.find(':');
         if (colonPos != std::string::npos) {
@@ -52,23 +63,30 @@ void Simulator::loadProgram(const std::string& filename) {
 
         line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
         if (!line.empty()) {
-            uint32_t instruction = std::stoul(line, nullptr, 16);
-            machineCode.push_back(instruction);
-            lineNumbers.push_back(lineNum);
+            text.append(std::stoul(line, nullptr, 16), lineNum);
         }
         lineNum++;
     }
 
     pc = 0;
-    currentLine = lineNumbers[0];
+    currentLine = text.line(0);
+    executedInstructions = 0;
+    runSeconds = 0;
+    timedInstructions = 0;
+    checkpoints.clear();
+    snapshots.clear();
+    undoLog.reset(0);
+    symbols.index(text);
 
     // Initialize the call stack with main
     callStack.clear();
-    callStack.push_back({"main", currentLine});
+    callStack.push_back(makeFrame(0, NO_RETURN, currentLine));
+    resetProfiles();
+    translatePlugins();
 
-    // std::cout << "Loaded " << machineCode.size() << " instructions:" << std::endl;
-    // for (size_t i = 0; i < machineCode.size(); ++i) {
-    //     std::cout << "0x" << std::hex << std::setw(8) << std::setfill('0') << machineCode[i] << std::endl;
+    // std::cout << "Loaded " << text.size() << " instructions:" << std::endl;
+    // for (size_t i = 0; i < text.size(); ++i) {
+    //     std::cout << "0x" << std::hex << std::setw(8) << std::setfill('0') << text.instruction(i) << std::endl;
     // }
 }
 
@@ -159,76 +177,753 @@ void Simulator::loadDataSection(const std::string& filename) {
     // }
 }
 
-void Simulator::updateCallStack(uint32_t instruction) {
+Simulator::CallStackFrame Simulator::makeFrame(uint64_t entry, uint64_t returnAddress, int line) const {
+    int symbol = SymbolTable::NONE;
+    if (entry < text.endAddress()) {
+        symbol = symbols.startingAt(text.indexAt(entry));
+    }
+    return {entry, returnAddress, symbol, line};
+}
+
+std::string Simulator::frameName(const CallStackFrame& frame) const {
+    if (frame.returnAddress == NO_RETURN) {
+        return "main";
+    }
+    return frame.symbol != SymbolTable::NONE ? symbols.name(frame.symbol) : symbols.nameAt(frame.entry);
+}
+
+void Simulator::pushFrame(const CallStackFrame& frame) {
+    if (reverseEnabled) {
+        undoLog.recordFramePush();
+    }
+    callStack.push_back(frame);
+    framePushed = true;
+}
+
+void Simulator::popFrame() {
+    const CallStackFrame& frame = callStack.back();
+    if (reverseEnabled) {
+        undoLog.recordFramePop(frame.entry, frame.returnAddress, frame.line);
+    }
+    callStack.pop_back();
+    framesPopped++;
+}
+
+void Simulator::updateCallStack(uint32_t instruction, uint64_t fallThrough) {
     uint32_t opcode = instruction & 0x7F;
     uint32_t rd = (instruction >> 7) & 0x1F;
     uint32_t rs1 = (instruction >> 15) & 0x1F;
+    bool jal = opcode == 0x6F;
+    bool linkRd = rd == 1 || rd == 5;
+    bool linkRs1 = !jal && (rs1 == 1 || rs1 == 5);
 
-    if (opcode == 0x6F) { // JAL
-        std::string funcName = "unknown";
-        uint64_t targetAddress = pc * 4;
-        for (const auto& label : labels) {
-            if (label.second == targetAddress) {
-                funcName = label.first;
-                break;
+    framesPopped = 0;
+    framePushed = false;
+    callStack.back().line = currentLine;
+    if (!jal && opcode != 0x67) {
+        return;
+    }
+
+    if (linkRd) {
+        // jalr between two different link registers swaps coroutines
+        if (linkRs1 && rs1 != rd && callStack.size() > 1) {
+            popFrame();
+        }
+        int symbol = pc < text.endAddress() ? symbols.startingAt(text.indexAt(pc)) : SymbolTable::NONE;
+        if (symbol != SymbolTable::NONE) {
+            symbols.markFunction(symbol);
+        }
+        pushFrame({pc, fallThrough, symbol, currentLine});
+        return;
+    }
+    if (rd != 0) {
+        return;
+    }
+
+    if (!jal) {
+        // Return to the nearest frame expecting this address, which may
+        // unwind several frames; the root frame never returns
+        size_t depth = callStack.size();
+        while (depth > 1 && callStack[depth - 1].returnAddress != pc) {
+            depth--;
+        }
+        if (depth > 1) {
+            while (callStack.size() >= depth) {
+                popFrame();
             }
+            return;
         }
-        callStack.push_back({funcName, currentLine});
-    } else if (opcode == 0x67 && rd == 0 && rs1 == 1) { // JALR x0, x1, 0 (return)
-        if (callStack.size() > 1) {
-            callStack.pop_back();
+        if (linkRs1 && callStack.size() > 1) {
+            popFrame();
+            return;
         }
     }
 
-    // Update the line number of the current function
-    if (!callStack.empty()) {
-        callStack.back().line = currentLine;
+    if (callStack.size() > 1 && pc < text.endAddress()) {
+        int symbol = symbols.startingAt(text.indexAt(pc));
+        if (symbol != SymbolTable::NONE && symbols.isFunction(symbol)) {
+            uint64_t returnAddress = callStack.back().returnAddress;
+            popFrame();
+            pushFrame({pc, returnAddress, symbol, currentLine});
+        }
     }
 }
 
+void Simulator::profileInstruction(size_t index) {
+    if (collectingStats) {
+        instructionStats.count(index, pc != text.address(index) + text.length(index));
+    }
+    if (profiling) {
+        profile.count(index);
+    }
+    if (callProfiling) {
+        callGraph.tick();
+        for (size_t i = 0; i < framesPopped; ++i) {
+            callGraph.ret();
+        }
+        if (framePushed && pc < text.endAddress()) {
+            size_t entry = text.indexAt(pc);
+            if (!callGraph.knows(entry)) {
+                callGraph.addFunction(entry, frameName(callStack.back()), text.line(entry));
+            }
+            callGraph.call(index, text.line(index), entry);
+        }
+    }
+    if (sampling && sampler.tick()) {
+        takeSample();
+    }
+    if (!stream.empty()) {
+        publishEvents(index);
+    }
+    if (plugins.wanted(index)) {
+        uint32_t instruction = text.instruction(index);
+        uint64_t instPc = text.address(index);
+        PluginHost::Executed executed = {index, instPc, pc, instPc + text.length(index), (instruction & 0x7F) == 0x63,
+                                         framesPopped, framePushed};
+        plugins.dispatch(executed, mem.loggedAccesses());
+    }
+}
+
+void Simulator::publishEvents(size_t index) {
+    StreamEvent event;
+    event.pc = text.address(index);
+    event.instruction = text.instruction(index);
+    event.flags = StreamEvent::FLAG_RETIRED;
+    if ((event.instruction & 0x7F) == 0x63) {
+        event.flags |= StreamEvent::FLAG_BRANCH;
+        if (pc != event.pc + text.length(index)) {
+            event.flags |= StreamEvent::FLAG_TAKEN;
+        }
+    }
+    const std::vector<Memory::Access>& accesses = mem.loggedAccesses();
+    if (accesses.empty()) {
+        event.address = 0;
+        event.value = 0;
+        event.size = 0;
+        stream.push(event);
+        return;
+    }
+    for (const Memory::Access& access : accesses) {
+        event.address = access.address;
+        event.value = access.value;
+        event.size = static_cast<uint8_t>(access.size);
+        event.flags = (event.flags & ~StreamEvent::FLAG_STORE) | (access.isWrite ? StreamEvent::FLAG_STORE : 0);
+        stream.push(event);
+        event.flags &= ~StreamEvent::FLAG_RETIRED;
+    }
+}
+
+void Simulator::updateInstrumentation() {
+    anyProfiling = profiling || callProfiling || sampling || collectingStats || !plugins.empty() || !stream.empty();
+    bool logAccesses = plugins.wantsMemory() || !stream.empty();
+    if (logAccesses != loggingAccesses) {
+        mem.setAccessLogging(logAccesses);
+        loggingAccesses = logAccesses;
+    }
+}
+
+void Simulator::takeSample() {
+    std::string folded;
+    for (const CallStackFrame& frame : callStack) {
+        if (!folded.empty()) {
+            folded += ';';
+        }
+        folded += frameName(frame);
+    }
+    sampler.record(folded);
+}
+
 void Simulator::step() {
-    if (pc >= machineCode.size()) {
+    if (pc >= text.endAddress()) {
         std::cout << "Nothing to step" << std::endl;
         return;
     }
 
-    currentLine = lineNumbers[pc];
+    currentLine = lineAt(pc);
 
     if (breakpoints.find(currentLine) != breakpoints.end()) {
         std::cout << "Breakpoint hit at line " << std::dec << currentLine << std::endl;
         return;
     }
 
-    uint32_t instruction = machineCode[pc];
-    std::unique_ptr<Instruction> inst = Instruction::decode(instruction);
-    
-    updateCallStack(instruction);
+    try {
+        size_t index = executeCurrent(true);
+        if (anyProfiling) {
+            profileInstruction(index);
+        }
+    } catch (const std::exception& e) {
+        faulted = true;
+        std::cout << "Execution error at line " << std::dec << currentLine << ": " << e.what() << std::endl;
+    }
+}
+
+size_t Simulator::executeCurrent(bool trace) {
+    size_t index = text.indexAt(pc);
+    currentLine = text.line(index);
+    uint32_t instruction = text.instruction(index);
+    std::unique_ptr<Instruction> inst = Instruction::decode(instruction, text.length(index));
+
+    if (reverseEnabled) {
+        if (checkpoints.empty()) {
+            takeCheckpoint();
+        }
+        undoLog.setInstruction(executedInstructions);
+        undoLog.recordStep(pc, callStack.back().line);
+    }
     
-    std::cout << "Executed: " << inst->toString() << "; PC = 0x" << std::hex << std::setw(8) << std::setfill('0') << (pc * 4) << std::endl;
+    if (trace) {
+        std::cout << "Executed: " << inst->toString() << "; PC = 0x" << std::hex << std::setw(8) << std::setfill('0') << pc << std::endl;
+    }
     
     uint64_t old_pc = rf.read(RegisterFile::PC);
-    inst->execute(rf, mem);
+    mem.clearWatchHits(); // Drop hits from debugger reads (mem, data)
+    mem.clearAccessLog();
+    rf.setRetired(executedInstructions);
+    try {
+        inst->execute(rf, mem);
+        // Fault on a jump into the middle of an instruction, not at the next fetch
+        text.indexAt(rf.read(RegisterFile::PC));
+    } catch (...) {
+        // Leave the machine as it was before the faulting instruction
+        if (reverseEnabled) {
+            undoInstruction(executedInstructions);
+        }
+        throw;
+    }
     uint64_t new_pc = rf.read(RegisterFile::PC);
+
+    if (trace) {
+        reportWatchHits(*inst, old_pc);
+    } else if (mem.hasWatchHits()) {
+        watchTriggered = true;
+        mem.clearWatchHits();
+    }
     
     if (new_pc == old_pc) {
-        rf.write(RegisterFile::PC, old_pc + 4);
-        pc++;
-    } else {
-        pc = new_pc / 4;
+        new_pc = old_pc + inst->length();
+        rf.write(RegisterFile::PC, new_pc);
     }
+    if (rf.countsEvents()) {
+        rf.recordEvents(instruction, new_pc != old_pc + inst->length());
+    }
+    pc = new_pc;
+    updateCallStack(instruction, old_pc + inst->length());
     
     executedInstructions++;
+
+    if (reverseEnabled && executedInstructions % checkpointInterval == 0 &&
+        checkpoints.find(executedInstructions) == checkpoints.end()) {
+        takeCheckpoint();
+    }
+    return index;
 }
 
 void Simulator::run() {
-    while (pc < machineCode.size()) {
+    size_t before = executedInstructions;
+    auto start = std::chrono::steady_clock::now();
+    if (hostCounters) {
+        hostCounters->start();
+    }
+    runToStop();
+    if (hostCounters) {
+        hostCounters->stop();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    runSeconds += seconds;
+    timedInstructions += executedInstructions - before;
+    if (hostCounters) {
+        std::cout << "Perf stats for run:" << std::endl;
+        hostCounters->report(std::cout, executedInstructions - before, seconds);
+    }
+}
+
+void Simulator::setPerfStats(bool enabled) {
+    if (!enabled) {
+        hostCounters.reset();
+    } else if (!hostCounters) {
+        hostCounters.reset(new HostCounters());
+    }
+}
+
+void Simulator::runToStop() {
+    watchTriggered = false;
+    faulted = false;
+    while (pc < text.endAddress()) {
         step();
-        if (isBreakpoint()) {
+        if (isBreakpoint() || watchTriggered || faulted) {
             return;
         }
     }
 }
 
+Simulator::MachineState Simulator::captureState() const {
+    return {rf, mem.saveImage(), pc, executedInstructions, callStack};
+}
+
+void Simulator::restoreState(const MachineState& state) {
+    rf = state.rf;
+    rf.setJournal(reverseEnabled ? &undoLog : nullptr);
+    mem.restoreImage(state.memory);
+    pc = state.pc;
+    executedInstructions = state.executedInstructions;
+    callStack = state.callStack;
+    if (pc < text.endAddress()) {
+        currentLine = lineAt(pc);
+    }
+}
+
+bool Simulator::runQuiet(size_t maxInstructions) {
+    size_t limit = executedInstructions + std::min(maxInstructions, std::numeric_limits<size_t>::max() - executedInstructions);
+    size_t before = executedInstructions;
+    auto start = std::chrono::steady_clock::now();
+    while (pc < text.endAddress() && executedInstructions < limit) {
+        size_t index = executeCurrent(false);
+        if (anyProfiling) {
+            profileInstruction(index);
+        }
+    }
+    runSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    timedInstructions += executedInstructions - before;
+    return pc >= text.endAddress();
+}
+
+void Simulator::takeCheckpoint() {
+    checkpoints[executedInstructions] = captureState();
+
+    if (checkpoints.size() > maxCheckpoints) {
+        // Drop every other checkpoint between the first and the newest,
+        // doubling the spacing instead of forgetting the distant past
+        auto it = std::next(checkpoints.begin());
+        bool drop = true;
+        while (std::next(it) != checkpoints.end()) {
+            if (drop) {
+                it = checkpoints.erase(it);
+            } else {
+                ++it;
+            }
+            drop = !drop;
+        }
+    }
+}
+
+void Simulator::restoreCheckpoint(std::map<size_t, MachineState>::const_iterator it) {
+    restoreState(it->second);
+    undoLog.reset(executedInstructions);
+}
+
+void Simulator::undoInstruction(uint64_t instruction) {
+    while (!undoLog.empty() && undoLog.back().instruction == instruction) {
+        UndoLog::Entry& e = undoLog.back();
+        switch (e.kind) {
+            case UndoLog::REGISTER:
+                rf.restore(static_cast<int>(e.location), e.oldValue);
+                break;
+            case UndoLog::MEMORY:
+                mem.restore(e.location, e.size, e.oldValue);
+                break;
+            case UndoLog::STEP:
+                pc = e.location;
+                callStack.back().line = static_cast<int>(e.oldValue);
+                break;
+            case UndoLog::FRAME_PUSH:
+                callStack.pop_back();
+                break;
+            case UndoLog::FRAME_POP:
+                callStack.push_back(makeFrame(e.location, e.oldValue, e.line));
+                break;
+        }
+        undoLog.popBack();
+    }
+    currentLine = lineAt(pc);
+}
+
+bool Simulator::replayTo(size_t target) {
+    auto it = checkpoints.upper_bound(target);
+    if (it == checkpoints.begin()) {
+        return false;
+    }
+    restoreCheckpoint(--it);
+    while (executedInstructions < target && pc < text.endAddress()) {
+        executeCurrent(false);
+    }
+    return true;
+}
+
+void Simulator::gotoInstruction(size_t target) {
+    if (!reverseEnabled) {
+        std::cout << "Reverse debugging is off" << std::endl;
+        return;
+    }
+    try {
+        if (target > executedInstructions) {
+            while (executedInstructions < target && pc < text.endAddress()) {
+                executeCurrent(false);
+            }
+        } else if (target < executedInstructions) {
+            if (undoLog.canUndo(target)) {
+                while (executedInstructions > target) {
+                    undoInstruction(--executedInstructions);
+                }
+            } else if (!replayTo(target)) {
+                std::cout << "No recorded history before instruction " << std::dec << executedInstructions << std::endl;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Execution error at line " << std::dec << currentLine << ": " << e.what() << std::endl;
+    }
+    printPosition();
+}
+
+void Simulator::reverseStep() {
+    if (executedInstructions == 0) {
+        std::cout << "Already at the start of the program" << std::endl;
+        return;
+    }
+    gotoInstruction(executedInstructions - 1);
+}
+
+void Simulator::reverseContinue() {
+    if (!reverseEnabled) {
+        std::cout << "Reverse debugging is off" << std::endl;
+        return;
+    }
+    // Scan checkpoint intervals newest first, replaying each to find the
+    // last breakpoint or watchpoint hit before the current position
+    size_t end = executedInstructions;
+    try {
+        while (true) {
+            auto it = checkpoints.lower_bound(end);
+            if (it == checkpoints.begin()) {
+                break;
+            }
+            --it;
+            size_t segmentStart = it->first;
+            restoreCheckpoint(it);
+
+            bool found = false;
+            size_t stopAt = 0;
+            while (executedInstructions < end && pc < text.endAddress()) {
+                if (breakpoints.find(lineAt(pc)) != breakpoints.end()) {
+                    found = true;
+                    stopAt = executedInstructions;
+                }
+                watchTriggered = false;
+                executeCurrent(false);
+                if (watchTriggered) {
+                    found = true;
+                    stopAt = executedInstructions - 1;
+                }
+            }
+            watchTriggered = false;
+            if (found) {
+                replayTo(stopAt);
+                printPosition();
+                return;
+            }
+            end = segmentStart;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Execution error at line " << std::dec << currentLine << ": " << e.what() << std::endl;
+    }
+    if (!checkpoints.empty()) {
+        restoreCheckpoint(checkpoints.begin());
+    }
+    std::cout << "Reached the earliest recorded state" << std::endl;
+    printPosition();
+}
+
+void Simulator::printPosition() const {
+    std::cout << "At instruction " << std::dec << executedInstructions;
+    if (pc < text.endAddress()) {
+        size_t index = text.indexAt(pc);
+        std::cout << ", line " << text.line(index) << ": " << Instruction::decode(text.instruction(index))->toString()
+                  << "; PC = 0x" << std::hex << std::setw(8) << std::setfill('0') << pc;
+    } else {
+        std::cout << ", end of program";
+    }
+    std::cout << std::dec << std::endl;
+}
+
+void Simulator::setReverseDebugging(bool enabled) {
+    reverseEnabled = enabled;
+    rf.setJournal(enabled ? &undoLog : nullptr);
+    mem.setJournal(enabled ? &undoLog : nullptr);
+    checkpoints.clear();
+    undoLog.reset(executedInstructions);
+}
+
+void Simulator::configureReverse(size_t logEntries, size_t interval, size_t checkpointLimit) {
+    undoLog.setCapacity(logEntries);
+    undoLog.reset(executedInstructions);
+    checkpointInterval = std::max<size_t>(interval, 1);
+    maxCheckpoints = std::max<size_t>(checkpointLimit, 2);
+    printReverseStats();
+}
+
+void Simulator::printReverseStats() const {
+    // Count only pages a checkpoint keeps alive on its own: pages still
+    // shared with live memory or with another checkpoint cost nothing extra
+    std::unordered_set<const Memory::Page*> livePages;
+    for (const auto& page : mem.saveImage()) {
+        livePages.insert(page.get());
+    }
+    std::unordered_set<const Memory::Page*> heldPages;
+    size_t checkpointBytes = 0;
+    for (const auto& entry : checkpoints) {
+        const MachineState& cp = entry.second;
+        checkpointBytes += sizeof(MachineState) + cp.memory.capacity() * sizeof(Memory::Image::value_type) +
+                           cp.rf.memoryUsage();
+        for (const auto& page : cp.memory) {
+            if (!livePages.count(page.get()) && heldPages.insert(page.get()).second) {
+                checkpointBytes += Memory::PAGE_SIZE;
+            }
+        }
+        checkpointBytes += cp.callStack.capacity() * sizeof(CallStackFrame);
+    }
+    std::cout << "Reverse debugging: " << (reverseEnabled ? "on" : "off") << std::endl;
+    std::cout << "  Undo log:    " << std::dec << undoLog.size() << " / " << undoLog.capacity()
+              << " entries, " << undoLog.memoryUsage() / 1024 << " KiB" << std::endl;
+    std::cout << "  Checkpoints: " << checkpoints.size() << " / " << maxCheckpoints
+              << " (every " << checkpointInterval << " instructions), "
+              << checkpointBytes / 1024 << " KiB in " << heldPages.size() << " private pages" << std::endl;
+}
+
+void Simulator::setProfiling(bool enabled, size_t topN) {
+    profiling = enabled;
+    profileTop = topN;
+    updateInstrumentation();
+}
+
+void Simulator::resetProfiles() {
+    profile.reset(text.size());
+    resetCallGraph();
+    sampler.reset(sampler.interval());
+    instructionStats.reset(text.size());
+}
+
+void Simulator::resetProfile() {
+    profile.reset(text.size());
+}
+
+void Simulator::printProfile(size_t topN) const {
+    profile.report(std::cout, text, topN);
+}
+
+void Simulator::writeProfileListing(const std::string& filename) const {
+    if (programFile.empty()) {
+        throw std::runtime_error("No program loaded");
+    }
+    profile.writeListing(text, programFile, filename);
+}
+
+void Simulator::setCallProfiling(bool enabled) {
+    callProfiling = enabled;
+    updateInstrumentation();
+}
+
+void Simulator::resetCallGraph() {
+    callGraph.reset(text.size(), "main", text.empty() ? 1 : text.line(0));
+}
+
+void Simulator::printCallGraph() const {
+    callGraph.report(std::cout);
+}
+
+void Simulator::writeCallgrind(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not write file: " + filename);
+    }
+    callGraph.writeCallgrind(file, programFile);
+}
+
+void Simulator::setSampling(bool enabled) {
+    sampling = enabled;
+    updateInstrumentation();
+}
+
+void Simulator::setSampleInterval(uint64_t interval) {
+    sampler.reset(interval);
+}
+
+void Simulator::resetSamples() {
+    sampler.reset(sampler.interval());
+}
+
+void Simulator::writeFoldedStacks(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not write file: " + filename);
+    }
+    sampler.writeFolded(file);
+}
+
+void Simulator::translatePlugins() {
+    if (!plugins.empty()) {
+        plugins.translate(text);
+        updateInstrumentation();
+    }
+}
+
+void Simulator::loadPlugin(const std::string& path, const std::string& args) {
+    plugins.load(path, args, text);
+    updateInstrumentation();
+}
+
+void Simulator::listPlugins() const {
+    plugins.list();
+}
+
+void Simulator::unloadPlugins() {
+    plugins.unloadAll();
+    updateInstrumentation();
+}
+
+void Simulator::addStreamConsumer(std::unique_ptr<EventConsumer> consumer, EventStream::Policy policy) {
+    stream.addConsumer(std::move(consumer), policy);
+    updateInstrumentation();
+}
+
+void Simulator::printStreamStats() {
+    stream.flush();
+    stream.printStats(std::cout);
+}
+
+void Simulator::stopStream() {
+    if (stream.empty()) {
+        return;
+    }
+    stream.stop(std::cout);
+    updateInstrumentation();
+}
+
+void Simulator::finishProfile() const {
+    if (programFile.empty()) {
+        return;
+    }
+    try {
+        if (profiling) {
+            printProfile(profileTop);
+            writeProfileListing(programFile + ".prof");
+            std::cout << "Annotated listing written to " << programFile << ".prof" << std::endl;
+        }
+        if (callProfiling) {
+            printCallGraph();
+            writeCallgrind(programFile + ".callgrind");
+            std::cout << "Call graph written to " << programFile << ".callgrind" << std::endl;
+        }
+        if (sampling) {
+            writeFoldedStacks(programFile + ".folded");
+            std::cout << std::dec << sampler.samples() << " stack samples written to " << programFile << ".folded"
+                      << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+void Simulator::setStatsCollection(bool enabled) {
+    collectingStats = enabled;
+    updateInstrumentation();
+}
+
+void Simulator::resetStats() {
+    instructionStats.reset(text.size());
+    runSeconds = 0;
+    timedInstructions = 0;
+}
+
+void Simulator::registerStats(StatsRegistry& stats) const {
+    stats.counter("instructions.executed", executedInstructions);
+    stats.gauge("run.wall_seconds", runSeconds);
+    stats.counter("run.instructions", timedInstructions);
+    stats.gauge("run.mips", runSeconds > 0 ? timedInstructions / runSeconds / 1e6 : 0.0);
+    stats.counter("memory.footprint_bytes", mem.footprint());
+    if (collectingStats) {
+        instructionStats.registerStats(stats, text);
+    }
+}
+
+void Simulator::writeStats(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out) {
+        throw std::runtime_error("Could not open statistics file: " + filename);
+    }
+    StatsRegistry stats;
+    registerStats(stats);
+    bool csv = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csv") == 0;
+    if (csv) {
+        stats.writeCsv(out);
+    } else {
+        stats.writeJson(out);
+    }
+}
+
+void Simulator::printStats(bool csv) const {
+    StatsRegistry stats;
+    registerStats(stats);
+    if (csv) {
+        stats.writeCsv(std::cout);
+    } else {
+        stats.writeJson(std::cout);
+    }
+}
+
+void Simulator::setStatsFile(const std::string& filename) {
+    statsFile = filename;
+    setStatsCollection(true);
+}
+
+void Simulator::finishStats() const {
+    if (statsFile.empty()) {
+        return;
+    }
+    try {
+        writeStats(statsFile);
+        std::cout << "Statistics written to " << statsFile << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+void Simulator::reportWatchHits(const Instruction& inst, uint64_t instPc) {
+    Memory::WatchHit hit;
+    while (mem.takeWatchHit(hit)) {
+        watchTriggered = true;
+        std::cout << "Watchpoint 0x" << std::hex << hit.watchpoint.start << " hit ("
+                  << (hit.isWrite ? "write" : "read") << " of " << std::dec << hit.size
+                  << " bytes at 0x" << std::hex << hit.address << ") by " << inst.toString()
+                  << " at PC 0x" << std::setw(8) << std::setfill('0') << instPc
+                  << ", line " << std::dec << currentLine << std::endl;
+        if (hit.isWrite) {
+            std::cout << "  old value = 0x" << std::hex << hit.oldValue
+                      << ", new value = 0x" << hit.newValue << std::dec << std::endl;
+        } else {
+            std::cout << "  value = 0x" << std::hex << hit.newValue << std::dec << std::endl;
+        }
+    }
+}
+
 void Simulator::printRegs() {
     for (int i = 0; i < 32; ++i) {
         uint64_t regValue = rf.read(i); // Assuming rf is an instance of RegisterFile
@@ -243,6 +938,24 @@ void Simulator::printRegs() {
     std::cout << std::endl;
 }
 
+void Simulator::printFloatRegs() const {
+    rf.printFloatRegs();
+    std::cout << std::endl;
+}
+
+void Simulator::printVectorRegs() const {
+    rf.printVectorRegs();
+    std::cout << std::endl;
+}
+
+void Simulator::setVectorLength(unsigned bits) {
+    rf.setVectorLength(bits);
+    // Register contents changed behind the recorded history
+    checkpoints.clear();
+    undoLog.reset(executedInstructions);
+    std::cout << "VLEN set to " << std::dec << bits << " bits" << std::endl;
+}
+
 void Simulator::printMem(uint64_t addr, int count) {
     for (int i = 0; i < count; ++i) {
         std::cout << "Memory[0x" << std::hex << std::noshowbase << (addr + i) << "] = 0x"
@@ -280,11 +993,41 @@ void Simulator::showStack() const {
     } else {
         std::cout << "Call stack:" << std::endl;
         for (const auto& frame : callStack) {
-            std::cout << frame.functionName << ":" << std::dec << frame.line << std::endl;
+            std::cout << frameName(frame) << ":" << std::dec << frame.line << std::endl;
         }
     }
 }
 
+void Simulator::setWatchpoint(uint64_t addr, uint64_t length, int type) {
+    try {
+        mem.addWatchpoint(addr, length, type);
+        std::cout << "Watchpoint set at 0x" << std::hex << addr << " (" << std::dec << length << " bytes, "
+                  << (type == Memory::WATCH_READ ? "r" : type == Memory::WATCH_WRITE ? "w" : "rw") << ")" << std::endl;
+    } catch (const std::out_of_range& e) {
+        std::cout << "Invalid watchpoint: " << e.what() << std::endl;
+    }
+}
+
+void Simulator::deleteWatchpoint(uint64_t addr) {
+    if (!mem.removeWatchpoint(addr)) {
+        std::cout << "No watchpoint found at 0x" << std::hex << addr << std::dec << std::endl;
+    }
+}
+
+void Simulator::listWatchpoints() const {
+    const auto& watchpoints = mem.getWatchpoints();
+    if (watchpoints.empty()) {
+        std::cout << "No watchpoints set." << std::endl;
+        return;
+    }
+    std::cout << "Current watchpoints:" << std::endl;
+    for (const auto& entry : watchpoints) {
+        const Memory::Watchpoint& wp = entry.second;
+        std::cout << "0x" << std::hex << wp.start << " len " << std::dec << wp.length << " "
+                  << (wp.type == Memory::WATCH_READ ? "r" : wp.type == Memory::WATCH_WRITE ? "w" : "rw") << std::endl;
+    }
+}
+
 void Simulator::listBreakpoints() const {
     if (breakpoints.empty()) {
         std::cout << "No breakpoints set." << std::endl;
@@ -298,11 +1041,13 @@ void Simulator::listBreakpoints() const {
 
 void Simulator::printTextSection() const {
     std::cout << "Text Section:" << std::endl;
-    for (size_t i = 0; i < machineCode.size(); ++i) {
-        std::cout << "0x" << std::hex << std::setw(8) << std::setfill('0') << (i * 4)
-                  << ": 0x" << std::setw(8) << machineCode[i] << " ";
+    for (size_t i = 0; i < text.size(); ++i) {
+        // Compressed instructions show their parcel and the expansion
+        std::cout << "0x" << std::hex << std::setw(8) << std::setfill('0') << text.address(i)
+                  << ": 0x" << std::setw(text.length(i) * 2) << text.encoding(i)
+                  << std::string(text.length(i) == 2 ? 5 : 1, ' ');
         
-        std::unique_ptr<Instruction> inst = Instruction::decode(machineCode[i]);
+        std::unique_ptr<Instruction> inst = Instruction::decode(text.instruction(i));
         std::cout << inst->toString() << std::endl;
     }
     std::cout << std::dec << std::endl;
@@ -338,11 +1083,48 @@ void Simulator::showHelp() const {
     std::cout << "  run                 - Execute the loaded program." << std::endl;
     std::cout << "  step                - Execute the next instruction." << std::endl;
     std::cout << "  regs                - Display the current register values." << std::endl;
+    std::cout << "  fregs               - Display the floating-point registers and fcsr." << std::endl;
+    std::cout << "  vregs               - Display the vector registers, vl and vtype." << std::endl;
+    std::cout << "  vlen [bits]         - Show or set VLEN; setting it clears the vector registers." << std::endl;
     std::cout << "  mem <addr> <count>  - Display memory contents starting from <addr>." << std::endl;
     std::cout << "  show-stack          - Show the current call stack." << std::endl;
     std::cout << "  break <line>       - Set a breakpoint at the specified line." << std::endl;
     std::cout << "  del break <line>   - Delete a breakpoint at the specified line." << std::endl;
     std::cout << "  list-breaks        - List all current breakpoints." << std::endl;
+    std::cout << "  watch <addr> <len> [r|w|rw] - Stop when memory in the range is accessed (default w)." << std::endl;
+    std::cout << "  del watch <addr>   - Delete the watchpoint starting at <addr>." << std::endl;
+    std::cout << "  list-watches       - List all current watchpoints." << std::endl;
+    std::cout << "  reverse-step        - Undo the last executed instruction." << std::endl;
+    std::cout << "  reverse-continue    - Run backwards to the previous breakpoint or watchpoint hit." << std::endl;
+    std::cout << "  goto <count>        - Move to the state after <count> executed instructions." << std::endl;
+    std::cout << "  reverse on|off      - Enable or disable recording for reverse execution." << std::endl;
+    std::cout << "  reverse-config <log-entries> <interval> <max-checkpoints> - Size the undo log and checkpoints." << std::endl;
+    std::cout << "  reverse-stats       - Show reverse execution memory overhead." << std::endl;
+    std::cout << "  harts <n> [limit]   - Run the program on <n> harts sharing memory, one host thread each." << std::endl;
+    std::cout << "  schedule <harts> <workers> <quantum> [limit] - Run many harts in rounds of <quantum> instructions on <workers> threads; results do not depend on <workers>." << std::endl;
+    std::cout << "  hart-regs <id>      - Display the registers of a hart from the last multi-hart run." << std::endl;
+    std::cout << "  profile on [top-n]  - Count executed instructions; the report is printed at exit." << std::endl;
+    std::cout << "  profile off|reset   - Stop counting, or clear the counts." << std::endl;
+    std::cout << "  profile report [n]  - Show the hottest instructions and opcode and class histograms." << std::endl;
+    std::cout << "  profile listing <file> - Write the program with execution counts per line." << std::endl;
+    std::cout << "  callgraph on|off|reset - Count instructions per function and call edge; the report is printed at exit." << std::endl;
+    std::cout << "  callgraph report    - Show inclusive and exclusive counts per function and call edge." << std::endl;
+    std::cout << "  callgraph write <file> - Write the call graph in callgrind format." << std::endl;
+    std::cout << "  sample on [interval]|off|reset - Sample the call stack about every <interval> instructions." << std::endl;
+    std::cout << "  sample write <file> - Write the sampled stacks as folded text for flame graphs." << std::endl;
+    std::cout << "  plugin load <file.so> [args] - Load an instrumentation plugin." << std::endl;
+    std::cout << "  plugin list         - List loaded plugins and how many instructions they instrument." << std::endl;
+    std::cout << "  stream cache <sets> <ways> <line-bytes> [drop|block] - Model a data cache on another core." << std::endl;
+    std::cout << "  stream mix [drop|block] - Count the instruction mix on another core." << std::endl;
+    std::cout << "  stream stats        - Show events published, consumed and dropped, and lag per consumer." << std::endl;
+    std::cout << "  stream stop         - Drain the stream and print each consumer's report." << std::endl;
+    std::cout << "  stats on|off|reset  - Count the instruction mix, branch outcomes and loads/stores by width." << std::endl;
+    std::cout << "  stats show [json|csv] - Print run statistics (also written at exit with --stats <file>)." << std::endl;
+    std::cout << "  stats write <file>  - Write run statistics, as CSV for a .csv file and JSON otherwise." << std::endl;
+    std::cout << "  perf-stats on|off   - Read host cycles, instructions, branch and LLC misses around each run (also --perf-stats)." << std::endl;
+    std::cout << "  snapshot take|restore|delete <name> - Manage in-memory snapshots (pages shared copy-on-write)." << std::endl;
+    std::cout << "  snapshot list       - List in-memory snapshots." << std::endl;
+    std::cout << "  snapshot save|load <file> - Write or read the full simulator state as a snapshot file." << std::endl;
     std::cout << "  help                - Show this help message." << std::endl;
     std::cout <<"   text                - Show the text section." << std::endl;
     std::cout <<"   data                - Show the data section." << std::endl;
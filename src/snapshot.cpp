@@ -0,0 +1,302 @@
+#include "../include/simulator.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Snapshot file layout:
+//   SnapshotHeader
+//   metadata (program, line numbers, labels, symbols, call stack, vector registers)
+//   padding up to a page boundary
+//   guest memory, one Memory::PAGE_SIZE block per page
+// Guest memory starts page-aligned so loading maps it straight into Memory.
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'R', 'V', 'S', 'N', 'A', 'P', '0', '1'};
+const uint32_t SNAPSHOT_VERSION = 6; // 3: F/D registers and fcsr, 4: V registers, 5: counters, 6: symbols
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t pageCount;
+    uint64_t memoryOffset;
+    uint64_t metadataOffset;
+    uint64_t metadataSize;
+    uint64_t pc;
+    uint64_t executedInstructions;
+    uint64_t regs[RegisterFile::COUNT];
+};
+
+template <typename T>
+void put(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void putString(std::string& out, const std::string& value) {
+    put<uint64_t>(out, value.size());
+    out.append(value);
+}
+
+// Bounds-checked cursor over the mapped metadata block
+struct MetadataReader {
+    const char* cursor;
+    const char* end;
+
+    template <typename T>
+    T get() {
+        if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+            throw std::runtime_error("Truncated snapshot metadata");
+        }
+        T value;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+
+    // Reads an element count, rejecting counts whose elements of at least
+    // minSize bytes each cannot fit in the rest of the metadata
+    uint64_t getCount(size_t minSize) {
+        uint64_t count = get<uint64_t>();
+        if (count > static_cast<uint64_t>(end - cursor) / minSize) {
+            throw std::runtime_error("Truncated snapshot metadata");
+        }
+        return count;
+    }
+
+    std::string getString() {
+        uint64_t length = get<uint64_t>();
+        if (static_cast<uint64_t>(end - cursor) < length) {
+            throw std::runtime_error("Truncated snapshot metadata");
+        }
+        std::string value(cursor, length);
+        cursor += length;
+        return value;
+    }
+};
+
+} // namespace
+
+void Simulator::takeSnapshot(const std::string& name) {
+    snapshots[name] = captureState();
+    std::cout << "Snapshot '" << name << "' taken at instruction " << std::dec << executedInstructions << std::endl;
+}
+
+void Simulator::restoreSnapshot(const std::string& name) {
+    auto it = snapshots.find(name);
+    if (it == snapshots.end()) {
+        std::cout << "No snapshot named '" << name << "'" << std::endl;
+        return;
+    }
+    restoreState(it->second);
+    // The recorded history belongs to a different timeline now
+    checkpoints.clear();
+    undoLog.reset(executedInstructions);
+    std::cout << "Restored snapshot '" << name << "' at instruction " << std::dec << executedInstructions << std::endl;
+}
+
+void Simulator::deleteSnapshot(const std::string& name) {
+    if (snapshots.erase(name) == 0) {
+        std::cout << "No snapshot named '" << name << "'" << std::endl;
+    }
+}
+
+void Simulator::listSnapshots() const {
+    if (snapshots.empty()) {
+        std::cout << "No snapshots taken." << std::endl;
+        return;
+    }
+    std::cout << "Snapshots:" << std::endl;
+    Memory::Image live = mem.saveImage();
+    for (const auto& entry : snapshots) {
+        size_t privatePages = 0;
+        for (size_t i = 0; i < entry.second.memory.size(); ++i) {
+            if (entry.second.memory[i] != live[i] && entry.second.memory[i] != mem.getZeroPage()) {
+                privatePages++;
+            }
+        }
+        std::cout << entry.first << ": instruction " << std::dec << entry.second.executedInstructions
+                  << ", " << privatePages << " pages differ from current memory" << std::endl;
+    }
+}
+
+void Simulator::saveSnapshotFile(const std::string& filename) const {
+    std::string metadata;
+    put<uint64_t>(metadata, text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        put(metadata, text.encoding(i));
+    }
+    for (size_t i = 0; i < text.size(); ++i) {
+        put<int32_t>(metadata, text.line(i));
+    }
+    put<uint64_t>(metadata, labels.size());
+    for (const auto& label : labels) {
+        putString(metadata, label.first);
+        put<uint64_t>(metadata, label.second);
+    }
+    put<uint64_t>(metadata, symbols.size());
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        putString(metadata, symbols.name(static_cast<int>(i)));
+        put<uint64_t>(metadata, symbols.address(static_cast<int>(i)));
+    }
+    put<uint64_t>(metadata, callStack.size());
+    for (const auto& frame : callStack) {
+        put<uint64_t>(metadata, frame.entry);
+        put<uint64_t>(metadata, frame.returnAddress);
+        put<int32_t>(metadata, frame.line);
+    }
+    put<int32_t>(metadata, currentLine);
+    put<uint32_t>(metadata, rf.vlen());
+    metadata.append(reinterpret_cast<const char*>(rf.vector(0)), 32 * rf.vlenBytes());
+
+    Memory::Image image = mem.saveImage();
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.pageSize = Memory::PAGE_SIZE;
+    header.pageCount = image.size();
+    header.metadataOffset = sizeof(SnapshotHeader);
+    header.metadataSize = metadata.size();
+    header.memoryOffset = (header.metadataOffset + header.metadataSize + Memory::PAGE_SIZE - 1) & ~(Memory::PAGE_SIZE - 1);
+    header.pc = pc;
+    header.executedInstructions = executedInstructions;
+    for (int i = 0; i < RegisterFile::COUNT; ++i) {
+        header.regs[i] = rf.read(i);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(metadata.data(), metadata.size());
+    std::string padding(header.memoryOffset - header.metadataOffset - header.metadataSize, '\0');
+    file.write(padding.data(), padding.size());
+    for (const auto& page : image) {
+        file.write(reinterpret_cast<const char*>(page->data()), Memory::PAGE_SIZE);
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write snapshot: " + filename);
+    }
+    std::cout << "Snapshot written to " << filename << std::endl;
+}
+
+void Simulator::loadSnapshotFile(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SnapshotHeader)) {
+        close(fd);
+        throw std::runtime_error("Not a snapshot file: " + filename);
+    }
+    size_t length = info.st_size;
+    // Private writable mapping: guest pages are used in place and the
+    // kernel copies any page the guest later writes to
+    void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Could not map snapshot: " + filename);
+    }
+    std::shared_ptr<char> mapping(static_cast<char*>(base), [length](char* p) { munmap(p, length); });
+
+    SnapshotHeader header;
+    std::memcpy(&header, mapping.get(), sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Not a snapshot file: " + filename);
+    }
+    // The offsets are untrusted, so compare by subtraction where a sum could wrap
+    const uint64_t memoryBytes = Memory::size();
+    if (header.pageSize != Memory::PAGE_SIZE || header.pageCount != memoryBytes / Memory::PAGE_SIZE ||
+        header.memoryOffset % Memory::PAGE_SIZE != 0 ||
+        header.memoryOffset > length || memoryBytes > length - header.memoryOffset ||
+        header.metadataOffset < sizeof(SnapshotHeader) || header.metadataOffset > header.memoryOffset ||
+        header.metadataSize > header.memoryOffset - header.metadataOffset) {
+        throw std::runtime_error("Snapshot does not match this simulator's memory layout: " + filename);
+    }
+
+    MetadataReader reader{mapping.get() + header.metadataOffset,
+                          mapping.get() + header.metadataOffset + header.metadataSize};
+    // Each instruction is stored as a word and a line number
+    std::vector<uint32_t> code(reader.getCount(sizeof(uint32_t) + sizeof(int32_t)));
+    for (auto& word : code) {
+        word = reader.get<uint32_t>();
+    }
+    Program program;
+    for (uint32_t word : code) {
+        program.append(word, reader.get<int32_t>());
+    }
+    std::unordered_map<std::string, uint64_t> labelAddresses;
+    for (uint64_t n = reader.get<uint64_t>(); n > 0; --n) {
+        std::string name = reader.getString();
+        labelAddresses[name] = reader.get<uint64_t>();
+    }
+    SymbolTable textSymbols;
+    for (uint64_t n = reader.get<uint64_t>(); n > 0; --n) {
+        std::string name = reader.getString();
+        textSymbols.add(reader.get<uint64_t>(), name);
+    }
+    textSymbols.index(program);
+    struct SavedFrame {
+        uint64_t entry;
+        uint64_t returnAddress;
+        int line;
+    };
+    std::vector<SavedFrame> frames;
+    for (uint64_t n = reader.get<uint64_t>(); n > 0; --n) {
+        SavedFrame frame;
+        frame.entry = reader.get<uint64_t>();
+        frame.returnAddress = reader.get<uint64_t>();
+        frame.line = reader.get<int32_t>();
+        frames.push_back(frame);
+    }
+    if (frames.empty()) {
+        throw std::runtime_error("Snapshot has no call stack: " + filename);
+    }
+    int line = reader.get<int32_t>();
+    uint32_t vlen = reader.get<uint32_t>();
+    if (vlen < RegisterFile::MIN_VLEN || vlen > RegisterFile::MAX_VLEN || (vlen & (vlen - 1)) != 0 ||
+        static_cast<size_t>(reader.end - reader.cursor) < 32 * vlen / 8) {
+        throw std::runtime_error("Bad vector state in snapshot: " + filename);
+    }
+    const char* vectors = reader.cursor;
+
+    Memory::Image image(header.pageCount);
+    char* pageBase = mapping.get() + header.memoryOffset;
+    for (size_t i = 0; i < image.size(); ++i) {
+        // Aliasing pointers keep the mapping alive while any page uses it
+        image[i] = std::shared_ptr<Memory::Page>(mapping, reinterpret_cast<Memory::Page*>(pageBase + i * Memory::PAGE_SIZE));
+    }
+
+    text = std::move(program);
+    labels.swap(labelAddresses);
+    symbols = std::move(textSymbols);
+    callStack.clear();
+    for (const SavedFrame& frame : frames) {
+        callStack.push_back(makeFrame(frame.entry, frame.returnAddress, frame.line));
+    }
+    currentLine = line;
+    pc = header.pc;
+    executedInstructions = header.executedInstructions;
+    rf.setVectorLength(vlen);
+    for (int i = 0; i < RegisterFile::COUNT; ++i) {
+        rf.restore(i, header.regs[i]);
+    }
+    std::memcpy(rf.writeVector(0, 32), vectors, 32 * rf.vlenBytes());
+    mem.restoreImage(image);
+
+    checkpoints.clear();
+    snapshots.clear();
+    undoLog.reset(executedInstructions);
+    resetProfiles();
+    translatePlugins();
+    std::cout << "Loaded snapshot " << filename << " at instruction " << std::dec << executedInstructions << std::endl;
+}
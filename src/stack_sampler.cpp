@@ -0,0 +1,37 @@
+#include "../include/stack_sampler.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+const uint64_t StackSampler::DEFAULT_INTERVAL;
+
+void StackSampler::reset(uint64_t interval) {
+    stacks.clear();
+    rng.seed(std::minstd_rand::default_seed); // Same samples for the same run
+    meanInterval = std::max<uint64_t>(interval, 1);
+    sampleCount = 0;
+    countdown = nextInterval();
+}
+
+uint64_t StackSampler::nextInterval() {
+    uint64_t half = meanInterval / 2;
+    if (half == 0) {
+        return meanInterval;
+    }
+    std::uniform_int_distribution<uint64_t> spread(0, 2 * half);
+    return meanInterval - half + spread(rng);
+}
+
+void StackSampler::record(const std::string& foldedStack) {
+    ++stacks[foldedStack];
+    ++sampleCount;
+    countdown = nextInterval();
+}
+
+void StackSampler::writeFolded(std::ostream& out) const {
+    std::vector<std::pair<std::string, uint64_t>> lines(stacks.begin(), stacks.end());
+    std::sort(lines.begin(), lines.end());
+    for (const auto& line : lines) {
+        out << line.first << " " << std::dec << line.second << "\n";
+    }
+}
@@ -0,0 +1,106 @@
+#include "../include/stats.h"
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+StatsRegistry::Entry& StatsRegistry::add(const std::string& name, Kind kind) {
+    for (Entry& entry : entries) {
+        if (entry.name == name) {
+            if (entry.kind != kind) {
+                throw std::runtime_error("Statistic registered twice with different types: " + name);
+            }
+            return entry;
+        }
+    }
+    entries.push_back(Entry{name, kind, 0, 0.0, {}});
+    return entries.back();
+}
+
+void StatsRegistry::counter(const std::string& name, uint64_t value) {
+    add(name, COUNTER).count = value;
+}
+
+void StatsRegistry::gauge(const std::string& name, double value) {
+    add(name, GAUGE).measurement = value;
+}
+
+void StatsRegistry::histogram(const std::string& name, const std::string& bucket, uint64_t count) {
+    Entry& entry = add(name, HISTOGRAM);
+    for (auto& existing : entry.buckets) {
+        if (existing.first == bucket) {
+            existing.second += count;
+            return;
+        }
+    }
+    entry.buckets.emplace_back(bucket, count);
+}
+
+void StatsRegistry::writeJson(std::ostream& out) const {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    char fill = out.fill();
+    out << std::dec << std::fixed << std::setprecision(6) << "{";
+    const char* separator = "\n";
+    for (const Entry& entry : entries) {
+        out << separator << "  ";
+        writeJsonString(out, entry.name);
+        out << ": ";
+        if (entry.kind == COUNTER) {
+            out << entry.count;
+        } else if (entry.kind == GAUGE) {
+            out << entry.measurement;
+        } else {
+            out << "{";
+            const char* bucketSeparator = "";
+            for (const auto& bucket : entry.buckets) {
+                out << bucketSeparator;
+                writeJsonString(out, bucket.first);
+                out << ": " << bucket.second;
+                bucketSeparator = ", ";
+            }
+            out << "}";
+        }
+        separator = ",\n";
+    }
+    out << "\n}" << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+    out.fill(fill);
+}
+
+void StatsRegistry::writeCsv(std::ostream& out) const {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::dec << std::fixed << std::setprecision(6) << "name,bucket,value\n";
+    for (const Entry& entry : entries) {
+        if (entry.kind == COUNTER) {
+            out << entry.name << ",," << entry.count << "\n";
+        } else if (entry.kind == GAUGE) {
+            out << entry.name << ",," << entry.measurement << "\n";
+        } else {
+            for (const auto& bucket : entry.buckets) {
+                out << entry.name << "," << bucket.first << "," << bucket.second << "\n";
+            }
+        }
+    }
+    out.flush();
+    out.flags(flags);
+    out.precision(precision);
+}
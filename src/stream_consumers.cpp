@@ -0,0 +1,92 @@
+#include "../include/stream_consumers.h"
+#include "../include/profiler.h"
+#include <iomanip>
+#include <stdexcept>
+
+CacheModel::CacheModel(size_t sets, size_t ways, size_t lineBytes)
+    : sets(sets), ways(ways), lineShift(0) {
+    if (sets == 0 || (sets & (sets - 1)) != 0 || ways == 0 || lineBytes == 0 || (lineBytes & (lineBytes - 1)) != 0) {
+        throw std::runtime_error("Cache sets and line size must be powers of two and ways nonzero");
+    }
+    while ((size_t(1) << lineShift) < lineBytes) {
+        lineShift++;
+    }
+    tags.assign(sets * ways, 0);
+    valid.assign(sets * ways, 0);
+}
+
+void CacheModel::access(uint64_t line, bool isWrite) {
+    size_t base = (line & (sets - 1)) * ways;
+    size_t way = 0;
+    while (way < ways && !(valid[base + way] && tags[base + way] == line)) {
+        way++;
+    }
+    if (way < ways) {
+        hits[isWrite]++;
+    } else {
+        misses[isWrite]++;
+        way = ways - 1; // Evict the least recently used
+    }
+    // Move to the front
+    for (size_t w = way; w > 0; --w) {
+        tags[base + w] = tags[base + w - 1];
+        valid[base + w] = valid[base + w - 1];
+    }
+    tags[base] = line;
+    valid[base] = 1;
+}
+
+void CacheModel::consume(const StreamEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const StreamEvent& e = events[i];
+        if (e.size == 0) {
+            continue;
+        }
+        bool isWrite = e.flags & StreamEvent::FLAG_STORE;
+        uint64_t first = e.address >> lineShift;
+        uint64_t last = (e.address + e.size - 1) >> lineShift;
+        for (uint64_t line = first; line <= last; ++line) {
+            access(line, isWrite);
+        }
+    }
+}
+
+void CacheModel::report(std::ostream& out) const {
+    uint64_t total = hits[0] + hits[1] + misses[0] + misses[1];
+    out << std::dec << "cache: " << sets << " sets x " << ways << " ways x " << (size_t(1) << lineShift)
+        << " bytes" << std::endl;
+    out << "  reads:  " << hits[0] << " hits, " << misses[0] << " misses" << std::endl;
+    out << "  writes: " << hits[1] << " hits, " << misses[1] << " misses" << std::endl;
+    if (total > 0) {
+        out << "  miss rate: " << std::fixed << std::setprecision(2)
+            << 100.0 * static_cast<double>(misses[0] + misses[1]) / static_cast<double>(total) << "%"
+            << std::defaultfloat << std::endl;
+    }
+}
+
+void InstructionMix::consume(const StreamEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const StreamEvent& e = events[i];
+        if (!(e.flags & StreamEvent::FLAG_RETIRED)) {
+            continue;
+        }
+        retired++;
+        classes[Profiler::instructionClass(e.instruction)]++;
+        if (e.flags & StreamEvent::FLAG_BRANCH) {
+            branches++;
+            taken += (e.flags & StreamEvent::FLAG_TAKEN) != 0;
+        }
+    }
+}
+
+void InstructionMix::report(std::ostream& out) const {
+    out << std::dec << "mix: " << retired << " instructions, " << branches << " branches, " << taken << " taken"
+        << std::endl;
+    std::map<std::string, uint64_t> byName(classes.begin(), classes.end());
+    char fill = out.fill(' ');
+    for (const auto& entry : byName) {
+        out << "  " << std::left << std::setw(10) << entry.first << std::right << std::setw(14) << entry.second
+            << std::endl;
+    }
+    out.fill(fill);
+}
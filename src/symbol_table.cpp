@@ -0,0 +1,78 @@
+#include "../include/symbol_table.h"
+#include <algorithm>
+#include <sstream>
+
+const int SymbolTable::NONE;
+
+void SymbolTable::clear() {
+    symbols.clear();
+    starting.clear();
+    containingAt.clear();
+}
+
+void SymbolTable::add(uint64_t address, const std::string& name) {
+    symbols.push_back({address, name, false});
+}
+
+void SymbolTable::index(const Program& program) {
+    // Stable, so the first label given to an address stays first
+    std::stable_sort(symbols.begin(), symbols.end(), [](const Symbol& a, const Symbol& b) {
+        return a.address < b.address;
+    });
+    symbols.erase(std::unique(symbols.begin(), symbols.end(), [](const Symbol& a, const Symbol& b) {
+        return a.address == b.address;
+    }), symbols.end());
+
+    starting.assign(program.size(), NONE);
+    containingAt.assign(program.size(), NONE);
+    int current = NONE;
+    size_t next = 0;
+    for (size_t i = 0; i < program.size(); ++i) {
+        while (next < symbols.size() && symbols[next].address <= program.address(i)) {
+            current = static_cast<int>(next);
+            if (symbols[next].address == program.address(i)) {
+                starting[i] = current;
+            }
+            ++next;
+        }
+        containingAt[i] = current;
+    }
+
+    for (size_t i = 0; i < program.size(); ++i) {
+        uint32_t inst = program.instruction(i);
+        uint32_t rd = (inst >> 7) & 0x1F;
+        if ((inst & 0x7F) == 0x6F && (rd == 1 || rd == 5)) {
+            int32_t offset = static_cast<int32_t>((inst & 0x80000000) | (inst & 0x000FF000) << 11 |
+                                                  (inst & 0x00100000) << 2 | (inst & 0x7FE00000) >> 9) >> 11;
+            int id = at(program.address(i) + offset);
+            if (id != NONE) {
+                symbols[id].function = true;
+            }
+        }
+    }
+}
+
+int SymbolTable::at(uint64_t address) const {
+    int id = containing(address);
+    return id != NONE && symbols[id].address == address ? id : NONE;
+}
+
+int SymbolTable::containing(uint64_t address) const {
+    auto it = std::upper_bound(symbols.begin(), symbols.end(), address, [](uint64_t a, const Symbol& s) {
+        return a < s.address;
+    });
+    if (it == symbols.begin()) {
+        return NONE;
+    }
+    return static_cast<int>(it - symbols.begin()) - 1;
+}
+
+std::string SymbolTable::nameAt(uint64_t address) const {
+    int id = at(address);
+    if (id != NONE) {
+        return symbols[id].name;
+    }
+    std::stringstream ss;
+    ss << "0x" << std::hex << address;
+    return ss.str();
+}
@@ -0,0 +1,91 @@
+#include "../include/thread_pool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(size_t threads) : queued(0), pending(0), nextQueue(0), stopping(false) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        queues.emplace_back(new Queue());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    size_t index;
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        index = nextQueue++ % queues.size();
+        pending++;
+        // Counted under stateLock so a worker about to sleep cannot miss it;
+        // a worker that wakes before the push below just retries
+        queued++;
+    }
+    {
+        std::lock_guard<std::mutex> guard(queues[index]->lock);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> guard(stateLock);
+    idle.wait(guard, [this] { return pending == 0; });
+}
+
+bool WorkStealingPool::popTask(size_t index, std::function<void()>& task) {
+    {
+        Queue& own = *queues[index];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); ++i) {
+        Queue& victim = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    while (true) {
+        std::function<void()> task;
+        if (popTask(index, task)) {
+            task();
+            std::lock_guard<std::mutex> guard(stateLock);
+            if (--pending == 0) {
+                idle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(stateLock);
+        wake.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#include "../include/undo_log.h"
+
+UndoLog::UndoLog(size_t capacity) : limit(capacity), head(0), count(0), current(0), firstComplete(0) {}
+
+void UndoLog::setCapacity(size_t capacity) {
+    std::vector<Entry>().swap(entries);
+    limit = capacity;
+    reset(current);
+}
+
+void UndoLog::reset(uint64_t instruction) {
+    head = 0;
+    count = 0;
+    current = instruction;
+    firstComplete = instruction;
+}
+
+UndoLog::Entry& UndoLog::push() {
+    if (head == entries.size()) {
+        entries.emplace_back();
+    }
+    Entry& slot = entries[head];
+    if (count == limit) {
+        // Overwriting the oldest entry leaves its instruction only partially undoable
+        firstComplete = slot.instruction + 1;
+    } else {
+        count++;
+    }
+    head = (head + 1) % limit;
+    slot.instruction = current;
+    return slot;
+}
+
+void UndoLog::recordRegister(int reg, uint64_t oldValue) {
+    if (limit == 0) return;
+    Entry& e = push();
+    e.kind = REGISTER;
+    e.location = reg;
+    e.oldValue = oldValue;
+}
+
+void UndoLog::recordMemory(uint64_t address, int size, uint64_t oldValue) {
+    if (limit == 0) return;
+    Entry& e = push();
+    e.kind = MEMORY;
+    e.location = address;
+    e.size = size;
+    e.oldValue = oldValue;
+}
+
+void UndoLog::recordStep(uint64_t previousPc, int callerLine) {
+    if (limit == 0) return;
+    Entry& e = push();
+    e.kind = STEP;
+    e.location = previousPc;
+    e.oldValue = static_cast<uint64_t>(callerLine);
+}
+
+void UndoLog::recordFramePush() {
+    if (limit == 0) return;
+    Entry& e = push();
+    e.kind = FRAME_PUSH;
+}
+
+void UndoLog::recordFramePop(uint64_t entry, uint64_t returnAddress, int line) {
+    if (limit == 0) return;
+    Entry& e = push();
+    e.kind = FRAME_POP;
+    e.location = entry;
+    e.oldValue = returnAddress;
+    e.line = line;
+}
+
+void UndoLog::popBack() {
+    if (count == 0) return;
+    head = (head + limit - 1) % limit;
+    count--;
+}
+
+size_t UndoLog::memoryUsage() const {
+    return entries.capacity() * sizeof(Entry);
+}
@@ -0,0 +1,482 @@
+#include "../include/vector_instruction.h"
+#include "../include/vector_kernels.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Forms an arithmetic encoding may take
+const int ALLOW_VV = 1;
+const int ALLOW_VX = 2;
+const int ALLOW_VI = 4;
+const int ALLOW_ALL = ALLOW_VV | ALLOW_VX | ALLOW_VI;
+
+int log2Of(int value) {
+    return __builtin_ctz(value);
+}
+
+// Elements in a register group for vtype, or 0 if vtype is illegal
+size_t vlmaxOf(uint64_t vtype, unsigned vlenb) {
+    unsigned vsew = (vtype >> 3) & 0x7;
+    unsigned vlmul = vtype & 0x7;
+    if ((vtype >> 8) != 0 || vsew > 3 || vlmul == 4) {
+        return 0;
+    }
+    int sewLog2 = vsew + 3;
+    int lmulLog2 = vlmul < 4 ? static_cast<int>(vlmul) : static_cast<int>(vlmul) - 8;
+    // Fractional LMUL must still hold one element of ELEN = 64
+    if (lmulLog2 < 0 && sewLog2 > 6 + lmulLog2) {
+        return 0;
+    }
+    int log2 = log2Of(vlenb * 8) + lmulLog2 - sewLog2;
+    return log2 < 0 ? 0 : size_t(1) << log2;
+}
+
+std::string vtypeName(uint64_t vtype) {
+    std::ostringstream oss;
+    unsigned vlmul = vtype & 0x7;
+    oss << "e" << (8 << ((vtype >> 3) & 0x7)) << ", ";
+    if (vlmul < 4) {
+        oss << "m" << (1 << vlmul);
+    } else {
+        oss << "mf" << (1 << (8 - vlmul));
+    }
+    oss << ((vtype & 0x40) ? ", ta" : ", tu") << ((vtype & 0x80) ? ", ma" : ", mu");
+    return oss.str();
+}
+
+bool maskBit(const uint8_t* mask, size_t i) {
+    return (mask[i / 8] >> (i % 8)) & 1;
+}
+
+uint64_t readElement(const Memory& mem, uint64_t address, int width) {
+    switch (width) {
+        case 1: return mem.read8(address);
+        case 2: return mem.read16(address);
+        case 4: return mem.read32(address);
+        default: return mem.read64(address);
+    }
+}
+
+void writeElement(Memory& mem, uint64_t address, int width, uint64_t value) {
+    switch (width) {
+        case 1: mem.write8(address, static_cast<uint32_t>(value)); break;
+        case 2: mem.write16(address, static_cast<uint32_t>(value)); break;
+        case 4: mem.write32(address, static_cast<uint32_t>(value)); break;
+        default: mem.write64(address, value); break;
+    }
+}
+
+} // namespace
+
+std::unique_ptr<Instruction> VectorInstruction::decode(uint32_t machineCode) {
+    uint32_t opcode = machineCode & 0x7F;
+    uint32_t funct3 = (machineCode >> 12) & 0x7;
+    uint32_t funct6 = machineCode >> 26;
+    uint32_t vs1 = (machineCode >> 15) & 0x1F;
+    uint32_t vs2 = (machineCode >> 20) & 0x1F;
+    bool unmasked = (machineCode >> 25) & 0x1;
+
+    if (opcode == 0x07 || opcode == 0x27) { // LOAD-FP, STORE-FP
+        int width = funct3 == 0x0 ? 1 : funct3 == 0x5 ? 2 : funct3 == 0x6 ? 4 : funct3 == 0x7 ? 8 : 0;
+        uint32_t mop = (machineCode >> 26) & 0x3;
+        bool mew = (machineCode >> 28) & 0x1;
+        uint32_t nf = machineCode >> 29;
+        if (width == 0 || mew || nf != 0) {
+            return nullptr; // No segment or 128-bit element accesses
+        }
+        bool isStore = opcode == 0x27;
+        if (mop == 0x0 && vs2 == 0x00) return std::make_unique<VectorLoadStore>(machineCode, isStore, VectorLoadStore::UNIT, width);
+        if (mop == 0x0 && vs2 == 0x0B && width == 1 && unmasked) {
+            return std::make_unique<VectorLoadStore>(machineCode, isStore, VectorLoadStore::MASK, width);
+        }
+        if (mop == 0x2) return std::make_unique<VectorLoadStore>(machineCode, isStore, VectorLoadStore::STRIDED, width);
+        return nullptr;
+    }
+    if (opcode != 0x57) {
+        return nullptr;
+    }
+
+    if (funct3 == 0x7) {
+        if ((machineCode >> 31) == 0) return std::make_unique<VectorConfig>(machineCode, VectorConfig::VSETVLI);
+        if ((machineCode >> 30) == 0x3) return std::make_unique<VectorConfig>(machineCode, VectorConfig::VSETIVLI);
+        if ((machineCode >> 25) == 0x40) return std::make_unique<VectorConfig>(machineCode, VectorConfig::VSETVL);
+        return nullptr;
+    }
+
+    VectorArith::Form form;
+    switch (funct3) {
+        case 0x0: case 0x2: form = VectorArith::VV; break; // OPIVV, OPMVV
+        case 0x3: form = VectorArith::VI; break;           // OPIVI
+        case 0x4: case 0x6: form = VectorArith::VX; break; // OPIVX, OPMVX
+        default: return nullptr;                           // Floating point
+    }
+    int allowed = form == VectorArith::VV ? ALLOW_VV : form == VectorArith::VX ? ALLOW_VX : ALLOW_VI;
+    auto make = [&](VectorArith::Kind kind, int op, const char* name, int forms) -> std::unique_ptr<Instruction> {
+        if (!(forms & allowed)) {
+            return nullptr;
+        }
+        return std::make_unique<VectorArith>(machineCode, kind, op, form, name);
+    };
+
+    if (funct3 == 0x2 || funct3 == 0x6) { // OPM
+        switch (funct6) {
+            case 0x00: return make(VectorArith::REDUCTION, VOP_ADD, "vredsum", ALLOW_VV);
+            case 0x01: return make(VectorArith::REDUCTION, VOP_AND, "vredand", ALLOW_VV);
+            case 0x02: return make(VectorArith::REDUCTION, VOP_OR, "vredor", ALLOW_VV);
+            case 0x03: return make(VectorArith::REDUCTION, VOP_XOR, "vredxor", ALLOW_VV);
+            case 0x04: return make(VectorArith::REDUCTION, VOP_MINU, "vredminu", ALLOW_VV);
+            case 0x05: return make(VectorArith::REDUCTION, VOP_MIN, "vredmin", ALLOW_VV);
+            case 0x06: return make(VectorArith::REDUCTION, VOP_MAXU, "vredmaxu", ALLOW_VV);
+            case 0x07: return make(VectorArith::REDUCTION, VOP_MAX, "vredmax", ALLOW_VV);
+            case 0x10:
+                if (form == VectorArith::VX) {
+                    return vs2 == 0 && unmasked ? make(VectorArith::MV_S_X, VOP_MV, "vmv.s.x", ALLOW_VX) : nullptr;
+                }
+                if (vs1 == 0x00 && unmasked) return make(VectorArith::MV_X_S, VOP_MV, "vmv.x.s", ALLOW_VV);
+                if (vs1 == 0x10) return make(VectorArith::CPOP, VOP_MV, "vcpop.m", ALLOW_VV);
+                if (vs1 == 0x11) return make(VectorArith::FIRST, VOP_MV, "vfirst.m", ALLOW_VV);
+                return nullptr;
+            case 0x14:
+                return vs1 == 0x11 && vs2 == 0 ? make(VectorArith::VID, VOP_MV, "vid.v", ALLOW_VV) : nullptr;
+            case 0x25: return make(VectorArith::ELEMENTWISE, VOP_MUL, "vmul", ALLOW_VV | ALLOW_VX);
+            case 0x2D: return make(VectorArith::ELEMENTWISE, VOP_MACC, "vmacc", ALLOW_VV | ALLOW_VX);
+        }
+        return nullptr;
+    }
+
+    switch (funct6) { // OPI
+        case 0x00: return make(VectorArith::ELEMENTWISE, VOP_ADD, "vadd", ALLOW_ALL);
+        case 0x02: return make(VectorArith::ELEMENTWISE, VOP_SUB, "vsub", ALLOW_VV | ALLOW_VX);
+        case 0x03: return make(VectorArith::ELEMENTWISE, VOP_RSUB, "vrsub", ALLOW_VX | ALLOW_VI);
+        case 0x04: return make(VectorArith::ELEMENTWISE, VOP_MINU, "vminu", ALLOW_VV | ALLOW_VX);
+        case 0x05: return make(VectorArith::ELEMENTWISE, VOP_MIN, "vmin", ALLOW_VV | ALLOW_VX);
+        case 0x06: return make(VectorArith::ELEMENTWISE, VOP_MAXU, "vmaxu", ALLOW_VV | ALLOW_VX);
+        case 0x07: return make(VectorArith::ELEMENTWISE, VOP_MAX, "vmax", ALLOW_VV | ALLOW_VX);
+        case 0x09: return make(VectorArith::ELEMENTWISE, VOP_AND, "vand", ALLOW_ALL);
+        case 0x0A: return make(VectorArith::ELEMENTWISE, VOP_OR, "vor", ALLOW_ALL);
+        case 0x0B: return make(VectorArith::ELEMENTWISE, VOP_XOR, "vxor", ALLOW_ALL);
+        case 0x17:
+            if (!unmasked) return make(VectorArith::ELEMENTWISE, VOP_MERGE, "vmerge", ALLOW_ALL);
+            return vs2 == 0 ? make(VectorArith::ELEMENTWISE, VOP_MV, "vmv", ALLOW_ALL) : nullptr;
+        case 0x18: return make(VectorArith::COMPARE, VOP_SEQ, "vmseq", ALLOW_ALL);
+        case 0x19: return make(VectorArith::COMPARE, VOP_SNE, "vmsne", ALLOW_ALL);
+        case 0x1A: return make(VectorArith::COMPARE, VOP_SLTU, "vmsltu", ALLOW_VV | ALLOW_VX);
+        case 0x1B: return make(VectorArith::COMPARE, VOP_SLT, "vmslt", ALLOW_VV | ALLOW_VX);
+        case 0x1C: return make(VectorArith::COMPARE, VOP_SLEU, "vmsleu", ALLOW_ALL);
+        case 0x1D: return make(VectorArith::COMPARE, VOP_SLE, "vmsle", ALLOW_ALL);
+        case 0x1E: return make(VectorArith::COMPARE, VOP_SGTU, "vmsgtu", ALLOW_VX | ALLOW_VI);
+        case 0x1F: return make(VectorArith::COMPARE, VOP_SGT, "vmsgt", ALLOW_VX | ALLOW_VI);
+        case 0x25: return make(VectorArith::ELEMENTWISE, VOP_SLL, "vsll", ALLOW_ALL);
+        case 0x27:
+            if (unmasked && (vs1 == 0 || vs1 == 1 || vs1 == 3 || vs1 == 7)) {
+                return make(VectorArith::MV_WHOLE, VOP_MV, "vmv", ALLOW_VI);
+            }
+            return nullptr;
+        case 0x28: return make(VectorArith::ELEMENTWISE, VOP_SRL, "vsrl", ALLOW_ALL);
+        case 0x29: return make(VectorArith::ELEMENTWISE, VOP_SRA, "vsra", ALLOW_ALL);
+    }
+    return nullptr;
+}
+
+VectorInstruction::VectorInstruction(uint32_t machineCode) : Instruction(machineCode) {
+    vd = (machineCode >> 7) & 0x1F;
+    vs1 = (machineCode >> 15) & 0x1F;
+    vs2 = (machineCode >> 20) & 0x1F;
+    masked = ((machineCode >> 25) & 0x1) == 0;
+}
+
+VectorInstruction::Config VectorInstruction::config(const RegisterFile& rf) const {
+    uint64_t vtype = rf.read(RegisterFile::VTYPE);
+    if (vtype & RegisterFile::VTYPE_VILL) {
+        throw std::runtime_error("Vector instruction with illegal vtype");
+    }
+    // Instructions never stop partway, so only a csrw can leave vstart set
+    if (rf.read(RegisterFile::VSTART) != 0) {
+        throw std::runtime_error("Vector instruction with nonzero vstart");
+    }
+    Config c;
+    c.sew = 1 << ((vtype >> 3) & 0x7);
+    unsigned vlmul = vtype & 0x7;
+    c.lmulLog2 = vlmul < 4 ? static_cast<int>(vlmul) : static_cast<int>(vlmul) - 8;
+    c.vl = rf.read(RegisterFile::VL);
+    c.group = c.lmulLog2 > 0 ? 1 << c.lmulLog2 : 1;
+    return c;
+}
+
+void VectorInstruction::checkGroup(int v, int group) const {
+    if (v % group != 0) {
+        throw std::runtime_error("Vector register v" + std::to_string(v) + " does not start a group of " +
+                                 std::to_string(group));
+    }
+}
+
+// vsetvli, vsetivli and vsetvl
+VectorConfig::VectorConfig(uint32_t machineCode, Form form) : VectorInstruction(machineCode), form(form) {
+    vtypeImm = (machineCode >> 20) & (form == VSETIVLI ? 0x3FF : 0x7FF);
+}
+
+void VectorConfig::execute(RegisterFile& rf, Memory& /* mem */) {
+    uint64_t vtype = form == VSETVL ? rf.read(vs2) : vtypeImm;
+    uint64_t avl;
+    if (form == VSETIVLI) {
+        avl = vs1;
+    } else if (vs1 != 0) {
+        avl = rf.read(vs1);
+    } else {
+        avl = vd != 0 ? UINT64_MAX : rf.read(RegisterFile::VL); // vl = VLMAX, or keep vl
+    }
+    size_t vlmax = vlmaxOf(vtype, rf.vlenBytes());
+    uint64_t vl = 0;
+    if (vlmax == 0) {
+        vtype = RegisterFile::VTYPE_VILL;
+    } else {
+        vl = std::min<uint64_t>(avl, vlmax);
+    }
+    rf.write(RegisterFile::VTYPE, vtype);
+    rf.write(RegisterFile::VL, vl);
+    rf.write(vd, vl);
+    if (rf.read(RegisterFile::VSTART) != 0) { // Like every vector instruction, resets vstart
+        rf.write(RegisterFile::VSTART, 0);
+    }
+}
+
+std::string VectorConfig::toString() const {
+    std::ostringstream oss;
+    switch (form) {
+        case VSETVLI: oss << "vsetvli x" << vd << ", x" << vs1 << ", " << vtypeName(vtypeImm); break;
+        case VSETIVLI: oss << "vsetivli x" << vd << ", " << vs1 << ", " << vtypeName(vtypeImm); break;
+        case VSETVL: oss << "vsetvl x" << vd << ", x" << vs1 << ", x" << vs2; break;
+    }
+    return oss.str();
+}
+
+// Vector loads and stores
+VectorLoadStore::VectorLoadStore(uint32_t machineCode, bool isStore, Mode mode, int width)
+    : VectorInstruction(machineCode), isStore(isStore), mode(mode), width(width) {}
+
+void VectorLoadStore::execute(RegisterFile& rf, Memory& mem) {
+    Config c = config(rf);
+    uint64_t base = rf.read(vs1);
+    if (c.vl == 0) {
+        return;
+    }
+    if (mode == MASK) {
+        size_t bytes = (c.vl + 7) / 8;
+        if (isStore) {
+            mem.writeBlock(base, rf.vector(vd), bytes, 1);
+        } else {
+            mem.readBlock(base, rf.writeVector(vd, 1), bytes, 1);
+        }
+        return;
+    }
+
+    // Elements are width bytes wide, so the group size scales by EEW / SEW
+    int emulLog2 = c.lmulLog2 + log2Of(width) - log2Of(c.sew);
+    if (emulLog2 < -3 || emulLog2 > 3) {
+        throw std::runtime_error("Vector element width " + std::to_string(width * 8) + " is illegal with the current vtype");
+    }
+    int group = emulLog2 > 0 ? 1 << emulLog2 : 1;
+    checkGroup(vd, group);
+    const uint8_t* mask = maskOperand(rf);
+
+    if (mode == UNIT && !mask) {
+        if (isStore) {
+            mem.writeBlock(base, rf.vector(vd), c.vl, width);
+        } else {
+            mem.readBlock(base, rf.writeVector(vd, group), c.vl, width);
+        }
+        return;
+    }
+    int64_t stride = mode == STRIDED ? static_cast<int64_t>(rf.read(vs2)) : width;
+    uint8_t* d = isStore ? nullptr : rf.writeVector(vd, group);
+    const uint8_t* s = rf.vector(vd);
+    for (size_t i = 0; i < c.vl; ++i) {
+        if (mask && !maskBit(mask, i)) {
+            continue;
+        }
+        uint64_t address = base + static_cast<uint64_t>(stride * static_cast<int64_t>(i));
+        uint64_t value = 0;
+        if (isStore) {
+            std::memcpy(&value, s + i * width, width);
+            writeElement(mem, address, width, value);
+        } else {
+            value = readElement(mem, address, width);
+            std::memcpy(d + i * width, &value, width);
+        }
+    }
+}
+
+std::string VectorLoadStore::toString() const {
+    std::ostringstream oss;
+    oss << (isStore ? "vs" : "vl");
+    if (mode == MASK) {
+        oss << "m.v";
+    } else {
+        oss << (mode == STRIDED ? "se" : "e") << width * 8 << ".v";
+    }
+    oss << " v" << vd << ", (x" << vs1 << ")";
+    if (mode == STRIDED) {
+        oss << ", x" << vs2;
+    }
+    oss << maskSuffix();
+    return oss.str();
+}
+
+// Vector integer arithmetic
+VectorArith::VectorArith(uint32_t machineCode, Kind kind, int op, Form form, const char* name)
+    : VectorInstruction(machineCode), kind(kind), op(op), form(form), name(name) {}
+
+uint64_t VectorArith::scalarOperand(const RegisterFile& rf) const {
+    switch (form) {
+        case VX: return rf.read(vs1);
+        case VI:
+            if (op == VOP_SLL || op == VOP_SRL || op == VOP_SRA) {
+                return vs1; // uimm5
+            }
+            return static_cast<uint64_t>(signExtend(vs1, 5));
+        default: return 0;
+    }
+}
+
+void VectorArith::execute(RegisterFile& rf, Memory& /* mem */) {
+    if (kind == MV_WHOLE) {
+        // Whole registers, independent of vtype
+        int count = vs1 + 1;
+        checkGroup(vd, count);
+        checkGroup(vs2, count);
+        uint8_t* d = rf.writeVector(vd, count);
+        std::memmove(d, rf.vector(vs2), count * rf.vlenBytes());
+        return;
+    }
+
+    Config c = config(rf);
+    const uint8_t* mask = maskOperand(rf);
+    switch (kind) {
+        case ELEMENTWISE: {
+            checkGroup(vd, c.group);
+            checkGroup(vs2, c.group);
+            if (form == VV) {
+                checkGroup(vs1, c.group);
+            }
+            if (masked && vd == 0 && op != VOP_MERGE) {
+                throw std::runtime_error("Masked vector instruction cannot write v0");
+            }
+            if (c.vl == 0) {
+                return;
+            }
+            uint8_t* d = rf.writeVector(vd, c.group);
+            vectorArith(op, c.sew, d, rf.vector(vs2), form == VV ? rf.vector(vs1) : nullptr, scalarOperand(rf), c.vl,
+                        mask);
+            break;
+        }
+        case COMPARE: {
+            checkGroup(vs2, c.group);
+            if (form == VV) {
+                checkGroup(vs1, c.group);
+            }
+            if (c.vl == 0) {
+                return;
+            }
+            uint8_t* d = rf.writeVector(vd, 1);
+            vectorCompare(op, c.sew, d, rf.vector(vs2), form == VV ? rf.vector(vs1) : nullptr, scalarOperand(rf),
+                          c.vl, mask);
+            break;
+        }
+        case REDUCTION: {
+            checkGroup(vs2, c.group);
+            if (c.vl == 0) {
+                return;
+            }
+            uint64_t init = 0;
+            std::memcpy(&init, rf.vector(vs1), c.sew);
+            uint64_t result = vectorReduce(op, c.sew, rf.vector(vs2), init, c.vl, mask);
+            std::memcpy(rf.writeVector(vd, 1), &result, c.sew);
+            break;
+        }
+        case MV_X_S: {
+            uint64_t value = 0;
+            std::memcpy(&value, rf.vector(vs2), c.sew);
+            rf.write(vd, c.sew == 8 ? value : static_cast<uint64_t>(signExtend(value, c.sew * 8)));
+            break;
+        }
+        case MV_S_X:
+            if (c.vl > 0) {
+                uint64_t value = rf.read(vs1);
+                std::memcpy(rf.writeVector(vd, 1), &value, c.sew);
+            }
+            break;
+        case VID: {
+            checkGroup(vd, c.group);
+            if (c.vl == 0) {
+                return;
+            }
+            uint8_t* d = rf.writeVector(vd, c.group);
+            for (size_t i = 0; i < c.vl; ++i) {
+                if (!mask || maskBit(mask, i)) {
+                    uint64_t index = i;
+                    std::memcpy(d + i * c.sew, &index, c.sew);
+                }
+            }
+            break;
+        }
+        case CPOP:
+        case FIRST: {
+            const uint8_t* source = rf.vector(vs2);
+            uint64_t count = 0;
+            int64_t first = -1;
+            for (size_t i = 0; i < c.vl; i += 64) {
+                uint64_t word = 0;
+                std::memcpy(&word, source + i / 8, std::min<size_t>(8, (c.vl - i + 7) / 8));
+                if (mask) {
+                    uint64_t active = 0;
+                    std::memcpy(&active, mask + i / 8, std::min<size_t>(8, (c.vl - i + 7) / 8));
+                    word &= active;
+                }
+                if (c.vl - i < 64) {
+                    word &= (1ULL << (c.vl - i)) - 1;
+                }
+                if (first < 0 && word != 0) {
+                    first = static_cast<int64_t>(i) + __builtin_ctzll(word);
+                }
+                count += __builtin_popcountll(word);
+            }
+            rf.write(vd, kind == CPOP ? count : static_cast<uint64_t>(first));
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+std::string VectorArith::toString() const {
+    static const char* const SUFFIXES[] = {".vv", ".vx", ".vi"};
+    std::ostringstream oss;
+    std::string scalar = form == VX ? "x" + std::to_string(vs1)
+                                    : std::to_string(op == VOP_SLL || op == VOP_SRL || op == VOP_SRA ? vs1 : signExtend(vs1, 5));
+    std::string source = form == VV ? "v" + std::to_string(vs1) : scalar;
+    switch (kind) {
+        case ELEMENTWISE:
+            if (op == VOP_MV) {
+                oss << "vmv.v" << SUFFIXES[form][2] << " v" << vd << ", " << source;
+            } else if (op == VOP_MERGE) {
+                oss << "vmerge" << SUFFIXES[form] << "m v" << vd << ", v" << vs2 << ", " << source << ", v0";
+            } else if (op == VOP_MACC) {
+                oss << name << SUFFIXES[form] << " v" << vd << ", " << source << ", v" << vs2 << maskSuffix();
+            } else {
+                oss << name << SUFFIXES[form] << " v" << vd << ", v" << vs2 << ", " << source << maskSuffix();
+            }
+            break;
+        case COMPARE: oss << name << SUFFIXES[form] << " v" << vd << ", v" << vs2 << ", " << source << maskSuffix(); break;
+        case REDUCTION: oss << name << ".vs v" << vd << ", v" << vs2 << ", v" << vs1 << maskSuffix(); break;
+        case MV_X_S: oss << name << " x" << vd << ", v" << vs2; break;
+        case MV_S_X: oss << name << " v" << vd << ", x" << vs1; break;
+        case VID: oss << name << " v" << vd << maskSuffix(); break;
+        case CPOP:
+        case FIRST: oss << name << " x" << vd << ", v" << vs2 << maskSuffix(); break;
+        case MV_WHOLE: oss << "vmv" << vs1 + 1 << "r.v v" << vd << ", v" << vs2; break;
+    }
+    return oss.str();
+}
@@ -0,0 +1,483 @@
+#include "../include/vector_kernels.h"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+uint64_t elementMask(int sew) {
+    return sew == 8 ? ~0ULL : (1ULL << (sew * 8)) - 1;
+}
+
+int64_t sextElement(uint64_t value, int sew) {
+    int shift = 64 - sew * 8;
+    return static_cast<int64_t>(value << shift) >> shift;
+}
+
+uint64_t loadElement(const uint8_t* v, size_t i, int sew) {
+    uint64_t value = 0;
+    std::memcpy(&value, v + i * sew, sew);
+    return value;
+}
+
+void storeElement(uint8_t* v, size_t i, int sew, uint64_t value) {
+    std::memcpy(v + i * sew, &value, sew);
+}
+
+bool maskBit(const uint8_t* mask, size_t i) {
+    return (mask[i / 8] >> (i % 8)) & 1;
+}
+
+// count bits of a mask register from bit first; count is 4, 8, 16 or 32
+// and first a multiple of count
+uint32_t maskBits(const uint8_t* mask, size_t first, unsigned count) {
+    if (count == 4) {
+        return (mask[first / 8] >> (first % 8)) & 0xF;
+    }
+    uint32_t bits = 0;
+    std::memcpy(&bits, mask + first / 8, count / 8);
+    return bits;
+}
+
+// Replaces the active bits among count mask bits from bit first
+void writeMaskBits(uint8_t* d, size_t first, unsigned count, uint32_t bits, uint32_t active) {
+    size_t byte = first / 8;
+    unsigned shift = first % 8;
+    unsigned bytes = (count + shift + 7) / 8;
+    uint64_t word = 0;
+    std::memcpy(&word, d + byte, bytes);
+    uint64_t m = static_cast<uint64_t>(active) << shift;
+    word = (word & ~m) | ((static_cast<uint64_t>(bits) << shift) & m);
+    std::memcpy(d + byte, &word, bytes);
+}
+
+// Low count bits set
+uint32_t lowBits(size_t count) {
+    return count >= 32 ? 0xFFFFFFFF : (1u << count) - 1;
+}
+
+uint64_t applyElement(int op, int sew, uint64_t x, uint64_t y, uint64_t old) {
+    unsigned shift = y & (sew * 8 - 1);
+    int64_t sx = sextElement(x, sew);
+    int64_t sy = sextElement(y, sew);
+    switch (op) {
+        case VOP_ADD: return x + y;
+        case VOP_SUB: return x - y;
+        case VOP_RSUB: return y - x;
+        case VOP_AND: return x & y;
+        case VOP_OR: return x | y;
+        case VOP_XOR: return x ^ y;
+        case VOP_SLL: return x << shift;
+        case VOP_SRL: return x >> shift;
+        case VOP_SRA: return static_cast<uint64_t>(sx >> shift);
+        case VOP_MINU: return std::min(x, y);
+        case VOP_MIN: return static_cast<uint64_t>(std::min(sx, sy));
+        case VOP_MAXU: return std::max(x, y);
+        case VOP_MAX: return static_cast<uint64_t>(std::max(sx, sy));
+        case VOP_MUL: return x * y;
+        case VOP_MACC: return old + x * y;
+        default: return y;
+    }
+}
+
+bool compareElement(int op, int sew, uint64_t x, uint64_t y) {
+    int64_t sx = sextElement(x, sew);
+    int64_t sy = sextElement(y, sew);
+    switch (op) {
+        case VOP_SEQ: return x == y;
+        case VOP_SNE: return x != y;
+        case VOP_SLTU: return x < y;
+        case VOP_SLT: return sx < sy;
+        case VOP_SLEU: return x <= y;
+        case VOP_SLE: return sx <= sy;
+        case VOP_SGTU: return x > y;
+        default: return sx > sy;
+    }
+}
+
+// Value that leaves any element unchanged under a reduction
+uint64_t reductionIdentity(int op, int sew) {
+    uint64_t sign = 1ULL << (sew * 8 - 1);
+    switch (op) {
+        case VOP_AND:
+        case VOP_MINU: return elementMask(sew);
+        case VOP_MIN: return sign - 1;
+        case VOP_MAX: return sign;
+        default: return 0;
+    }
+}
+
+void arithPortable(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+                   const uint8_t* mask) {
+    x &= elementMask(sew);
+    for (size_t i = 0; i < vl; ++i) {
+        uint64_t y = b ? loadElement(b, i, sew) : x;
+        uint64_t r;
+        if (op == VOP_MERGE) {
+            r = maskBit(mask, i) ? y : loadElement(a, i, sew);
+        } else if (mask && !maskBit(mask, i)) {
+            continue;
+        } else {
+            r = applyElement(op, sew, loadElement(a, i, sew), y, loadElement(d, i, sew));
+        }
+        storeElement(d, i, sew, r);
+    }
+}
+
+void comparePortable(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+                     const uint8_t* mask) {
+    x &= elementMask(sew);
+    for (size_t i = 0; i < vl; ++i) {
+        if (mask && !maskBit(mask, i)) {
+            continue;
+        }
+        bool bit = compareElement(op, sew, loadElement(a, i, sew), b ? loadElement(b, i, sew) : x);
+        d[i / 8] = static_cast<uint8_t>((d[i / 8] & ~(1u << (i % 8))) | (bit << (i % 8)));
+    }
+}
+
+uint64_t reducePortable(int op, int sew, const uint8_t* a, uint64_t init, size_t vl, const uint8_t* mask) {
+    uint64_t result = init & elementMask(sew);
+    for (size_t i = 0; i < vl; ++i) {
+        if (!mask || maskBit(mask, i)) {
+            result = applyElement(op, sew, result, loadElement(a, i, sew), 0) & elementMask(sew);
+        }
+    }
+    return result;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+__m256i splatAvx2(int sew, uint64_t x) {
+    switch (sew) {
+        case 1: return _mm256_set1_epi8(static_cast<char>(x));
+        case 2: return _mm256_set1_epi16(static_cast<short>(x));
+        case 4: return _mm256_set1_epi32(static_cast<int>(x));
+        default: return _mm256_set1_epi64x(static_cast<long long>(x));
+    }
+}
+
+__attribute__((target("avx2")))
+__m256i addAvx2(int sew, __m256i a, __m256i b) {
+    switch (sew) {
+        case 1: return _mm256_add_epi8(a, b);
+        case 2: return _mm256_add_epi16(a, b);
+        case 4: return _mm256_add_epi32(a, b);
+        default: return _mm256_add_epi64(a, b);
+    }
+}
+
+__attribute__((target("avx2")))
+__m256i subAvx2(int sew, __m256i a, __m256i b) {
+    switch (sew) {
+        case 1: return _mm256_sub_epi8(a, b);
+        case 2: return _mm256_sub_epi16(a, b);
+        case 4: return _mm256_sub_epi32(a, b);
+        default: return _mm256_sub_epi64(a, b);
+    }
+}
+
+__attribute__((target("avx2")))
+__m256i cmpeqAvx2(int sew, __m256i a, __m256i b) {
+    switch (sew) {
+        case 1: return _mm256_cmpeq_epi8(a, b);
+        case 2: return _mm256_cmpeq_epi16(a, b);
+        case 4: return _mm256_cmpeq_epi32(a, b);
+        default: return _mm256_cmpeq_epi64(a, b);
+    }
+}
+
+// Signed a > b; unsigned compares flip the sign bits first
+__attribute__((target("avx2")))
+__m256i cmpgtAvx2(int sew, __m256i a, __m256i b, bool isUnsigned) {
+    if (isUnsigned) {
+        __m256i sign = splatAvx2(sew, 1ULL << (sew * 8 - 1));
+        a = _mm256_xor_si256(a, sign);
+        b = _mm256_xor_si256(b, sign);
+    }
+    switch (sew) {
+        case 1: return _mm256_cmpgt_epi8(a, b);
+        case 2: return _mm256_cmpgt_epi16(a, b);
+        case 4: return _mm256_cmpgt_epi32(a, b);
+        default: return _mm256_cmpgt_epi64(a, b);
+    }
+}
+
+__attribute__((target("avx2")))
+__m256i minMaxAvx2(int op, int sew, __m256i a, __m256i b) {
+    switch (sew * 16 + op) {
+        case 1 * 16 + VOP_MINU: return _mm256_min_epu8(a, b);
+        case 1 * 16 + VOP_MIN: return _mm256_min_epi8(a, b);
+        case 1 * 16 + VOP_MAXU: return _mm256_max_epu8(a, b);
+        case 1 * 16 + VOP_MAX: return _mm256_max_epi8(a, b);
+        case 2 * 16 + VOP_MINU: return _mm256_min_epu16(a, b);
+        case 2 * 16 + VOP_MIN: return _mm256_min_epi16(a, b);
+        case 2 * 16 + VOP_MAXU: return _mm256_max_epu16(a, b);
+        case 2 * 16 + VOP_MAX: return _mm256_max_epi16(a, b);
+        case 4 * 16 + VOP_MINU: return _mm256_min_epu32(a, b);
+        case 4 * 16 + VOP_MIN: return _mm256_min_epi32(a, b);
+        case 4 * 16 + VOP_MAXU: return _mm256_max_epu32(a, b);
+        case 4 * 16 + VOP_MAX: return _mm256_max_epi32(a, b);
+    }
+    // No 64-bit min/max before AVX-512
+    __m256i greater = cmpgtAvx2(8, a, b, op == VOP_MINU || op == VOP_MAXU);
+    bool isMin = op == VOP_MINU || op == VOP_MIN;
+    return isMin ? _mm256_blendv_epi8(a, b, greater) : _mm256_blendv_epi8(b, a, greater);
+}
+
+__attribute__((target("avx2")))
+__m256i mulAvx2(int sew, __m256i a, __m256i b) {
+    switch (sew) {
+        case 1: {
+            // No byte multiply: even and odd bytes as 16-bit products
+            __m256i even = _mm256_and_si256(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(0xFF));
+            __m256i odd = _mm256_slli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8)), 8);
+            return _mm256_or_si256(even, odd);
+        }
+        case 2: return _mm256_mullo_epi16(a, b);
+        case 4: return _mm256_mullo_epi32(a, b);
+        default: {
+            // Low 64 bits from 32x32-bit products
+            __m256i low = _mm256_mul_epu32(a, b);
+            __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                             _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+            return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+__m256i shiftAvx2(int op, int sew, __m256i a, __m256i b) {
+    if (sew == 8) {
+        __m256i count = _mm256_and_si256(b, _mm256_set1_epi64x(63));
+        if (op == VOP_SLL) {
+            return _mm256_sllv_epi64(a, count);
+        }
+        __m256i shifted = _mm256_srlv_epi64(a, count);
+        if (op == VOP_SRL) {
+            return shifted;
+        }
+        // No 64-bit arithmetic shift before AVX-512: shift the sign fill back in
+        __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+        return _mm256_or_si256(shifted, _mm256_sllv_epi64(sign, _mm256_sub_epi64(_mm256_set1_epi64x(64), count)));
+    }
+    if (sew == 4) {
+        __m256i count = _mm256_and_si256(b, _mm256_set1_epi32(31));
+        switch (op) {
+            case VOP_SLL: return _mm256_sllv_epi32(a, count);
+            case VOP_SRL: return _mm256_srlv_epi32(a, count);
+            default: return _mm256_srav_epi32(a, count);
+        }
+    }
+    // Variable shifts exist only for 32 and 64 bits: shift the bytes or
+    // halfwords at each position within the 32-bit lanes separately
+    int bits = sew * 8;
+    __m256i field = _mm256_set1_epi32((1 << bits) - 1);
+    __m256i result = _mm256_setzero_si256();
+    for (int position = 0; position < 32; position += bits) {
+        __m128i down = _mm_cvtsi32_si128(position);
+        __m256i count = _mm256_and_si256(_mm256_srl_epi32(b, down), _mm256_set1_epi32(bits - 1));
+        __m256i shifted;
+        if (op == VOP_SRA) {
+            __m256i value = _mm256_sra_epi32(_mm256_sll_epi32(a, _mm_cvtsi32_si128(32 - bits - position)),
+                                             _mm_cvtsi32_si128(32 - bits));
+            shifted = _mm256_srav_epi32(value, count);
+        } else {
+            __m256i value = _mm256_and_si256(_mm256_srl_epi32(a, down), field);
+            shifted = op == VOP_SLL ? _mm256_sllv_epi32(value, count) : _mm256_srlv_epi32(value, count);
+        }
+        result = _mm256_or_si256(result, _mm256_sll_epi32(_mm256_and_si256(shifted, field), down));
+    }
+    return result;
+}
+
+__attribute__((target("avx2")))
+__m256i applyAvx2(int op, int sew, __m256i a, __m256i b, __m256i old) {
+    switch (op) {
+        case VOP_ADD: return addAvx2(sew, a, b);
+        case VOP_SUB: return subAvx2(sew, a, b);
+        case VOP_RSUB: return subAvx2(sew, b, a);
+        case VOP_AND: return _mm256_and_si256(a, b);
+        case VOP_OR: return _mm256_or_si256(a, b);
+        case VOP_XOR: return _mm256_xor_si256(a, b);
+        case VOP_SLL:
+        case VOP_SRL:
+        case VOP_SRA: return shiftAvx2(op, sew, a, b);
+        case VOP_MINU:
+        case VOP_MIN:
+        case VOP_MAXU:
+        case VOP_MAX: return minMaxAvx2(op, sew, a, b);
+        case VOP_MUL: return mulAvx2(sew, a, b);
+        case VOP_MACC: return addAvx2(sew, old, mulAvx2(sew, a, b));
+        default: return b;
+    }
+}
+
+// All ones in the elements whose bit is set, one bit per element
+__attribute__((target("avx2")))
+__m256i expandMaskAvx2(int sew, uint32_t bits) {
+    switch (sew) {
+        case 1: {
+            // Byte j of the result tests bit j % 8 of mask byte j / 8
+            __m256i spread = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits)),
+                                                 _mm256_setr_epi64x(0, 0x0101010101010101LL,
+                                                                    0x0202020202020202LL, 0x0303030303030303LL));
+            __m256i select = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+            return _mm256_cmpeq_epi8(_mm256_and_si256(spread, select), select);
+        }
+        case 2: {
+            __m256i select = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192,
+                                               16384, static_cast<short>(0x8000));
+            return _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(static_cast<short>(bits)), select), select);
+        }
+        case 4: {
+            __m256i select = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), select), select);
+        }
+        default: {
+            __m256i select = _mm256_setr_epi64x(1, 2, 4, 8);
+            return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), select), select);
+        }
+    }
+}
+
+// One bit per element of a compare result
+__attribute__((target("avx2")))
+uint32_t movemaskAvx2(int sew, __m256i v) {
+    switch (sew) {
+        case 1: return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+        case 2: {
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(v, _mm256_setzero_si256()), _MM_SHUFFLE(3, 1, 2, 0));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(packed)) & 0xFFFF;
+        }
+        case 4: return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(v)));
+        default: return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+    }
+}
+
+__attribute__((target("avx2")))
+void arithAvx2(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+               const uint8_t* mask) {
+    const unsigned perStep = 32 / sew;
+    const size_t bytes = vl * sew;
+    const __m256i scalar = splatAvx2(sew, x);
+    for (size_t offset = 0, i = 0; offset < bytes; offset += 32, i += perStep) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + offset));
+        __m256i vb = b ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + offset)) : scalar;
+        __m256i old = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + offset));
+        __m256i r;
+        if (op == VOP_MERGE) {
+            r = _mm256_blendv_epi8(va, vb, expandMaskAvx2(sew, maskBits(mask, i, perStep)));
+        } else {
+            r = applyAvx2(op, sew, va, vb, old);
+            if (mask) {
+                r = _mm256_blendv_epi8(old, r, expandMaskAvx2(sew, maskBits(mask, i, perStep)));
+            }
+        }
+        if (bytes - offset >= 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + offset), r);
+        } else {
+            alignas(32) uint8_t tail[32];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(tail), r);
+            std::memcpy(d + offset, tail, bytes - offset);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void compareAvx2(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+                 const uint8_t* mask) {
+    const unsigned perStep = 32 / sew;
+    const __m256i scalar = splatAvx2(sew, x);
+    for (size_t i = 0; i < vl; i += perStep) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * sew));
+        __m256i vb = b ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i * sew)) : scalar;
+        __m256i r;
+        bool invert = false;
+        switch (op) {
+            case VOP_SEQ: r = cmpeqAvx2(sew, va, vb); break;
+            case VOP_SNE: r = cmpeqAvx2(sew, va, vb); invert = true; break;
+            case VOP_SLTU: r = cmpgtAvx2(sew, vb, va, true); break;
+            case VOP_SLT: r = cmpgtAvx2(sew, vb, va, false); break;
+            case VOP_SLEU: r = cmpgtAvx2(sew, va, vb, true); invert = true; break;
+            case VOP_SLE: r = cmpgtAvx2(sew, va, vb, false); invert = true; break;
+            case VOP_SGTU: r = cmpgtAvx2(sew, va, vb, true); break;
+            default: r = cmpgtAvx2(sew, va, vb, false); break;
+        }
+        uint32_t bits = movemaskAvx2(sew, r);
+        if (invert) {
+            bits = ~bits;
+        }
+        uint32_t active = lowBits(std::min<size_t>(perStep, vl - i));
+        if (mask) {
+            active &= maskBits(mask, i, perStep);
+        }
+        writeMaskBits(d, i, perStep, bits, active);
+    }
+}
+
+__attribute__((target("avx2")))
+uint64_t reduceAvx2(int op, int sew, const uint8_t* a, uint64_t init, size_t vl, const uint8_t* mask) {
+    const unsigned perStep = 32 / sew;
+    const __m256i identity = splatAvx2(sew, reductionIdentity(op, sew));
+    __m256i acc = identity;
+    for (size_t i = 0; i < vl; i += perStep) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * sew));
+        uint32_t active = lowBits(std::min<size_t>(perStep, vl - i));
+        if (mask) {
+            active &= maskBits(mask, i, perStep);
+        }
+        if (active != lowBits(perStep)) {
+            v = _mm256_blendv_epi8(identity, v, expandMaskAvx2(sew, active));
+        }
+        acc = applyAvx2(op, sew, acc, v, acc);
+    }
+    alignas(32) uint8_t lanes[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return reducePortable(op, sew, lanes, init, perStep, nullptr);
+}
+#endif
+
+} // namespace
+
+bool vectorKernelsUseAvx2() {
+#if defined(__x86_64__)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void vectorArith(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+                 const uint8_t* mask) {
+#if defined(__x86_64__)
+    if (vectorKernelsUseAvx2()) {
+        arithAvx2(op, sew, d, a, b, x, vl, mask);
+        return;
+    }
+#endif
+    arithPortable(op, sew, d, a, b, x, vl, mask);
+}
+
+void vectorCompare(int op, int sew, uint8_t* d, const uint8_t* a, const uint8_t* b, uint64_t x, size_t vl,
+                   const uint8_t* mask) {
+#if defined(__x86_64__)
+    if (vectorKernelsUseAvx2()) {
+        compareAvx2(op, sew, d, a, b, x, vl, mask);
+        return;
+    }
+#endif
+    comparePortable(op, sew, d, a, b, x, vl, mask);
+}
+
+uint64_t vectorReduce(int op, int sew, const uint8_t* a, uint64_t init, size_t vl, const uint8_t* mask) {
+#if defined(__x86_64__)
+    if (vectorKernelsUseAvx2()) {
+        return reduceAvx2(op, sew, a, init, vl, mask);
+    }
+#endif
+    return reducePortable(op, sew, a, init, vl, mask);
+}